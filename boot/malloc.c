@@ -1,34 +1,34 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2008 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License as published by
-    the Free Software Foundation, either version 3 of the License.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include "boot.h"
-#include "bios.h"
-#include "malloc.h"
-#include "crypto.h"
-
-static u8  mem_buff[8 * 1024]; /* reserve 8k for bootloader memory */
-static u8 *mem_base = mem_buff;
-
-void *malloc(int size)
-{
-	void *mem = mem_base;
-	mem_base += size;
-	return mem;
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2008 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "boot.h"
+#include "bios.h"
+#include "malloc.h"
+#include "crypto.h"
+
+static u8  mem_buff[8 * 1024]; /* reserve 8k for bootloader memory */
+static u8 *mem_base = mem_buff;
+
+void *malloc(int size)
+{
+	void *mem = mem_base;
+	mem_base += size;
+	return mem;
 }
\ No newline at end of file
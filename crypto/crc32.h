@@ -1,6 +1,6 @@
-#ifndef _CRC32_H_
-#define _CRC32_H_
-
-unsigned long crc32(const unsigned char *p, unsigned long len);
-
-#endif
+#ifndef _CRC32_H_
+#define _CRC32_H_
+
+unsigned long crc32(const unsigned char *p, unsigned long len);
+
+#endif
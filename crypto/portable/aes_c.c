@@ -0,0 +1,119 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+   C versions of aes_amd64.asm / aes_padlock_amd64.asm for the portable
+   (CRYPTO_PORTABLE) build. Uses the same tables as aes256_set_key.
+*/
+
+#include "defines.h"
+#include "aes_key.h"
+#include "aes_asm.h"
+#include "aes_padlock.h"
+
+extern const u32 Te0[256], Te1[256], Te2[256], Te3[256];
+extern const u32 Te4_0[256], Te4_1[256], Te4_2[256], Te4_3[256];
+extern const u32 Td0[256], Td1[256], Td2[256], Td3[256];
+extern const u32 Td4_0[256], Td4_1[256], Td4_2[256], Td4_3[256];
+
+#define b0(x) d8((x) >>  0)
+#define b1(x) d8((x) >>  8)
+#define b2(x) d8((x) >> 16)
+#define b3(x) d8((x) >> 24)
+
+#define enc_round(t, s, rk) \
+	t[0] = Te0[b0(s[0])] ^ Te1[b1(s[1])] ^ Te2[b2(s[2])] ^ Te3[b3(s[3])] ^ (rk)[0]; \
+	t[1] = Te0[b0(s[1])] ^ Te1[b1(s[2])] ^ Te2[b2(s[3])] ^ Te3[b3(s[0])] ^ (rk)[1]; \
+	t[2] = Te0[b0(s[2])] ^ Te1[b1(s[3])] ^ Te2[b2(s[0])] ^ Te3[b3(s[1])] ^ (rk)[2]; \
+	t[3] = Te0[b0(s[3])] ^ Te1[b1(s[0])] ^ Te2[b2(s[1])] ^ Te3[b3(s[2])] ^ (rk)[3];
+
+#define enc_last(t, s, rk) \
+	t[0] = Te4_0[b0(s[0])] ^ Te4_1[b1(s[1])] ^ Te4_2[b2(s[2])] ^ Te4_3[b3(s[3])] ^ (rk)[0]; \
+	t[1] = Te4_0[b0(s[1])] ^ Te4_1[b1(s[2])] ^ Te4_2[b2(s[3])] ^ Te4_3[b3(s[0])] ^ (rk)[1]; \
+	t[2] = Te4_0[b0(s[2])] ^ Te4_1[b1(s[3])] ^ Te4_2[b2(s[0])] ^ Te4_3[b3(s[1])] ^ (rk)[2]; \
+	t[3] = Te4_0[b0(s[3])] ^ Te4_1[b1(s[0])] ^ Te4_2[b2(s[1])] ^ Te4_3[b3(s[2])] ^ (rk)[3];
+
+#define dec_round(t, s, rk) \
+	t[0] = Td0[b0(s[0])] ^ Td1[b1(s[3])] ^ Td2[b2(s[2])] ^ Td3[b3(s[1])] ^ (rk)[0]; \
+	t[1] = Td0[b0(s[1])] ^ Td1[b1(s[0])] ^ Td2[b2(s[3])] ^ Td3[b3(s[2])] ^ (rk)[1]; \
+	t[2] = Td0[b0(s[2])] ^ Td1[b1(s[1])] ^ Td2[b2(s[0])] ^ Td3[b3(s[3])] ^ (rk)[2]; \
+	t[3] = Td0[b0(s[3])] ^ Td1[b1(s[2])] ^ Td2[b2(s[1])] ^ Td3[b3(s[0])] ^ (rk)[3];
+
+#define dec_last(t, s, rk) \
+	t[0] = Td4_0[b0(s[0])] ^ Td4_1[b1(s[3])] ^ Td4_2[b2(s[2])] ^ Td4_3[b3(s[1])] ^ (rk)[0]; \
+	t[1] = Td4_0[b0(s[1])] ^ Td4_1[b1(s[0])] ^ Td4_2[b2(s[3])] ^ Td4_3[b3(s[2])] ^ (rk)[1]; \
+	t[2] = Td4_0[b0(s[2])] ^ Td4_1[b1(s[1])] ^ Td4_2[b2(s[0])] ^ Td4_3[b3(s[3])] ^ (rk)[2]; \
+	t[3] = Td4_0[b0(s[3])] ^ Td4_1[b1(s[2])] ^ Td4_2[b2(s[1])] ^ Td4_3[b3(s[0])] ^ (rk)[3];
+
+void _stdcall aes256_asm_encrypt(const unsigned char *in, unsigned char *out, aes256_key *key)
+{
+	const u32 *rk = key->enc_key;
+	u32        s[4], t[4];
+	int        i;
+
+	memcpy(s, in, sizeof(s));
+	s[0] ^= rk[0]; s[1] ^= rk[1]; s[2] ^= rk[2]; s[3] ^= rk[3];
+
+	for (i = 1; i < ROUNDS; i += 2) {
+		enc_round(t, s, rk + i*4);
+		if (i + 1 == ROUNDS) break;
+		enc_round(s, t, rk + i*4 + 4);
+	}
+	enc_last(s, t, rk + ROUNDS*4);
+	memcpy(out, s, sizeof(s));
+}
+
+void _stdcall aes256_asm_decrypt(const unsigned char *in, unsigned char *out, aes256_key *key)
+{
+	const u32 *rk = key->dec_key;
+	u32        s[4], t[4];
+	int        i;
+
+	memcpy(s, in, sizeof(s));
+	s[0] ^= rk[0]; s[1] ^= rk[1]; s[2] ^= rk[2]; s[3] ^= rk[3];
+
+	for (i = 1; i < ROUNDS; i += 2) {
+		dec_round(t, s, rk + i*4);
+		if (i + 1 == ROUNDS) break;
+		dec_round(s, t, rk + i*4 + 4);
+	}
+	dec_last(s, t, rk + ROUNDS*4);
+	memcpy(out, s, sizeof(s));
+}
+
+/* VIA Padlock is never used in portable builds */
+int _stdcall aes256_padlock_available()
+{
+	return 0;
+}
+
+void _stdcall aes256_padlock_encrypt(const unsigned char *in, unsigned char *out, int n_blocks, aes256_key *key)
+{
+	for (; n_blocks != 0; n_blocks--, in += AES_BLOCK_SIZE, out += AES_BLOCK_SIZE) {
+		aes256_asm_encrypt(in, out, key);
+	}
+}
+
+void _stdcall aes256_padlock_decrypt(const unsigned char *in, unsigned char *out, int n_blocks, aes256_key *key)
+{
+	for (; n_blocks != 0; n_blocks--, in += AES_BLOCK_SIZE, out += AES_BLOCK_SIZE) {
+		aes256_asm_decrypt(in, out, key);
+	}
+}
@@ -0,0 +1,105 @@
+/*
+    *
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+   Intrinsics version of xts_aes_ni_amd64.asm for the portable
+   (CRYPTO_PORTABLE) build, processes four blocks per iteration
+*/
+
+#include <wmmintrin.h>
+#include <cpuid.h>
+#include "defines.h"
+#include "xts_fast.h"
+#include "xts_aes_ni.h"
+
+#define next_tweak(_t) \
+	_mm_xor_si128(_mm_add_epi64(_t, _t), \
+		_mm_and_si128(_mm_shuffle_epi32(_mm_srai_epi32(_t, 31), 0x13), poly))
+
+int _stdcall xts_aes_ni_available()
+{
+	unsigned int a, b, c, d;
+
+	if (__get_cpuid(1, &a, &b, &c, &d) == 0) {
+		return 0;
+	}
+	return (c & bit_AES) != 0;
+}
+
+static __m128i aes_ni_encrypt_1(__m128i b, const __m128i *rk)
+{
+	int i;
+
+	b = _mm_xor_si128(b, rk[0]);
+	for (i = 1; i < ROUNDS; i++) b = _mm_aesenc_si128(b, rk[i]);
+	return _mm_aesenclast_si128(b, rk[ROUNDS]);
+}
+
+#define DEF_XTS_AES_NI(func_name, unit, key_field, round_op, last_op) \
+                                                                      \
+void _stdcall func_name( \
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_aes_k *key) \
+{                                                                                        \
+	const __m128i *rk   = pv(key->crypt_k.key_field);                                  \
+	const __m128i *tk   = pv(key->tweak_k.enc_key);                                    \
+	const __m128i  poly = _mm_set_epi32(0, 1, 0, 135);                                 \
+	__m128i        t0, t1, t2, t3, b0, b1, b2, b3;                                     \
+	u64            idx  = offset / (unit);                                             \
+	int            i, j;                                                               \
+                                                                                       \
+	do                                                                                 \
+	{                                                                                  \
+		/* derive first tweak value */                                                 \
+		t0 = aes_ni_encrypt_1(_mm_set_epi64x(0, ++idx), tk);                           \
+                                                                                       \
+		for (i = 0; i < (unit) / XTS_BLOCK_SIZE / 4; i++)                              \
+		{                                                                              \
+			t1 = next_tweak(t0); t2 = next_tweak(t1); t3 = next_tweak(t2);             \
+                                                                                       \
+			b0 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x00)), t0);                    \
+			b1 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x10)), t1);                    \
+			b2 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x20)), t2);                    \
+			b3 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x30)), t3);                    \
+			b0 = _mm_xor_si128(b0, rk[0]); b1 = _mm_xor_si128(b1, rk[0]);              \
+			b2 = _mm_xor_si128(b2, rk[0]); b3 = _mm_xor_si128(b3, rk[0]);              \
+                                                                                       \
+			for (j = 1; j < ROUNDS; j++) {                                             \
+				b0 = round_op(b0, rk[j]); b1 = round_op(b1, rk[j]);                    \
+				b2 = round_op(b2, rk[j]); b3 = round_op(b3, rk[j]);                    \
+			}                                                                          \
+			b0 = last_op(b0, rk[ROUNDS]); b1 = last_op(b1, rk[ROUNDS]);                \
+			b2 = last_op(b2, rk[ROUNDS]); b3 = last_op(b3, rk[ROUNDS]);                \
+                                                                                       \
+			_mm_storeu_si128(pv(out + 0x00), _mm_xor_si128(b0, t0));                   \
+			_mm_storeu_si128(pv(out + 0x10), _mm_xor_si128(b1, t1));                   \
+			_mm_storeu_si128(pv(out + 0x20), _mm_xor_si128(b2, t2));                   \
+			_mm_storeu_si128(pv(out + 0x30), _mm_xor_si128(b3, t3));                   \
+                                                                                       \
+			/* update pointers and derive next tweak value */                          \
+			in += XTS_BLOCK_SIZE*4; out += XTS_BLOCK_SIZE*4;                           \
+			t0 = next_tweak(t3);                                                       \
+		}                                                                              \
+	} while (len -= (unit));                                                           \
+}
+
+DEF_XTS_AES_NI(xts_aes_ni_encrypt, XTS_SECTOR_SIZE, enc_key, _mm_aesenc_si128, _mm_aesenclast_si128);
+DEF_XTS_AES_NI(xts_aes_ni_decrypt, XTS_SECTOR_SIZE, dec_key, _mm_aesdec_si128, _mm_aesdeclast_si128);
+
+DEF_XTS_AES_NI(xts_aes_ni_encrypt_4k, XTS_MAX_UNIT_SIZE, enc_key, _mm_aesenc_si128, _mm_aesenclast_si128);
+DEF_XTS_AES_NI(xts_aes_ni_decrypt_4k, XTS_MAX_UNIT_SIZE, dec_key, _mm_aesdec_si128, _mm_aesdeclast_si128);
@@ -0,0 +1,218 @@
+;
+;   *
+;   * DiskCryptor - open source partition encryption tool
+;   * Copyright (c) 2010
+;   * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+;   *
+;   This program is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License version 3 as
+;   published by the Free Software Foundation.
+;
+;   This program is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+%macro aesxor_2 4 ; B0, B1, key, round
+  movdqu     tt, [%3+(%4*10h)]
+  pxor	     %1, tt
+  pxor	     %2, tt
+%endmacro
+
+%macro aesenc_2 4 ; B0, B1, key, round
+  movdqu     tt, [%3+(%4*10h)]
+  aesenc     %1, tt
+  aesenc     %2, tt
+%endmacro
+
+%macro aesdec_2 4 ; B0, B1, key, round
+  movdqu     tt, [%3+(%4*10h)]
+  aesdec     %1, tt
+  aesdec     %2, tt
+%endmacro
+
+%macro aesenclast_2 4 ; B0, B1, key, round
+  movdqu     tt, [%3+(%4*10h)]
+  aesenclast %1, tt
+  aesenclast %2, tt
+%endmacro
+
+%macro aesdeclast_2 4 ; B0, B1, key, round
+  movdqu     tt, [%3+(%4*10h)]
+  aesdeclast %1, tt
+  aesdeclast %2, tt
+%endmacro
+
+%macro aes_encrypt_1 2	; XMMn, key
+ movdqu     tt, [%2]
+ pxor	    %1, tt
+%assign i 1
+%rep 13
+ movdqu     tt, [%2+(i*10h)]
+ aesenc     %1, tt
+%assign i i+1
+%endrep
+ movdqu     tt, [%2+0E0h]
+ aesenclast %1, tt
+%endmacro
+
+%macro aes_encrypt_2 3 ; B0, B1, key
+ aesxor_2     %1, %2, %3, 0
+%assign i 1
+%rep 13
+ aesenc_2     %1, %2, %3, i
+%assign i i+1
+%endrep
+ aesenclast_2 %1, %2, %3, 14
+%endmacro
+
+%macro aes_decrypt_2 3 ; B0, B1, key
+ aesxor_2     %1, %2, %3, 0
+%assign i 1
+%rep 13
+ aesdec_2     %1, %2, %3, i
+%assign i i+1
+%endrep
+ aesdeclast_2 %1, %2, %3, 14
+%endmacro
+
+%macro next_tweak 2 ; new, old
+ movdqa  tt, %2
+ psraw	 tt, 8
+ psrldq  tt, 15
+ pand	 tt, POLY
+ movdqa  t2, %2
+ pslldq  t2, 8
+ psrldq  t2, 7
+ psrlq	 t2, 7
+ movdqa  %1, %2
+ psllq	 %1, 1
+ por	 %1, t2
+ pxor	 %1, tt
+%endmacro
+
+%macro aes_xts_process 2
+ push	       ebp
+ push	       ebx
+ push	       esi
+ push	       edi
+ mov	       ebp, esp
+ ; save caller SSE registers, boot environment does not preserve them
+ sub	       esp, 70h
+ and	       esp, 0FFFFFFF0h
+ movdqa        [esp+00h], xmm0
+ movdqa        [esp+10h], xmm1
+ movdqa        [esp+20h], xmm2
+ movdqa        [esp+30h], xmm3
+ movdqa        [esp+40h], xmm4
+ movdqa        [esp+50h], xmm5
+ movdqa        [esp+60h], xmm6
+ ; load XTS tweak polynomial
+ mov	       eax, 135
+ movd	       POLY, eax
+ bsf	       ecx, [ebp+30h]	  ; ecx = log2(unit size)
+ mov	       eax, [ebp+24h]	  ;
+ shrd	       [ebp+20h], eax, cl ; idx.a = offset / unit size
+ shr	       eax, cl		  ;
+ mov	       [ebp+24h], eax	  ;
+ mov	       esi, [ebp+14h]	  ; esi = in
+ mov	       edi, [ebp+18h]	  ; edi = out
+ mov	       ebx, [ebp+1Ch]	  ; ebx = len
+ mov	       eax, [ebp+28h]	  ; eax = crypt key
+ mov	       edx, [ebp+2Ch]	  ; edx = tweak key
+%if %2 != 0
+ add	       eax, %2		  ; eax = decryption key
+%endif
+%%xts_loop:
+ add	       dword [ebp+20h], 1 ; idx.a++
+ adc	       dword [ebp+24h], 0 ;
+ movq	       T0,  [ebp+20h]
+ aes_encrypt_1 T0, edx
+ mov	       ecx, [ebp+30h]	  ;
+ shr	       ecx, 5		  ; ecx = blocks in unit / 2
+%%blocks_loop:
+ next_tweak    T1, T0
+ ; load two blocks
+ movdqu        B0, [esi+00h]
+ movdqu        B1, [esi+10h]
+ ; input tweak
+ pxor	       B0, T0
+ pxor	       B1, T1
+ ; encrypt / decrypt
+ %1	       B0, B1, eax
+ ; output tweak
+ pxor	       B0, T0
+ pxor	       B1, T1
+ ; save two blocks
+ movdqu        [edi+00h], B0
+ movdqu        [edi+10h], B1
+ add	       esi, 32 ; in += XTS_BLOCK_SIZE*2
+ add	       edi, 32 ; out += XTS_BLOCK_SIZE*2
+ dec	       ecx
+ jz	       %%block_done
+ next_tweak    T0, T1
+ jmp	       %%blocks_loop
+%%block_done:
+ sub	       ebx, [ebp+30h] ; len -= unit size
+ jnz	       %%xts_loop
+ ; restore caller SSE registers
+ movdqa        xmm0, [esp+00h]
+ movdqa        xmm1, [esp+10h]
+ movdqa        xmm2, [esp+20h]
+ movdqa        xmm3, [esp+30h]
+ movdqa        xmm4, [esp+40h]
+ movdqa        xmm5, [esp+50h]
+ movdqa        xmm6, [esp+60h]
+ mov	       esp, ebp
+ pop	       edi
+ pop	       esi
+ pop	       ebx
+ pop	       ebp
+ ret
+%endmacro
+
+; =========================================
+
+%define B0   xmm0
+%define B1   xmm1
+
+%define T0   xmm2
+%define T1   xmm3
+
+%define tt   xmm4
+%define t2   xmm5
+%define POLY xmm6
+
+%define enc_key 0
+%define dec_key 4*15*4
+
+; =========================================
+
+global _xts_aes_ni_available
+global _xts_aes_ni_encrypt
+global _xts_aes_ni_decrypt
+
+align 16
+_xts_aes_ni_available:
+ push	    ebx
+ ; test for CPUID.01H:ECX.AES[bit 25] = 1
+ xor	    eax, eax
+ inc	    eax
+ cpuid
+ test	    ecx, (1 << 25)
+ setnz	    al
+ movzx	    eax, al
+ pop	    ebx
+ ret
+
+align 16
+_xts_aes_ni_encrypt:
+ aes_xts_process aes_encrypt_2, enc_key
+
+align 16
+_xts_aes_ni_decrypt:
+ aes_xts_process aes_decrypt_2, dec_key
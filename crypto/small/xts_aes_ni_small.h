@@ -0,0 +1,11 @@
+#if !defined(_XTS_AES_NI_SMALL_H_) && defined(_M_IX86)
+#define _XTS_AES_NI_SMALL_H_
+
+#include "aes_small.h"
+
+int  xts_aes_ni_available();
+/* offset and len must be aligned to data unit size */
+void xts_aes_ni_encrypt(const unsigned char *in, unsigned char *out, size_t len, u64 offset, aes256_key *crypt_k, aes256_key *tweak_k, u32 unit_size);
+void xts_aes_ni_decrypt(const unsigned char *in, unsigned char *out, size_t len, u64 offset, aes256_key *crypt_k, aes256_key *tweak_k, u32 unit_size);
+
+#endif
\ No newline at end of file
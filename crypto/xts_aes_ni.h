@@ -1,8 +1,12 @@
-#ifndef _XTS_AES_NI_H_
-#define _XTS_AES_NI_H_
-
-int  _stdcall xts_aes_ni_available();
-void _stdcall xts_aes_ni_encrypt(const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key);
-void _stdcall xts_aes_ni_decrypt(const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key);
-
+#ifndef _XTS_AES_NI_H_
+#define _XTS_AES_NI_H_
+
+int  _stdcall xts_aes_ni_available();
+/* [key] - AES schedules of xts_key, see XTS_AES_K */
+void _stdcall xts_aes_ni_encrypt(const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_aes_k *key);
+void _stdcall xts_aes_ni_decrypt(const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_aes_k *key);
+/* 4096 bytes data unit versions, offset and len must be aligned to data unit size */
+void _stdcall xts_aes_ni_encrypt_4k(const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_aes_k *key);
+void _stdcall xts_aes_ni_decrypt_4k(const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_aes_k *key);
+
 #endif
\ No newline at end of file
@@ -1,368 +1,641 @@
-/*
-    *
-    * Copyright (c) 2010
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-#include "defines.h"
-#include "xts_fast.h"
-#include "aes_asm.h"
-#include "aes_padlock.h"
-#include "xts_aes_ni.h"
-
-typedef __declspec(align(1)) union _m128 {
-    u32 v32[4];    
-    u64 v64[2];    
-} m128;
-
-static xts_proc aes_selected_encrypt;
-static xts_proc aes_selected_decrypt;
-
-#ifdef _M_X64
-#define def_tweak \
-	u64 t0, t1; m128
-
-#define load_tweak() \
-	t0 = t.v64[0]; t1 = t.v64[1];
-
-#define tweak_xor(_in, _out)         \
-	p64(_out)[0] = p64(_in)[0] ^ t0; \
-	p64(_out)[1] = p64(_in)[1] ^ t1;
-
-#define next_tweak()             \
-	cf = (t1 >> 63) * 135;       \
-	t1 = (t1 << 1) | (t0 >> 63); \
-	t0 = (t0 << 1) ^ cf;
-
-#define copy_tweak(_buf) \
-	p64(_buf)[0] = t0; p64(_buf)[1] = t1;
-#else
-#define def_tweak    m128
-#define load_tweak()
-
-#define tweak_xor(_in, _out)               \
-	p64(_out)[0] = p64(_in)[0] ^ t.v64[0]; \
-	p64(_out)[1] = p64(_in)[1] ^ t.v64[1];
-
-#define next_tweak()             \
-	cf = (t.v32[3] >> 31) * 135; \
-	t.v64[1] <<= 1;              \
-	t.v32[2] |= t.v32[1] >> 31;  \
-	t.v64[0] <<= 1;              \
-	t.v32[0] ^= cf;
-
-#define copy_tweak(_buf) \
-	memcpy(_buf, &t, sizeof(t))
-#endif
-
-#ifdef KMDF_MAJOR_VERSION
- static NPAGED_LOOKASIDE_LIST padlock_tmp_mem;
- static u32                   padlock_tmp_ok;
-
- #define padlock_alloc_tmp()    ( ExAllocateFromNPagedLookasideList(&padlock_tmp_mem) )
- #define padlock_free_tmp(_tmp) ( ExFreeToNPagedLookasideList(&padlock_tmp_mem, _tmp) )
-#else
- #define padlock_alloc_tmp()    ( malloc(XTS_SECTOR_SIZE*2) )
- #define padlock_free_tmp(_tmp) ( free(_tmp) )
-#endif
-
-#define DEF_XTS_PROC(func_name, tweak_name, crypt_name, key_field) \
-                                                                   \
-static void _stdcall func_name( \
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key) \
-{                                                                                      \
-	def_tweak t;                                                                       \
-	m128      idx;                                                                     \
-	size_t    cf;                                                                      \
-    u32       i;                                                                       \
-	                                                                                   \
-	idx.v64[0] = offset / XTS_SECTOR_SIZE;                                             \
-	idx.v64[1] = 0;                                                                    \
-	do                                                                                 \
-	{                                                                                  \
-		/* update tweak unit index */                                                  \
-		idx.v64[0]++;                                                                  \
-		/* derive first tweak value */                                                 \
-		tweak_name(pv(&idx), pv(&t), &key->tweak_k.key_field);                         \
-		load_tweak();                                                                  \
-                                                                                       \
-		for (i = 0; i < XTS_BLOCKS_IN_SECTOR; i++)                                     \
-		{                                                                              \
-			tweak_xor(in, out);                                                        \
-			crypt_name(out, out, &key->crypt_k.key_field);                             \
-			tweak_xor(out, out);                                                       \
-                                                                                       \
-			/* update pointers */                                                      \
-			in += XTS_BLOCK_SIZE; out += XTS_BLOCK_SIZE;                               \
-                                                                                       \
-			/* derive next tweak value */                                              \
-			next_tweak();                                                              \
-		}                                                                              \
-	} while (len -= XTS_SECTOR_SIZE);                                                  \
-}
-
-#define DEF_XTS_AES_PADLOCK(func_name, crypt_name, basic_name) \
-	                                                           \
-static void _stdcall func_name( \
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key) \
-{                                                                                      \
-	def_tweak align16 t;                                                               \
-	m128      align16 idx;                                                             \
-	u8               *buff, *tweak;                                                    \
-	size_t            cf, i;                                                           \
-	                                                                                   \
-	if ( (buff = padlock_alloc_tmp()) == NULL ) {                                      \
-		basic_name(in, out, len, offset, key);                                         \
-		return;                                                                        \
-	}                                                                                  \
-	tweak      = buff + XTS_SECTOR_SIZE;                                               \
-	idx.v64[0] = offset / XTS_SECTOR_SIZE;                                             \
-	idx.v64[1] = 0;                                                                    \
-	do                                                                                 \
-	{                                                                                  \
-		/* update tweak unit index */                                                  \
-		idx.v64[0]++;                                                                  \
-		/* derive first tweak value */                                                 \
-		aes256_padlock_rekey();                                                        \
-		aes256_padlock_encrypt(pv(&idx), pv(&t), 1, &key->tweak_k.aes);                \
-		load_tweak();                                                                  \
-		                                                                               \
-		for (i = 0; i < XTS_BLOCKS_IN_SECTOR; i++) {                                   \
-			copy_tweak(tweak + i*XTS_BLOCK_SIZE); next_tweak();                        \
-		}                                                                              \
-		for (i = 0; i < XTS_SECTOR_SIZE / sizeof(u64); i++) {                          \
-			p64(buff)[i] = p64(in)[i] ^ p64(tweak)[i];                                 \
-		}                                                                              \
-		aes256_padlock_rekey();                                                        \
-		crypt_name(buff, buff, XTS_BLOCKS_IN_SECTOR, &key->crypt_k.aes);               \
-		                                                                               \
-		for (i = 0; i < XTS_SECTOR_SIZE / sizeof(u64); i++) {                          \
-			p64(out)[i] = p64(buff)[i] ^ p64(tweak)[i];                                \
-		}                                                                              \
-		/* update pointers */                                                          \
-		in += XTS_SECTOR_SIZE; out += XTS_SECTOR_SIZE;                                 \
-	} while (len -= XTS_SECTOR_SIZE);                                                  \
-                                                                                       \
-	padlock_free_tmp(buff);                                                            \
-}
-
-DEF_XTS_PROC(xts_aes_basic_encrypt, aes256_asm_encrypt, aes256_asm_encrypt, aes);
-DEF_XTS_PROC(xts_aes_basic_decrypt, aes256_asm_encrypt, aes256_asm_decrypt, aes);
-
-DEF_XTS_PROC(xts_twofish_encrypt, twofish256_encrypt, twofish256_encrypt, twofish);
-DEF_XTS_PROC(xts_twofish_decrypt, twofish256_encrypt, twofish256_decrypt, twofish);
-
-DEF_XTS_PROC(xts_serpent_encrypt, serpent256_encrypt, serpent256_encrypt, serpent);
-DEF_XTS_PROC(xts_serpent_decrypt, serpent256_encrypt, serpent256_decrypt, serpent);
-
-DEF_XTS_AES_PADLOCK(xts_aes_padlock_encrypt, aes256_padlock_encrypt, xts_aes_basic_encrypt);
-DEF_XTS_AES_PADLOCK(xts_aes_padlock_decrypt, aes256_padlock_decrypt, xts_aes_basic_decrypt);
-
-static void _stdcall xts_aes_encrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-#if defined(_M_IX86) && defined(KMDF_MAJOR_VERSION)
-	KFLOATING_SAVE state;
-	xts_proc       selected = aes_selected_encrypt;
-
-	if (selected == xts_aes_ni_encrypt)
-	{
-		if ( (KeGetCurrentIrql() <= DISPATCH_LEVEL) &&
-			 (NT_SUCCESS(KeSaveFloatingPointState(&state)) != 0) )
-		{
-			xts_aes_ni_encrypt(in, out, len, offset, key);
-			KeRestoreFloatingPointState(&state);
-		} else {
-			xts_aes_basic_encrypt(in, out, len, offset, key);
-		}
-	} else {
-		selected(in, out, len, offset, key);
-	}
-#else
-	aes_selected_encrypt(in, out, len, offset, key);
-#endif
-}
-
-static void _stdcall xts_aes_decrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-#if defined(_M_IX86) && defined(KMDF_MAJOR_VERSION)
-	KFLOATING_SAVE state;
-	xts_proc       selected = aes_selected_decrypt;
-
-	if (selected == xts_aes_ni_decrypt)
-	{
-		if ( (KeGetCurrentIrql() <= DISPATCH_LEVEL) &&
-			 (NT_SUCCESS(KeSaveFloatingPointState(&state)) != 0) )
-		{
-			xts_aes_ni_decrypt(in, out, len, offset, key);
-			KeRestoreFloatingPointState(&state);
-			return;
-		} else {
-			xts_aes_basic_decrypt(in, out, len, offset, key);
-		}
-	} else {
-		selected(in, out, len, offset, key);
-	}
-#else
-	aes_selected_decrypt(in, out, len, offset, key);
-#endif
-}
-
-static void _stdcall xts_aes_twofish_encrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_twofish_encrypt(in, out, len, offset, key);
-	xts_aes_encrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_aes_twofish_decrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_aes_decrypt(in, out, len, offset, key);
-	xts_twofish_decrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_twofish_serpent_encrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_serpent_encrypt(in, out, len, offset, key);
-	xts_twofish_encrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_twofish_serpent_decrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_twofish_decrypt(in, out, len, offset, key);
-	xts_serpent_decrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_serpent_aes_encrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_aes_encrypt(in, out, len, offset, key);
-	xts_serpent_encrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_serpent_aes_decrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_serpent_decrypt(in, out, len, offset, key);
-	xts_aes_decrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_aes_twofish_serpent_encrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_serpent_encrypt(in, out, len, offset, key);
-	xts_twofish_encrypt(out, out, len, offset, key);
-	xts_aes_encrypt(out, out, len, offset, key);
-}
-
-static void _stdcall xts_aes_twofish_serpent_decrypt(
-    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
-{
-	xts_aes_decrypt(in, out, len, offset, key);
-	xts_twofish_decrypt(out, out, len, offset, key);
-	xts_serpent_decrypt(out, out, len, offset, key);
-}
-
-void xts_set_key(const unsigned char *key, int alg, xts_key *skey)
-{
-	switch (alg) 
-	{
-		case CF_AES:
-			aes256_asm_set_key(key, &skey->crypt_k.aes);
-			aes256_asm_set_key(key + XTS_KEY_SIZE, &skey->tweak_k.aes);
-
-			skey->encrypt = xts_aes_encrypt;
-			skey->decrypt = xts_aes_decrypt;
-		break;
-		case CF_TWOFISH:
-			twofish256_set_key(key, &skey->crypt_k.twofish);
-			twofish256_set_key(key + XTS_KEY_SIZE, &skey->tweak_k.twofish);
-
-			skey->encrypt = xts_twofish_encrypt;
-			skey->decrypt = xts_twofish_decrypt;
-		break;
-		case CF_SERPENT:
-			serpent256_set_key(key, &skey->crypt_k.serpent);
-			serpent256_set_key(key + XTS_KEY_SIZE, &skey->tweak_k.serpent);
-
-			skey->encrypt = xts_serpent_encrypt;
-			skey->decrypt = xts_serpent_decrypt;
-		break;
-		case CF_AES_TWOFISH:
-			twofish256_set_key(key, &skey->crypt_k.twofish);
-			aes256_asm_set_key(key + XTS_KEY_SIZE, &skey->crypt_k.aes);			
-			twofish256_set_key(key + XTS_KEY_SIZE*2, &skey->tweak_k.twofish);
-			aes256_asm_set_key(key + XTS_KEY_SIZE*3, &skey->tweak_k.aes);
-
-			skey->encrypt = xts_aes_twofish_encrypt;
-			skey->decrypt = xts_aes_twofish_decrypt;
-		break;
-		case CF_TWOFISH_SERPENT:
-			serpent256_set_key(key, &skey->crypt_k.serpent);
-			twofish256_set_key(key + XTS_KEY_SIZE, &skey->crypt_k.twofish);			
-			serpent256_set_key(key + XTS_KEY_SIZE*2, &skey->tweak_k.serpent);
-			twofish256_set_key(key + XTS_KEY_SIZE*3, &skey->tweak_k.twofish);
-
-			skey->encrypt = xts_twofish_serpent_encrypt;
-			skey->decrypt = xts_twofish_serpent_decrypt;
-		break;
-		case CF_SERPENT_AES:
-			aes256_asm_set_key(key, &skey->crypt_k.aes);
-			serpent256_set_key(key + XTS_KEY_SIZE, &skey->crypt_k.serpent);			
-			aes256_asm_set_key(key + XTS_KEY_SIZE*2, &skey->tweak_k.aes);
-			serpent256_set_key(key + XTS_KEY_SIZE*3, &skey->tweak_k.serpent);
-
-			skey->encrypt = xts_serpent_aes_encrypt;
-			skey->decrypt = xts_serpent_aes_decrypt;
-		break;
-		case CF_AES_TWOFISH_SERPENT:
-			serpent256_set_key(key, &skey->crypt_k.serpent);
-			twofish256_set_key(key + XTS_KEY_SIZE, &skey->crypt_k.twofish);
-			aes256_asm_set_key(key + XTS_KEY_SIZE*2, &skey->crypt_k.aes);
-			serpent256_set_key(key + XTS_KEY_SIZE*3, &skey->tweak_k.serpent);
-			twofish256_set_key(key + XTS_KEY_SIZE*4, &skey->tweak_k.twofish);
-			aes256_asm_set_key(key + XTS_KEY_SIZE*5, &skey->tweak_k.aes);
-
-			skey->encrypt = xts_aes_twofish_serpent_encrypt;
-			skey->decrypt = xts_aes_twofish_serpent_decrypt;
-		break;
-	}	
-}
-
-void xts_init(int hw_crypt)
-{
-	if ( (hw_crypt != 0) && (xts_aes_ni_available() != 0) ) {
-		aes_selected_encrypt = xts_aes_ni_encrypt;
-		aes_selected_decrypt = xts_aes_ni_decrypt;
-		return;
-	}
-	if ( (hw_crypt != 0) && (aes256_padlock_available() != 0) ) 
-	{
-#ifdef KMDF_MAJOR_VERSION
-		if (lock_xchg(&padlock_tmp_ok, 1) == 0) {
-			ExInitializeNPagedLookasideList(&padlock_tmp_mem, NULL, NULL, 0, PAGE_SIZE, 'ldap', 0);
-		}
-#endif
-		aes_selected_encrypt = xts_aes_padlock_encrypt;
-		aes_selected_decrypt = xts_aes_padlock_decrypt;
-		return;
-	}
-	aes_selected_encrypt = xts_aes_basic_encrypt;
-	aes_selected_decrypt = xts_aes_basic_decrypt;
+/*
+    *
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "defines.h"
+#include "xts_fast.h"
+#include "aes_asm.h"
+#include "aes_padlock.h"
+#include "xts_aes_ni.h"
+#include <wmmintrin.h>
+
+typedef __declspec(align(1)) union _m128 {
+    u32 v32[4];    
+    u64 v64[2];    
+} m128;
+
+static xts_proc aes_selected_encrypt;
+static xts_proc aes_selected_decrypt;
+static xts_proc aes_selected_ecb;
+
+#ifdef _M_X64
+#define def_tweak \
+	u64 t0, t1; m128
+
+#define load_tweak() \
+	t0 = t.v64[0]; t1 = t.v64[1];
+
+#define tweak_xor(_in, _out)         \
+	p64(_out)[0] = p64(_in)[0] ^ t0; \
+	p64(_out)[1] = p64(_in)[1] ^ t1;
+
+#define next_tweak()             \
+	cf = (t1 >> 63) * 135;       \
+	t1 = (t1 << 1) | (t0 >> 63); \
+	t0 = (t0 << 1) ^ cf;
+
+#define copy_tweak(_buf) \
+	p64(_buf)[0] = t0; p64(_buf)[1] = t1;
+#else
+#define def_tweak    m128
+#define load_tweak()
+
+#define tweak_xor(_in, _out)               \
+	p64(_out)[0] = p64(_in)[0] ^ t.v64[0]; \
+	p64(_out)[1] = p64(_in)[1] ^ t.v64[1];
+
+#define next_tweak()             \
+	cf = (t.v32[3] >> 31) * 135; \
+	t.v64[1] <<= 1;              \
+	t.v32[2] |= t.v32[1] >> 31;  \
+	t.v64[0] <<= 1;              \
+	t.v32[0] ^= cf;
+
+#define copy_tweak(_buf) \
+	memcpy(_buf, &t, sizeof(t))
+#endif
+
+#ifdef KMDF_MAJOR_VERSION
+ static NPAGED_LOOKASIDE_LIST padlock_tmp_mem;
+ static u32                   padlock_tmp_ok;
+
+ #define padlock_alloc_tmp()    ( ExAllocateFromNPagedLookasideList(&padlock_tmp_mem) )
+ #define padlock_free_tmp(_tmp) ( ExFreeToNPagedLookasideList(&padlock_tmp_mem, _tmp) )
+#else
+ #define padlock_alloc_tmp()    ( malloc(XTS_SECTOR_SIZE*2) )
+ #define padlock_free_tmp(_tmp) ( free(_tmp) )
+#endif
+
+#define skip_tweaks(_n, _j) \
+	for (_j = 0; _j < (_n); _j++) { next_tweak(); }
+
+/*
+   requests may start or end in the middle of XTS data unit, 
+   tweak value of first block is derived from unit index and block number
+*/
+#define DEF_XTS_PROC(func_name, tweak_name, crypt_name, key_type, key_field) \
+                                                                             \
+static void _stdcall func_name( \
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key) \
+{                                                                                      \
+	key_type *sk = pv(p8(key) + key->key_field);                                       \
+	def_tweak t;                                                                       \
+	m128      idx;                                                                     \
+	size_t    cf;                                                                      \
+    u32       i, j, n;                                                                 \
+	                                                                                   \
+	idx.v64[0] = offset / key->unit_size;                                              \
+	idx.v64[1] = 0;                                                                    \
+	i          = d32(offset % key->unit_size) / XTS_BLOCK_SIZE;                        \
+	do                                                                                 \
+	{                                                                                  \
+		/* update tweak unit index */                                                  \
+		idx.v64[0]++;                                                                  \
+		/* derive first tweak value */                                                 \
+		tweak_name(pv(&idx), pv(&t), &sk->tweak_k);                                    \
+		load_tweak();                                                                  \
+		skip_tweaks(i, j);                                                             \
+		                                                                               \
+		n    = d32(min(key->unit_size / XTS_BLOCK_SIZE, i + len / XTS_BLOCK_SIZE));    \
+		len -= (n - i) * XTS_BLOCK_SIZE;                                               \
+                                                                                       \
+		for (; i < n; i++)                                                             \
+		{                                                                              \
+			tweak_xor(in, out);                                                        \
+			crypt_name(out, out, &sk->crypt_k);                                        \
+			tweak_xor(out, out);                                                       \
+                                                                                       \
+			/* update pointers */                                                      \
+			in += XTS_BLOCK_SIZE; out += XTS_BLOCK_SIZE;                               \
+                                                                                       \
+			/* derive next tweak value */                                              \
+			next_tweak();                                                              \
+		}                                                                              \
+		i = 0;                                                                         \
+	} while (len != 0);                                                                \
+}
+
+#define DEF_XTS_AES_PADLOCK(func_name, crypt_name, basic_name) \
+	                                                           \
+static void _stdcall func_name( \
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key) \
+{                                                                                      \
+	def_tweak align16 t;                                                               \
+	m128      align16 idx;                                                             \
+	u8               *buff, *tweak;                                                    \
+	size_t            cf, i, j, n, b;                                                  \
+	                                                                                   \
+	if ( (buff = padlock_alloc_tmp()) == NULL ) {                                      \
+		basic_name(in, out, len, offset, key);                                         \
+		return;                                                                        \
+	}                                                                                  \
+	tweak      = buff + XTS_SECTOR_SIZE;                                               \
+	idx.v64[0] = offset / key->unit_size;                                              \
+	idx.v64[1] = 0;                                                                    \
+	i          = d32(offset % key->unit_size) / XTS_BLOCK_SIZE;                        \
+	do                                                                                 \
+	{                                                                                  \
+		/* update tweak unit index */                                                  \
+		idx.v64[0]++;                                                                  \
+		/* derive first tweak value */                                                 \
+		aes256_padlock_rekey();                                                        \
+		aes256_padlock_encrypt(pv(&idx), pv(&t), 1, &XTS_AES_K(key)->tweak_k);         \
+		load_tweak();                                                                  \
+		skip_tweaks(i, j);                                                             \
+		                                                                               \
+		/* process data unit by XTS_SECTOR_SIZE parts */                               \
+		for (n = key->unit_size / XTS_BLOCK_SIZE; (i < n) && (len != 0); i += b)       \
+		{                                                                              \
+			b = min(min(n - i, XTS_BLOCKS_IN_SECTOR), len / XTS_BLOCK_SIZE);           \
+			                                                                           \
+			for (j = 0; j < b; j++) {                                                  \
+				copy_tweak(tweak + j*XTS_BLOCK_SIZE); next_tweak();                    \
+			}                                                                          \
+			for (j = 0; j < b * (XTS_BLOCK_SIZE / sizeof(u64)); j++) {                 \
+				p64(buff)[j] = p64(in)[j] ^ p64(tweak)[j];                             \
+			}                                                                          \
+			aes256_padlock_rekey();                                                    \
+			crypt_name(buff, buff, d32(b), &XTS_AES_K(key)->crypt_k);                  \
+			                                                                           \
+			for (j = 0; j < b * (XTS_BLOCK_SIZE / sizeof(u64)); j++) {                 \
+				p64(out)[j] = p64(buff)[j] ^ p64(tweak)[j];                            \
+			}                                                                          \
+			/* update pointers */                                                      \
+			in += b * XTS_BLOCK_SIZE; out += b * XTS_BLOCK_SIZE;                       \
+			len -= b * XTS_BLOCK_SIZE;                                                 \
+		}                                                                              \
+		i = 0;                                                                         \
+	} while (len != 0);                                                                \
+                                                                                       \
+	padlock_free_tmp(buff);                                                            \
+}
+
+/*
+   AES-NI procedures process whole data units only, partial units 
+   at begin and end of request are processed by basic code
+*/
+#define DEF_XTS_AES_NI_UNITS(func_name, sector_name, unit_name, basic_name) \
+	                                                                        \
+static void _stdcall func_name( \
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key) \
+{                                                                                      \
+	size_t part;                                                                       \
+	                                                                                   \
+	if (key->unit_size == XTS_SECTOR_SIZE) {                                           \
+		sector_name(in, out, len, offset, XTS_AES_K(key));                             \
+		return;                                                                        \
+	}                                                                                  \
+	if ( (part = d32(offset % XTS_MAX_UNIT_SIZE)) != 0 )                               \
+	{                                                                                  \
+		part = min(len, XTS_MAX_UNIT_SIZE - part);                                     \
+		basic_name(in, out, part, offset, key);                                        \
+		in += part; out += part; offset += part; len -= part;                          \
+	}                                                                                  \
+	if ( (part = len & ~(XTS_MAX_UNIT_SIZE - 1)) != 0 )                                \
+	{                                                                                  \
+		unit_name(in, out, part, offset, XTS_AES_K(key));                              \
+		in += part; out += part; offset += part; len -= part;                          \
+	}                                                                                  \
+	if (len != 0) {                                                                    \
+		basic_name(in, out, len, offset, key);                                         \
+	}                                                                                  \
+}
+
+DEF_XTS_PROC(xts_aes_basic_encrypt, aes256_asm_encrypt, aes256_asm_encrypt, xts_aes_k, aes_k);
+DEF_XTS_PROC(xts_aes_basic_decrypt, aes256_asm_encrypt, aes256_asm_decrypt, xts_aes_k, aes_k);
+
+DEF_XTS_PROC(xts_twofish_encrypt, twofish256_encrypt, twofish256_encrypt, xts_twofish_k, twofish_k);
+DEF_XTS_PROC(xts_twofish_decrypt, twofish256_encrypt, twofish256_decrypt, xts_twofish_k, twofish_k);
+
+DEF_XTS_PROC(xts_serpent_encrypt, serpent256_encrypt, serpent256_encrypt, xts_serpent_k, serpent_k);
+DEF_XTS_PROC(xts_serpent_decrypt, serpent256_encrypt, serpent256_decrypt, xts_serpent_k, serpent_k);
+
+DEF_XTS_AES_PADLOCK(xts_aes_padlock_encrypt, aes256_padlock_encrypt, xts_aes_basic_encrypt);
+DEF_XTS_AES_PADLOCK(xts_aes_padlock_decrypt, aes256_padlock_decrypt, xts_aes_basic_decrypt);
+
+DEF_XTS_AES_NI_UNITS(xts_aes_ni_unit_encrypt, xts_aes_ni_encrypt, xts_aes_ni_encrypt_4k, xts_aes_basic_encrypt);
+DEF_XTS_AES_NI_UNITS(xts_aes_ni_unit_decrypt, xts_aes_ni_decrypt, xts_aes_ni_decrypt_4k, xts_aes_basic_decrypt);
+
+static void _stdcall xts_aes_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+#if defined(_M_IX86) && defined(KMDF_MAJOR_VERSION)
+	KFLOATING_SAVE state;
+	xts_proc       selected = aes_selected_encrypt;
+
+	if (selected == xts_aes_ni_unit_encrypt)
+	{
+		if ( (KeGetCurrentIrql() <= DISPATCH_LEVEL) &&
+			 (NT_SUCCESS(KeSaveFloatingPointState(&state)) != 0) )
+		{
+			xts_aes_ni_unit_encrypt(in, out, len, offset, key);
+			KeRestoreFloatingPointState(&state);
+		} else {
+			xts_aes_basic_encrypt(in, out, len, offset, key);
+		}
+	} else {
+		selected(in, out, len, offset, key);
+	}
+#else
+	aes_selected_encrypt(in, out, len, offset, key);
+#endif
+}
+
+static void _stdcall xts_aes_decrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+#if defined(_M_IX86) && defined(KMDF_MAJOR_VERSION)
+	KFLOATING_SAVE state;
+	xts_proc       selected = aes_selected_decrypt;
+
+	if (selected == xts_aes_ni_unit_decrypt)
+	{
+		if ( (KeGetCurrentIrql() <= DISPATCH_LEVEL) &&
+			 (NT_SUCCESS(KeSaveFloatingPointState(&state)) != 0) )
+		{
+			xts_aes_ni_unit_decrypt(in, out, len, offset, key);
+			KeRestoreFloatingPointState(&state);
+			return;
+		} else {
+			xts_aes_basic_decrypt(in, out, len, offset, key);
+		}
+	} else {
+		selected(in, out, len, offset, key);
+	}
+#else
+	aes_selected_decrypt(in, out, len, offset, key);
+#endif
+}
+
+static void _stdcall xts_aes_twofish_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_twofish_encrypt(in, out, len, offset, key);
+	xts_aes_encrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_aes_twofish_decrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_aes_decrypt(in, out, len, offset, key);
+	xts_twofish_decrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_twofish_serpent_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_serpent_encrypt(in, out, len, offset, key);
+	xts_twofish_encrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_twofish_serpent_decrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_twofish_decrypt(in, out, len, offset, key);
+	xts_serpent_decrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_serpent_aes_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_aes_encrypt(in, out, len, offset, key);
+	xts_serpent_encrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_serpent_aes_decrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_serpent_decrypt(in, out, len, offset, key);
+	xts_aes_decrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_aes_twofish_serpent_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_serpent_encrypt(in, out, len, offset, key);
+	xts_twofish_encrypt(out, out, len, offset, key);
+	xts_aes_encrypt(out, out, len, offset, key);
+}
+
+static void _stdcall xts_aes_twofish_serpent_decrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	xts_aes_decrypt(in, out, len, offset, key);
+	xts_twofish_decrypt(out, out, len, offset, key);
+	xts_serpent_decrypt(out, out, len, offset, key);
+}
+
+/* 
+   keystream is generated by ECB encryption of the little-endian 128 bit 
+   block index, in place in the output buffer. The ECB procedures below 
+   use the xts_proc signature, input and output always point to the same buffer.
+*/
+static void ctr_fill(unsigned char *out, size_t len, u64 offset)
+{
+	u64 idx = offset / XTS_BLOCK_SIZE;
+
+	for (; len != 0; len -= XTS_BLOCK_SIZE, out += XTS_BLOCK_SIZE) {
+		p64(out)[0] = idx++; p64(out)[1] = 0;
+	}
+}
+
+#define DEF_ECB_PROC(func_name, crypt_name, key_type, key_field) \
+                                                                 \
+static void _stdcall func_name( \
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key) \
+{                                                                                      \
+	key_type *sk = pv(p8(key) + key->key_field);                                       \
+	                                                                                   \
+	for (; len != 0; len -= XTS_BLOCK_SIZE) {                                          \
+		crypt_name(in, out, &sk->crypt_k);                                             \
+		in += XTS_BLOCK_SIZE; out += XTS_BLOCK_SIZE;                                   \
+	}                                                                                  \
+}
+
+DEF_ECB_PROC(ecb_aes_basic_encrypt, aes256_asm_encrypt, xts_aes_k, aes_k);
+DEF_ECB_PROC(ecb_twofish_encrypt, twofish256_encrypt, xts_twofish_k, twofish_k);
+DEF_ECB_PROC(ecb_serpent_encrypt, serpent256_encrypt, xts_serpent_k, serpent_k);
+
+static void _stdcall ecb_aes_padlock_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	u8    *buff;
+	size_t blen;
+
+	/* Padlock needs aligned data, process it in temporary buffer as xts_aes_padlock_encrypt */
+	if ( (buff = padlock_alloc_tmp()) == NULL ) {
+		ecb_aes_basic_encrypt(in, out, len, offset, key);
+		return;
+	}
+	for (; len != 0; len -= blen) 
+	{
+		blen = min(len, XTS_SECTOR_SIZE);
+		memcpy(buff, in, blen);
+		aes256_padlock_rekey();
+		aes256_padlock_encrypt(buff, buff, d32(blen / XTS_BLOCK_SIZE), &XTS_AES_K(key)->crypt_k);
+		memcpy(out, buff, blen);
+		in += blen; out += blen;
+	}
+	padlock_free_tmp(buff);
+}
+
+static void _stdcall ecb_aes_ni_encrypt(
+    const unsigned char *in, unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	__m128i *rk = pv(XTS_AES_K(key)->crypt_k.enc_key);
+	__m128i  b0, b1, b2, b3;
+	int      i;
+
+	for (; len >= XTS_BLOCK_SIZE*4; len -= XTS_BLOCK_SIZE*4)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x00)), rk[0]);
+		b1 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x10)), rk[0]);
+		b2 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x20)), rk[0]);
+		b3 = _mm_xor_si128(_mm_loadu_si128(pv(in + 0x30)), rk[0]);
+
+		for (i = 1; i < ROUNDS; i++) {
+			b0 = _mm_aesenc_si128(b0, rk[i]); b1 = _mm_aesenc_si128(b1, rk[i]);
+			b2 = _mm_aesenc_si128(b2, rk[i]); b3 = _mm_aesenc_si128(b3, rk[i]);
+		}
+		_mm_storeu_si128(pv(out + 0x00), _mm_aesenclast_si128(b0, rk[ROUNDS]));
+		_mm_storeu_si128(pv(out + 0x10), _mm_aesenclast_si128(b1, rk[ROUNDS]));
+		_mm_storeu_si128(pv(out + 0x20), _mm_aesenclast_si128(b2, rk[ROUNDS]));
+		_mm_storeu_si128(pv(out + 0x30), _mm_aesenclast_si128(b3, rk[ROUNDS]));
+
+		in += XTS_BLOCK_SIZE*4; out += XTS_BLOCK_SIZE*4;
+	}
+	for (; len != 0; len -= XTS_BLOCK_SIZE)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128(pv(in)), rk[0]);
+
+		for (i = 1; i < ROUNDS; i++) {
+			b0 = _mm_aesenc_si128(b0, rk[i]);
+		}
+		_mm_storeu_si128(pv(out), _mm_aesenclast_si128(b0, rk[ROUNDS]));
+
+		in += XTS_BLOCK_SIZE; out += XTS_BLOCK_SIZE;
+	}
+}
+
+static void ecb_aes_encrypt(unsigned char *buf, size_t len, xts_key *key)
+{
+#if defined(_M_IX86) && defined(KMDF_MAJOR_VERSION)
+	KFLOATING_SAVE state;
+	xts_proc       selected = aes_selected_ecb;
+
+	if (selected == ecb_aes_ni_encrypt)
+	{
+		if ( (KeGetCurrentIrql() <= DISPATCH_LEVEL) &&
+			 (NT_SUCCESS(KeSaveFloatingPointState(&state)) != 0) )
+		{
+			ecb_aes_ni_encrypt(buf, buf, len, 0, key);
+			KeRestoreFloatingPointState(&state);
+		} else {
+			ecb_aes_basic_encrypt(buf, buf, len, 0, key);
+		}
+	} else {
+		selected(buf, buf, len, 0, key);
+	}
+#else
+	aes_selected_ecb(buf, buf, len, 0, key);
+#endif
+}
+
+static void _stdcall ctr_aes_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_aes_encrypt(out, len, key);
+}
+
+static void _stdcall ctr_twofish_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_twofish_encrypt(out, out, len, 0, key);
+}
+
+static void _stdcall ctr_serpent_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_serpent_encrypt(out, out, len, 0, key);
+}
+
+static void _stdcall ctr_aes_twofish_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_twofish_encrypt(out, out, len, 0, key);
+	ecb_aes_encrypt(out, len, key);
+}
+
+static void _stdcall ctr_twofish_serpent_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_serpent_encrypt(out, out, len, 0, key);
+	ecb_twofish_encrypt(out, out, len, 0, key);
+}
+
+static void _stdcall ctr_serpent_aes_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_aes_encrypt(out, len, key);
+	ecb_serpent_encrypt(out, out, len, 0, key);
+}
+
+static void _stdcall ctr_aes_twofish_serpent_keystream(unsigned char *out, size_t len, u64 offset, xts_key *key)
+{
+	ctr_fill(out, len, offset);
+	ecb_serpent_encrypt(out, out, len, 0, key);
+	ecb_twofish_encrypt(out, out, len, 0, key);
+	ecb_aes_encrypt(out, len, key);
+}
+
+#define C_AES     1
+#define C_TWOFISH 2
+#define C_SERPENT 3
+
+/* ciphers of cascade in order of use by encryption, key material has the same order */
+static const u8 xts_cascades[CF_CIPHERS_NUM][4] = {
+	{ C_AES },                        /* CF_AES                 */
+	{ C_TWOFISH },                    /* CF_TWOFISH             */
+	{ C_SERPENT },                    /* CF_SERPENT             */
+	{ C_TWOFISH, C_AES },             /* CF_AES_TWOFISH         */
+	{ C_SERPENT, C_TWOFISH },         /* CF_TWOFISH_SERPENT     */
+	{ C_AES, C_SERPENT },             /* CF_SERPENT_AES         */
+	{ C_SERPENT, C_TWOFISH, C_AES }   /* CF_AES_TWOFISH_SERPENT */
+};
+
+static const u32 xts_sched_size[] = {
+	0, sizeof(xts_aes_k), sizeof(xts_twofish_k), sizeof(xts_serpent_k)
+};
+
+u32 xts_key_size(int alg)
+{
+	const u8 *c;
+	u32       size = offsetof(xts_key, sched);
+
+	for (c = xts_cascades[alg]; *c != 0; c++) {
+		size += xts_sched_size[*c];
+	}
+	return size;
+}
+
+void xts_set_key(const unsigned char *key, int alg, xts_key *skey)
+{
+	const u8 *c   = xts_cascades[alg];
+	u32       off = offsetof(xts_key, sched);
+	int       i, n;
+
+	for (n = 0; c[n] != 0; n++);
+
+	skey->aes_k     = 0;
+	skey->twofish_k = 0;
+	skey->serpent_k = 0;
+	skey->unit_size = XTS_SECTOR_SIZE;
+
+	/* crypt keys go first in key material, tweak keys after them */
+	for (i = 0; i < n; i++)
+	{
+		switch (c[i])
+		{
+			case C_AES:
+				skey->aes_k = d16(off);
+				aes256_asm_set_key(key + XTS_KEY_SIZE*i, &XTS_AES_K(skey)->crypt_k);
+				aes256_asm_set_key(key + XTS_KEY_SIZE*(i + n), &XTS_AES_K(skey)->tweak_k);
+			break;
+			case C_TWOFISH:
+				skey->twofish_k = d16(off);
+				twofish256_set_key(key + XTS_KEY_SIZE*i, &XTS_TWOFISH_K(skey)->crypt_k);
+				twofish256_set_key(key + XTS_KEY_SIZE*(i + n), &XTS_TWOFISH_K(skey)->tweak_k);
+			break;
+			case C_SERPENT:
+				skey->serpent_k = d16(off);
+				serpent256_set_key(key + XTS_KEY_SIZE*i, &XTS_SERPENT_K(skey)->crypt_k);
+				serpent256_set_key(key + XTS_KEY_SIZE*(i + n), &XTS_SERPENT_K(skey)->tweak_k);
+			break;
+		}
+		off += xts_sched_size[c[i]];
+	}
+	skey->size = d16(off);
+
+	switch (alg) 
+	{
+		case CF_AES:
+			skey->encrypt = xts_aes_encrypt;
+			skey->decrypt = xts_aes_decrypt;
+			skey->keystream = ctr_aes_keystream;
+		break;
+		case CF_TWOFISH:
+			skey->encrypt = xts_twofish_encrypt;
+			skey->decrypt = xts_twofish_decrypt;
+			skey->keystream = ctr_twofish_keystream;
+		break;
+		case CF_SERPENT:
+			skey->encrypt = xts_serpent_encrypt;
+			skey->decrypt = xts_serpent_decrypt;
+			skey->keystream = ctr_serpent_keystream;
+		break;
+		case CF_AES_TWOFISH:
+			skey->encrypt = xts_aes_twofish_encrypt;
+			skey->decrypt = xts_aes_twofish_decrypt;
+			skey->keystream = ctr_aes_twofish_keystream;
+		break;
+		case CF_TWOFISH_SERPENT:
+			skey->encrypt = xts_twofish_serpent_encrypt;
+			skey->decrypt = xts_twofish_serpent_decrypt;
+			skey->keystream = ctr_twofish_serpent_keystream;
+		break;
+		case CF_SERPENT_AES:
+			skey->encrypt = xts_serpent_aes_encrypt;
+			skey->decrypt = xts_serpent_aes_decrypt;
+			skey->keystream = ctr_serpent_aes_keystream;
+		break;
+		case CF_AES_TWOFISH_SERPENT:
+			skey->encrypt = xts_aes_twofish_serpent_encrypt;
+			skey->decrypt = xts_aes_twofish_serpent_decrypt;
+			skey->keystream = ctr_aes_twofish_serpent_keystream;
+		break;
+	}	
+}
+
+void xts_set_unit(xts_key *skey, u32 unit_size)
+{
+	skey->unit_size = unit_size;
+}
+
+void xts_init(int hw_crypt)
+{
+	if ( (hw_crypt != 0) && (xts_aes_ni_available() != 0) ) {
+		aes_selected_encrypt = xts_aes_ni_unit_encrypt;
+		aes_selected_decrypt = xts_aes_ni_unit_decrypt;
+		aes_selected_ecb     = ecb_aes_ni_encrypt;
+		return;
+	}
+	if ( (hw_crypt != 0) && (aes256_padlock_available() != 0) ) 
+	{
+#ifdef KMDF_MAJOR_VERSION
+		if (lock_xchg(&padlock_tmp_ok, 1) == 0) {
+			ExInitializeNPagedLookasideList(&padlock_tmp_mem, NULL, NULL, 0, PAGE_SIZE, 'ldap', 0);
+		}
+#endif
+		aes_selected_encrypt = xts_aes_padlock_encrypt;
+		aes_selected_decrypt = xts_aes_padlock_decrypt;
+		aes_selected_ecb     = ecb_aes_padlock_encrypt;
+		return;
+	}
+	aes_selected_encrypt = xts_aes_basic_encrypt;
+	aes_selected_decrypt = xts_aes_basic_decrypt;
+	aes_selected_ecb     = ecb_aes_basic_encrypt;
 }
\ No newline at end of file
@@ -1,49 +1,82 @@
-#ifndef _XTS_FAST_H_
-#define _XTS_FAST_H_
-
-#include "aes_key.h"
-#include "twofish.h"
-#include "serpent.h"
-
-#define CF_AES                 0
-#define CF_TWOFISH             1
-#define CF_SERPENT             2
-#define CF_AES_TWOFISH         3
-#define CF_TWOFISH_SERPENT     4
-#define CF_SERPENT_AES         5
-#define CF_AES_TWOFISH_SERPENT 6
-#define CF_CIPHERS_NUM         7
-
-#define XTS_SECTOR_SIZE      512
-#define XTS_BLOCK_SIZE       16
-#define XTS_BLOCKS_IN_SECTOR (XTS_SECTOR_SIZE / XTS_BLOCK_SIZE)
-
-#define XTS_KEY_SIZE   32
-#define XTS_FULL_KEY   (XTS_KEY_SIZE*3*2)
-
-typedef void (_stdcall *xts_proc)(
-	const unsigned char *in, unsigned char *out, size_t len, u64 offset, struct _xts_key *key);
-
-typedef align16 struct _xts_key {
-	struct {
-		aes256_key     aes;
-		twofish256_key twofish;
-		serpent256_key serpent;
-	} crypt_k;
-	struct {
-		aes256_key     aes;
-		twofish256_key twofish;
-		serpent256_key serpent;
-	} tweak_k;
-	xts_proc encrypt;
-	xts_proc decrypt;
-	
-} xts_key;
-
-void xts_init(int hw_crypt);
-void xts_set_key(const unsigned char *key, int alg, xts_key *skey);
-
-#define xts_encrypt(_in, _out, _len, _offset, _key) ( (_key)->encrypt(_in, _out, _len, _offset, _key) )
-#define xts_decrypt(_in, _out, _len, _offset, _key) ( (_key)->decrypt(_in, _out, _len, _offset, _key) )
-
+#ifndef _XTS_FAST_H_
+#define _XTS_FAST_H_
+
+#include "aes_key.h"
+#include "twofish.h"
+#include "serpent.h"
+
+#define CF_AES                 0
+#define CF_TWOFISH             1
+#define CF_SERPENT             2
+#define CF_AES_TWOFISH         3
+#define CF_TWOFISH_SERPENT     4
+#define CF_SERPENT_AES         5
+#define CF_AES_TWOFISH_SERPENT 6
+#define CF_CIPHERS_NUM         7
+
+#define XTS_SECTOR_SIZE      512
+#define XTS_BLOCK_SIZE       16
+#define XTS_BLOCKS_IN_SECTOR (XTS_SECTOR_SIZE / XTS_BLOCK_SIZE)
+#define XTS_MAX_UNIT_SIZE    4096 /* largest supported XTS data unit */
+
+#define XTS_KEY_SIZE   32
+#define XTS_FULL_KEY   (XTS_KEY_SIZE*3*2)
+
+struct _xts_key;
+
+typedef void (_stdcall *xts_proc)(
+	const unsigned char *in, unsigned char *out, size_t len, u64 offset, struct _xts_key *key);
+
+typedef void (_stdcall *xts_ks_proc)(
+	unsigned char *out, size_t len, u64 offset, struct _xts_key *key);
+
+/* crypt and tweak schedules of one cipher, tweak key follows crypt key */
+typedef align16 struct _xts_aes_k {
+	aes256_key     crypt_k;
+	aes256_key     tweak_k;
+} xts_aes_k;
+
+typedef align16 struct _xts_twofish_k {
+	twofish256_key crypt_k;
+	twofish256_key tweak_k;
+} xts_twofish_k;
+
+typedef align16 struct _xts_serpent_k {
+	serpent256_key crypt_k;
+	serpent256_key tweak_k;
+} xts_serpent_k;
+
+#define XTS_SCHED_SIZE (sizeof(xts_aes_k) + sizeof(xts_twofish_k) + sizeof(xts_serpent_k))
+
+/*
+   only schedules of ciphers used by key are stored in sched, in order in
+   which encryption uses them. key may be allocated with xts_key_size(alg) 
+   bytes, such keys must be copied and cleared with [size] bytes only.
+*/
+typedef align16 struct _xts_key {
+	xts_proc    encrypt;
+	xts_proc    decrypt;
+	xts_ks_proc keystream; /* counter mode keystream with data key */
+	u32         unit_size; /* XTS data unit size, XTS_SECTOR_SIZE or XTS_MAX_UNIT_SIZE */
+	u16         size;      /* used size of key */
+	u16         aes_k;     /* schedule offsets from key start, 0 - cipher not used */
+	u16         twofish_k;
+	u16         serpent_k;
+	align16 u8  sched[XTS_SCHED_SIZE];
+	
+} xts_key;
+
+#define XTS_AES_K(_key)     ( (xts_aes_k*)    (p8(_key) + (_key)->aes_k) )
+#define XTS_TWOFISH_K(_key) ( (xts_twofish_k*)(p8(_key) + (_key)->twofish_k) )
+#define XTS_SERPENT_K(_key) ( (xts_serpent_k*)(p8(_key) + (_key)->serpent_k) )
+
+void xts_init(int hw_crypt);
+void xts_set_key(const unsigned char *key, int alg, xts_key *skey);
+void xts_set_unit(xts_key *skey, u32 unit_size);
+u32  xts_key_size(int alg);
+
+#define xts_encrypt(_in, _out, _len, _offset, _key) ( (_key)->encrypt(_in, _out, _len, _offset, _key) )
+#define xts_decrypt(_in, _out, _len, _offset, _key) ( (_key)->decrypt(_in, _out, _len, _offset, _key) )
+#define xts_keystream(_out, _len, _offset, _key)    ( (_key)->keystream(_out, _len, _offset, _key) )
+
 #endif
\ No newline at end of file
@@ -0,0 +1,237 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include "defines.h"
+#include "dcconst.h"
+#include "volume.h"
+#include "cd_pipe.h"
+#include "mt_sync.h"
+
+/*
+   reader thread -> buffers ring -> crypto threads -> caller thread (writer)
+   buffers are written strictly in order, so output does not depend on
+   number of threads or buffers
+*/
+
+typedef struct _pipe_buff {
+	u8      *data;
+	u32      size;   /* bytes of source data          */
+	u32      w_len;  /* size aligned to sector size   */
+	int      status; /* read status                   */
+	mt_sem   done;   /* signaled when buffer encrypted */
+
+} pipe_buff;
+
+typedef struct _pipe_ctx {
+	cd_read_proc  read_p;
+	void         *r_ctx;
+	xts_key      *v_key;
+	u64           iso_sz;
+	u64           n_chunks;
+	u32           buff_size;
+	u32           n_buffs;
+	u32           n_threads;
+	volatile long next;   /* next chunk for crypto threads   */
+	volatile long n_read; /* number of chunks passed by reader */
+	volatile int  stop;
+	mt_sem        s_free; /* free buffers                    */
+	mt_sem        s_full; /* buffers ready for encryption    */
+	pipe_buff     buffs[CD_PIPE_MAX_BUFFS];
+
+} pipe_ctx;
+
+static MT_THREAD_PROC(cd_pipe_reader)
+{
+	pipe_ctx  *ctx = param;
+	pipe_buff *buf;
+	u64        i, offset = 0;
+	u32        bytes;
+
+	for (i = 0; i < ctx->n_chunks; i++)
+	{
+		mt_sem_get(&ctx->s_free);
+
+		if (ctx->stop != 0) {
+			break;
+		}
+		buf = &ctx->buffs[i % ctx->n_buffs];
+		buf->size  = d32(min(ctx->iso_sz - offset, ctx->buff_size));
+		buf->w_len = _align(buf->size, CD_SECTOR_SIZE);
+
+		/* unbuffered I/O requires aligned request size */
+		buf->status = ctx->read_p(
+			ctx->r_ctx, buf->data, _align(buf->size, CD_PIPE_ALIGN), offset, &bytes);
+
+		if ( (buf->status == ST_OK) && (bytes < buf->size) ) {
+			buf->status = ST_IO_ERROR;
+		}
+		if (buf->status == ST_OK) {
+			memset(buf->data + buf->size, 0, buf->w_len - buf->size);
+		}
+		offset += buf->size;
+		lock_xchg(&ctx->n_read, d32(i + 1));
+		mt_sem_put(&ctx->s_full, 1);
+
+		if (buf->status != ST_OK) {
+			break;
+		}
+	}
+	/* release crypto threads */
+	mt_sem_put(&ctx->s_full, ctx->n_threads);
+	MT_THREAD_RET;
+}
+
+static MT_THREAD_PROC(cd_pipe_crypt)
+{
+	pipe_ctx  *ctx = param;
+	pipe_buff *buf;
+	u64        seq;
+
+	for (;;)
+	{
+		mt_sem_get(&ctx->s_full);
+		seq = d64(lock_inc(&ctx->next) - 1);
+
+		/* extra wakeups past the last read chunk terminate the thread */
+		if ( (ctx->stop != 0) || (seq >= d64(ctx->n_read)) ) {
+			break;
+		}
+		buf = &ctx->buffs[seq % ctx->n_buffs];
+
+		if (buf->status == ST_OK) {
+			xts_encrypt(buf->data, buf->data, buf->w_len, seq * ctx->buff_size, ctx->v_key);
+		}
+		mt_sem_put(&buf->done, 1);
+	}
+
+	MT_THREAD_RET;
+}
+
+int cd_pipe_encrypt(
+	  cd_read_proc  read_p,  void *r_ctx,
+	  cd_write_proc write_p, void *w_ctx, u64 w_offset,
+	  u64 iso_sz, xts_key *v_key, cd_pipe_conf *conf, cd_callback callback, void *param
+	  )
+{
+	pipe_ctx   *ctx;
+	pipe_buff  *buf;
+	mt_thread   reader, workers[CD_PIPE_MAX_THREADS];
+	u32         i, n_sems = 0, n_workers = 0;
+	int         reader_ok = 0, queue_ok = 0, resl;
+	u64         j, offset = 0;
+
+	if ( (ctx = calloc(1, sizeof(pipe_ctx))) == NULL ) {
+		return ST_NOMEM;
+	}
+	ctx->read_p    = read_p;
+	ctx->r_ctx     = r_ctx;
+	ctx->v_key     = v_key;
+	ctx->iso_sz    = iso_sz;
+	ctx->buff_size = (conf != NULL) && (conf->buff_size != 0) ? conf->buff_size : CD_PIPE_BUFSZ;
+	ctx->n_threads = (conf != NULL) && (conf->n_threads != 0) ? conf->n_threads : mt_cpu_count();
+	ctx->n_threads = max(1, min(ctx->n_threads, CD_PIPE_MAX_THREADS));
+	ctx->n_buffs   = (conf != NULL) && (conf->n_buffs != 0) ? conf->n_buffs : max(CD_PIPE_BUFFS, ctx->n_threads + 2);
+	ctx->n_buffs   = max(1, min(ctx->n_buffs, CD_PIPE_MAX_BUFFS));
+	ctx->n_chunks  = (iso_sz + ctx->buff_size - 1) / ctx->buff_size;
+
+	do
+	{
+		if ( (ctx->buff_size % CD_PIPE_ALIGN) != 0 ) {
+			resl = ST_ERROR; break;
+		}
+		resl = ST_NOMEM;
+
+		for (i = 0; i < ctx->n_buffs; i++, n_sems++)
+		{
+			if ( (ctx->buffs[i].data = mt_alloc(ctx->buff_size)) == NULL ) break;
+			if (mt_sem_make(&ctx->buffs[i].done, 0) == 0) break;
+		}
+		if (n_sems != ctx->n_buffs) {
+			break;
+		}
+		if (mt_sem_make(&ctx->s_free, ctx->n_buffs) == 0) {
+			break;
+		}
+		if (mt_sem_make(&ctx->s_full, 0) == 0) {
+			mt_sem_free(&ctx->s_free); break;
+		}
+		queue_ok = 1;
+
+		for (i = 0; i < ctx->n_threads; i++, n_workers++) {
+			if (mt_thread_start(&workers[i], cd_pipe_crypt, ctx) == 0) break;
+		}
+		if ( (n_workers == 0) || (reader_ok = mt_thread_start(&reader, cd_pipe_reader, ctx)) == 0 ) {
+			break;
+		}
+		resl = ST_OK;
+
+		/* write encrypted buffers in order */
+		for (j = 0; j < ctx->n_chunks; j++)
+		{
+			buf = &ctx->buffs[j % ctx->n_buffs];
+			mt_sem_get(&buf->done);
+
+			if ( (resl = buf->status) != ST_OK ) {
+				break;
+			}
+			if ( (resl = write_p(w_ctx, buf->data, buf->w_len, w_offset + offset)) != ST_OK ) {
+				break;
+			}
+			offset += buf->w_len;
+
+			if ( (callback != NULL) && ((resl = callback(iso_sz, offset, param)) != ST_OK) ) {
+				break;
+			}
+			mt_sem_put(&ctx->s_free, 1);
+		}
+	} while (0);
+
+	/* stop and wait all threads */
+	if ( (n_workers != 0) || (reader_ok != 0) )
+	{
+		ctx->stop = 1;
+		mt_sem_put(&ctx->s_free, ctx->n_buffs);
+		mt_sem_put(&ctx->s_full, n_workers);
+
+		if (reader_ok != 0) {
+			mt_thread_join(&reader);
+		}
+		for (i = 0; i < n_workers; i++) {
+			mt_thread_join(&workers[i]);
+		}
+	}
+	if (queue_ok != 0) {
+		mt_sem_free(&ctx->s_free);
+		mt_sem_free(&ctx->s_full);
+	}
+	for (i = 0; i < ctx->n_buffs; i++)
+	{
+		if (i < n_sems) {
+			mt_sem_free(&ctx->buffs[i].done);
+		}
+		if (ctx->buffs[i].data != NULL) {
+			mt_free(ctx->buffs[i].data);
+		}
+	}
+	free(ctx);
+
+	return resl;
+}
@@ -1,140 +1,261 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-	* Copyright (c) 2008 
-	* ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <windows.h>
-#include <stdio.h>
-#include "misc.h"
-#include "keyfiles.h"
-#include "volume.h"
-#include "sha512.h"
-#include "drv_ioctl.h"
-
-#define KF_BLOCK_SIZE (64 * 1024)
-
-typedef struct _kf_ctx {
-	sha512_ctx sha;
-	u8         kf_block[KF_BLOCK_SIZE];
-	u8         hash[SHA512_DIGEST_SIZE];
-
-} kf_ctx;
-
-static
-int dc_add_single_kf(dc_pass *pass, wchar_t *path)
-{
-	kf_ctx *k_ctx;
-	HANDLE  h_file;
-	int     resl, i;
-	int     succs;
-	u32     bytes;
-
-	h_file = NULL; k_ctx = NULL;
-	do
-	{
-		if ( (k_ctx = secure_alloc(sizeof(kf_ctx))) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-
-		h_file = CreateFile(
-			path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
-
-		if (h_file == INVALID_HANDLE_VALUE) {
-			h_file = NULL; resl = ST_ACCESS_DENIED; break;
-		}
-
-		/* initialize sha512 for hashing keyfile */
-		sha512_init(&k_ctx->sha);
-
-		do
-		{
-			succs = ReadFile(h_file, k_ctx->kf_block, KF_BLOCK_SIZE, &bytes, NULL);
-
-			if ( (succs == 0) || (bytes == 0) ) {
-				break;
-			}
-			sha512_hash(&k_ctx->sha, k_ctx->kf_block, bytes);
-		} while (1);		
-	
-		/* done hasing */
-		sha512_done(&k_ctx->sha, k_ctx->hash);
-
-		/* zero unused password buffer bytes */
-		zeromem(
-			p8(pass->pass) + pass->size, (MAX_PASSWORD*2) - pass->size);
-
-		/* mix the keyfile hash and password */
-		for (i = 0; i < (SHA512_DIGEST_SIZE / sizeof(u32)); i++) {
-			p32(pass->pass)[i] += p32(k_ctx->hash)[i];
-		}
-		pass->size = max(pass->size, SHA512_DIGEST_SIZE); 
-		resl = ST_OK;		
-	} while (0);
-
-	if (h_file != NULL) {
-		CloseHandle(h_file);
-	}
-
-	if (k_ctx != NULL) {
-		secure_free(k_ctx);
-	}
-
-	return resl;
-}
-
-int dc_add_keyfiles(dc_pass *pass, wchar_t *path)
-{
-	WIN32_FIND_DATA find;
-	wchar_t         name[MAX_PATH * 2];	
-	HANDLE          h_find;
-	int             resl;
-	
-	_snwprintf(
-		name, sizeof_w(name), L"%s\\*", path);
-
-	h_find = FindFirstFile(name, &find);
-
-	if (h_find != INVALID_HANDLE_VALUE)
-	{
-		resl = ST_EMPTY_KEYFILES;
-		do
-		{
-			if (find.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-				/* recurse folder scanning not needed */
-				continue;
-			}
-
-			_snwprintf(
-				name, sizeof_w(name), L"%s\\%s", path, find.cFileName);
-
-			if ( (resl = dc_add_single_kf(pass, name)) != ST_OK ) {
-				break;
-			}
-		} while (FindNextFile(h_find, &find) != 0);
-
-		FindClose(h_find);
-	} else {
-		resl = dc_add_single_kf(pass, path);
-	}
-
-	/* prevent leaks */
-	zeroauto(&find, sizeof(find));
-	zeroauto(&name, sizeof(name));
-
-	return resl;
-}
\ No newline at end of file
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+	* Copyright (c) 2008 
+	* ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "misc.h"
+#include "keyfiles.h"
+#include "volume.h"
+#include "sha512.h"
+#include "drv_ioctl.h"
+#include "mt_sync.h"
+
+#define KF_BLOCK_SIZE  (128 * 1024) /* size of one sequential read */
+#define KF_MAX_THREADS 8
+#define KF_LIST_GROW   64
+
+typedef struct _kf_ctx {
+	sha512_ctx sha;
+	OVERLAPPED ov[2];
+	u8         kf_block[2][KF_BLOCK_SIZE];
+
+} kf_ctx;
+
+typedef struct _kf_list {
+	wchar_t     **paths;
+	u8           *hashes; /* SHA512_DIGEST_SIZE bytes for each file */
+	int          *status;
+	u32           count;
+	volatile long next;   /* next file for hashing threads */
+
+} kf_list;
+
+/* start reading of next block, returns 0 on end of file or error */
+static int kf_read_block(HANDLE h_file, kf_ctx *k_ctx, int n, u64 offset)
+{
+	OVERLAPPED *ov = &k_ctx->ov[n];
+
+	ov->Offset       = d32(offset);
+	ov->OffsetHigh   = d32(offset >> 32);
+	ov->Internal     = 0;
+	ov->InternalHigh = 0;
+
+	if (ReadFile(h_file, k_ctx->kf_block[n], KF_BLOCK_SIZE, NULL, ov) != 0) {
+		return 1;
+	}
+	return GetLastError() == ERROR_IO_PENDING;
+}
+
+static int kf_hash_file(kf_ctx *k_ctx, wchar_t *path, u8 *hash)
+{
+	HANDLE h_file;
+	u64    offset = 0;
+	u32    bytes;
+	int    n = 0, pending;
+
+	h_file = CreateFile(
+		path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+	if (h_file == INVALID_HANDLE_VALUE) {
+		return ST_ACCESS_DENIED;
+	}
+
+	/* initialize sha512 for hashing keyfile */
+	sha512_init(&k_ctx->sha);
+
+	/* next block is read while current block hashed, only one read is pending at any time */
+	for (pending = kf_read_block(h_file, k_ctx, n, offset); pending != 0; n ^= 1)
+	{
+		if ( (GetOverlappedResult(h_file, &k_ctx->ov[n], &bytes, TRUE) == 0) || (bytes == 0) ) {
+			break;
+		}
+		offset += bytes;
+		pending = kf_read_block(h_file, k_ctx, n ^ 1, offset);
+
+		sha512_hash(&k_ctx->sha, k_ctx->kf_block[n], bytes);
+	}
+
+	/* done hasing */
+	sha512_done(&k_ctx->sha, hash);
+	CloseHandle(h_file);
+
+	return ST_OK;
+}
+
+static MT_THREAD_PROC(kf_hash_thread)
+{
+	kf_list *list = param;
+	kf_ctx  *k_ctx;
+	u32      i;
+
+	if ( (k_ctx = secure_alloc(sizeof(kf_ctx))) == NULL ) {
+		MT_THREAD_RET;
+	}
+	k_ctx->ov[0].hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	k_ctx->ov[1].hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	if ( (k_ctx->ov[0].hEvent != NULL) && (k_ctx->ov[1].hEvent != NULL) )
+	{
+		while ( (i = d32(lock_inc(&list->next) - 1)) < list->count ) {
+			list->status[i] = kf_hash_file(k_ctx, list->paths[i], list->hashes + i * SHA512_DIGEST_SIZE);
+		}
+	}
+	if (k_ctx->ov[0].hEvent != NULL) CloseHandle(k_ctx->ov[0].hEvent);
+	if (k_ctx->ov[1].hEvent != NULL) CloseHandle(k_ctx->ov[1].hEvent);
+
+	secure_free(k_ctx);
+	MT_THREAD_RET;
+}
+
+static int kf_list_add(kf_list *list, wchar_t *path)
+{
+	wchar_t **paths;
+
+	if ( (list->count % KF_LIST_GROW) == 0 )
+	{
+		if ( (paths = realloc(list->paths, (list->count + KF_LIST_GROW) * sizeof(wchar_t*))) == NULL ) {
+			return ST_NOMEM;
+		}
+		list->paths = paths;
+	}
+	if ( (list->paths[list->count] = _wcsdup(path)) == NULL ) {
+		return ST_NOMEM;
+	}
+	list->count++;
+
+	return ST_OK;
+}
+
+/* hash all keyfiles, independent files are hashed in parallel */
+static int kf_hash_list(kf_list *list)
+{
+	mt_thread threads[KF_MAX_THREADS];
+	u32       i, n_threads;
+
+	if ( (list->hashes = secure_alloc(list->count * SHA512_DIGEST_SIZE)) == NULL ) {
+		return ST_NOMEM;
+	}
+	if ( (list->status = malloc(list->count * sizeof(int))) == NULL ) {
+		return ST_NOMEM;
+	}
+	for (i = 0; i < list->count; i++) {
+		list->status[i] = ST_NOMEM;
+	}
+	n_threads = min(min(mt_cpu_count(), list->count), KF_MAX_THREADS);
+
+	/* calling thread also hashes files */
+	for (i = 0; (i + 1) < n_threads; i++) {
+		if (mt_thread_start(&threads[i], kf_hash_thread, list) == 0) break;
+	}
+	n_threads = i;
+	kf_hash_thread(list);
+
+	for (i = 0; i < n_threads; i++) {
+		mt_thread_join(&threads[i]);
+	}
+	return ST_OK;
+}
+
+static void kf_mix_hash(dc_pass *pass, u8 *hash)
+{
+	int i;
+
+	/* zero unused password buffer bytes */
+	zeromem(
+		p8(pass->pass) + pass->size, (MAX_PASSWORD*2) - pass->size);
+
+	/* mix the keyfile hash and password */
+	for (i = 0; i < (SHA512_DIGEST_SIZE / sizeof(u32)); i++) {
+		p32(pass->pass)[i] += p32(hash)[i];
+	}
+	pass->size = max(pass->size, SHA512_DIGEST_SIZE);
+}
+
+int dc_add_keyfiles(dc_pass *pass, wchar_t *path)
+{
+	WIN32_FIND_DATA find;
+	wchar_t         name[MAX_PATH * 2];
+	HANDLE          h_find;
+	kf_list         list;
+	u32             i;
+	int             resl;
+
+	zeromem(&list, sizeof(list));
+
+	_snwprintf(
+		name, sizeof_w(name), L"%s\\*", path);
+
+	h_find = FindFirstFile(name, &find);
+
+	if (h_find != INVALID_HANDLE_VALUE)
+	{
+		resl = ST_OK;
+		do
+		{
+			if (find.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+				/* recurse folder scanning not needed */
+				continue;
+			}
+
+			_snwprintf(
+				name, sizeof_w(name), L"%s\\%s", path, find.cFileName);
+
+			if ( (resl = kf_list_add(&list, name)) != ST_OK ) {
+				break;
+			}
+		} while (FindNextFile(h_find, &find) != 0);
+
+		FindClose(h_find);
+	} else {
+		resl = kf_list_add(&list, path);
+	}
+
+	if ( (resl == ST_OK) && (list.count == 0) ) {
+		resl = ST_EMPTY_KEYFILES;
+	}
+	if (resl == ST_OK) {
+		resl = kf_hash_list(&list);
+	}
+
+	/* mix hashes in directory order, stop on first failed file as before */
+	for (i = 0; (resl == ST_OK) && (i < list.count); i++)
+	{
+		if ( (resl = list.status[i]) == ST_OK ) {
+			kf_mix_hash(pass, list.hashes + i * SHA512_DIGEST_SIZE);
+		}
+	}
+
+	/* prevent leaks */
+	for (i = 0; i < list.count; i++) {
+		zeromem(list.paths[i], wcslen(list.paths[i]) * sizeof(wchar_t));
+		free(list.paths[i]);
+	}
+	if (list.hashes != NULL) {
+		secure_free(list.hashes);
+	}
+	free(list.paths);
+	free(list.status);
+
+	zeroauto(&find, sizeof(find));
+	zeroauto(&name, sizeof(name));
+
+	return resl;
+}
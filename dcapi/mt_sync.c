@@ -0,0 +1,104 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef CRYPTO_PORTABLE
+ #include <stdlib.h>
+ #include <unistd.h>
+#endif
+#include "defines.h"
+#include "mt_sync.h"
+
+#ifdef CRYPTO_PORTABLE
+
+int mt_sem_make(mt_sem *s, u32 count) {
+	return sem_init(s, 0, count) == 0;
+}
+
+void mt_sem_free(mt_sem *s) {
+	sem_destroy(s);
+}
+
+void mt_sem_get(mt_sem *s) {
+	while (sem_wait(s) != 0);
+}
+
+void mt_sem_put(mt_sem *s, u32 count) {
+	for (; count != 0; count--) sem_post(s);
+}
+
+int mt_thread_start(mt_thread *t, mt_thread_proc proc, void *param) {
+	return pthread_create(t, NULL, proc, param) == 0;
+}
+
+void mt_thread_join(mt_thread *t) {
+	pthread_join(*t, NULL);
+}
+
+void *mt_alloc(u32 size) {
+	void *p; return posix_memalign(&p, 4096, size) == 0 ? p : NULL;
+}
+
+void mt_free(void *p) {
+	free(p);
+}
+
+u32 mt_cpu_count() {
+	return d32(sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+#else
+
+int mt_sem_make(mt_sem *s, u32 count) {
+	return (*s = CreateSemaphore(NULL, count, MAXLONG, NULL)) != NULL;
+}
+
+void mt_sem_free(mt_sem *s) {
+	CloseHandle(*s);
+}
+
+void mt_sem_get(mt_sem *s) {
+	WaitForSingleObject(*s, INFINITE);
+}
+
+void mt_sem_put(mt_sem *s, u32 count) {
+	ReleaseSemaphore(*s, count, NULL);
+}
+
+int mt_thread_start(mt_thread *t, mt_thread_proc proc, void *param) {
+	return (*t = CreateThread(NULL, 0, proc, param, 0, NULL)) != NULL;
+}
+
+void mt_thread_join(mt_thread *t) {
+	WaitForSingleObject(*t, INFINITE); CloseHandle(*t);
+}
+
+void *mt_alloc(u32 size) {
+	return VirtualAlloc(NULL, size, MEM_COMMIT+MEM_RESERVE, PAGE_READWRITE);
+}
+
+void mt_free(void *p) {
+	VirtualFree(p, 0, MEM_RELEASE);
+}
+
+u32 mt_cpu_count() {
+	SYSTEM_INFO inf; GetSystemInfo(&inf); return inf.dwNumberOfProcessors;
+}
+
+#endif /* CRYPTO_PORTABLE */
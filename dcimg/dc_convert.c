@@ -0,0 +1,548 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifndef CRYPTO_PORTABLE
+ #include <windows.h>
+ #include <wincrypt.h>
+#endif
+#include "defines.h"
+#include "dcconst.h"
+#include "volume.h"
+#include "pkcs5.h"
+#include "dc_convert.h"
+
+/*
+   reader thread -> calling thread (parallel crypt) -> writer thread
+   buffers are written in order, writer saves progress to volume header
+   only after data flushed to disk
+*/
+
+typedef struct _conv_buff {
+	u8  *data;
+	u64  offset;
+	u32  size;
+	int  status; /* read status */
+
+} conv_buff;
+
+typedef struct _conv_ctx {
+	dc_image     *img;
+	dc_header    *header;
+	xts_key      *h_key;
+	u64           start;
+	u64           end;
+	int           backward;  /* decryption goes from end to start */
+	u32           buff_size;
+	u32           n_buffs;
+	u64           n_chunks;
+	u64           checkpoint;
+	u32           unit_size; /* XTS data unit of new key */
+	u64           tmp_size;  /* progress of written data */
+	int           w_resl;
+	volatile long n_read;
+	volatile long n_crypt;
+	volatile int  stop;
+	mt_sem        s_free;
+	mt_sem        s_read;
+	mt_sem        s_crypt;
+	conv_buff     buffs[CONV_MAX_BUFFS];
+
+} conv_ctx;
+
+static int conv_random(void *buff, u32 size)
+{
+#ifdef CRYPTO_PORTABLE
+	FILE *f;
+	int   succs;
+
+	if ( (f = fopen("/dev/urandom", "rb")) == NULL ) {
+		return 0;
+	}
+	succs = fread(buff, 1, size, f) == size;
+	fclose(f);
+	return succs;
+#else
+	HCRYPTPROV prov;
+	int        succs;
+
+	if (CryptAcquireContext(&prov, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT) == 0) {
+		return 0;
+	}
+	succs = CryptGenRandom(prov, size, buff) != 0;
+	CryptReleaseContext(prov, 0);
+	return succs;
+#endif
+}
+
+static void conv_hdr_key(xts_key *h_key, dc_header *header, int cipher, const void *pass, u32 pass_len)
+{
+	u8 dk[DISKKEY_SIZE];
+
+	sha512_pkcs5_2(
+		1000, pass, pass_len, pv(header->salt), PKCS5_SALT_SIZE, pv(dk), PKCS_DERIVE_MAX);
+
+	xts_set_key(dk, cipher, h_key);
+
+	/* prevent leaks */
+	zeroauto(dk, sizeof(dk));
+}
+
+/* same as dc_save_enc_state, data must be flushed before progress saved */
+static int conv_save_state(dc_image *img, dc_header *header, xts_key *h_key, u64 tmp_size)
+{
+	int resl;
+
+	if ( (resl = dc_img_flush(img)) != ST_OK ) {
+		return resl;
+	}
+	header->tmp_size = tmp_size;
+
+	if ( (resl = dc_img_write_header(img, header, h_key)) == ST_OK ) {
+		resl = dc_img_flush(img);
+	}
+	return resl;
+}
+
+static void conv_chunk(conv_ctx *ctx, u64 i, conv_buff *buf)
+{
+	u64 c_end;
+
+	if (ctx->backward != 0) {
+		c_end       = ctx->end - i * ctx->buff_size;
+		buf->size   = d32(min(c_end - ctx->start, ctx->buff_size));
+		buf->offset = c_end - buf->size;
+	} else {
+		buf->offset = ctx->start + i * ctx->buff_size;
+		buf->size   = d32(min(ctx->end - buf->offset, ctx->buff_size));
+	}
+}
+
+static MT_THREAD_PROC(conv_reader)
+{
+	conv_ctx  *ctx = param;
+	conv_buff *buf;
+	u64        i;
+
+	for (i = 0; i < ctx->n_chunks; i++)
+	{
+		mt_sem_get(&ctx->s_free);
+
+		if (ctx->stop != 0) {
+			break;
+		}
+		buf = &ctx->buffs[i % ctx->n_buffs];
+		conv_chunk(ctx, i, buf);
+
+		buf->status = dc_img_raw_io(ctx->img, buf->data, buf->size, buf->offset, 0);
+
+		lock_xchg(&ctx->n_read, d32(i + 1));
+		mt_sem_put(&ctx->s_read, 1);
+
+		if (buf->status != ST_OK) {
+			break;
+		}
+	}
+	/* release calling thread */
+	mt_sem_put(&ctx->s_read, 1);
+	MT_THREAD_RET;
+}
+
+static MT_THREAD_PROC(conv_writer)
+{
+	conv_ctx  *ctx = param;
+	conv_buff *buf;
+	u64        i, saved = 0, done = 0;
+	int        resl;
+
+	for (i = 0; ; i++)
+	{
+		mt_sem_get(&ctx->s_crypt);
+
+		/* extra wakeup after last crypted buffer */
+		if (i >= d64(ctx->n_crypt)) {
+			break;
+		}
+		buf = &ctx->buffs[i % ctx->n_buffs];
+
+		if ( (resl = dc_img_raw_io(ctx->img, buf->data, buf->size, buf->offset, 1)) != ST_OK ) {
+			ctx->w_resl = resl;
+			ctx->stop   = 1;
+			mt_sem_put(&ctx->s_free, ctx->n_buffs);
+			break;
+		}
+		ctx->tmp_size = ctx->backward != 0 ? buf->offset : buf->offset + buf->size;
+		done += buf->size;
+
+		if (done - saved >= ctx->checkpoint)
+		{
+			if ( (resl = conv_save_state(ctx->img, ctx->header, ctx->h_key, ctx->tmp_size)) != ST_OK ) {
+				ctx->w_resl = resl;
+				ctx->stop   = 1;
+				mt_sem_put(&ctx->s_free, ctx->n_buffs);
+				break;
+			}
+			saved = done;
+		}
+		mt_sem_put(&ctx->s_free, 1);
+	}
+	MT_THREAD_RET;
+}
+
+static int conv_run(conv_ctx *ctx, int op, dc_img_callback callback, void *param)
+{
+	dc_image  *img = ctx->img;
+	conv_buff *buf;
+	mt_thread  reader, writer;
+	u32        i, n_sems = 0;
+	int        reader_ok = 0, writer_ok = 0, resl;
+	u64        j, done = 0;
+
+	ctx->n_chunks = (ctx->end - ctx->start + ctx->buff_size - 1) / ctx->buff_size;
+	ctx->tmp_size = ctx->backward != 0 ? ctx->end : ctx->start;
+
+	do
+	{
+		resl = ST_NOMEM;
+
+		for (i = 0; i < ctx->n_buffs; i++) {
+			if ( (ctx->buffs[i].data = mt_alloc(ctx->buff_size)) == NULL ) break;
+		}
+		if (i != ctx->n_buffs) {
+			break;
+		}
+		if (mt_sem_make(&ctx->s_free, ctx->n_buffs) == 0) break; else n_sems++;
+		if (mt_sem_make(&ctx->s_read, 0) == 0) break; else n_sems++;
+		if (mt_sem_make(&ctx->s_crypt, 0) == 0) break; else n_sems++;
+
+		resl = ST_ERR_THREAD;
+
+		if ( (writer_ok = mt_thread_start(&writer, conv_writer, ctx)) == 0 ) {
+			break;
+		}
+		if ( (reader_ok = mt_thread_start(&reader, conv_reader, ctx)) == 0 ) {
+			break;
+		}
+		resl = ST_OK;
+
+		for (j = 0; j < ctx->n_chunks; j++)
+		{
+			mt_sem_get(&ctx->s_read);
+
+			if ( (ctx->stop != 0) || (j >= d64(ctx->n_read)) ) {
+				break;
+			}
+			buf = &ctx->buffs[j % ctx->n_buffs];
+
+			if ( (resl = buf->status) != ST_OK ) {
+				break;
+			}
+			switch (op)
+			{
+				case CONV_ENCRYPT:
+					dc_img_crypt(img, buf->data, buf->data, buf->size, buf->offset, img->d_key, 1);
+				break;
+				case CONV_REENCRYPT:
+					dc_img_crypt(img, buf->data, buf->data, buf->size, buf->offset, img->o_key, 0);
+					dc_img_crypt(img, buf->data, buf->data, buf->size, buf->offset, img->d_key, 1);
+				break;
+				case CONV_DECRYPT:
+					dc_img_crypt(img, buf->data, buf->data, buf->size, buf->offset, img->d_key, 0);
+				break;
+			}
+			lock_inc(&ctx->n_crypt);
+			mt_sem_put(&ctx->s_crypt, 1);
+			done += buf->size;
+
+			if ( (callback != NULL) && ((resl = callback(ctx->end - ctx->start, done, param)) != ST_OK) ) {
+				break;
+			}
+		}
+	} while (0);
+
+	/* writer completes all crypted buffers before exit */
+	ctx->stop = 1;
+
+	if (reader_ok != 0) {
+		mt_sem_put(&ctx->s_free, ctx->n_buffs);
+		mt_thread_join(&reader);
+	}
+	if (writer_ok != 0) {
+		mt_sem_put(&ctx->s_crypt, 1);
+		mt_thread_join(&writer);
+	}
+	if ( (resl == ST_OK) && (ctx->w_resl != ST_OK) ) {
+		resl = ctx->w_resl;
+	}
+	if (n_sems > 0) mt_sem_free(&ctx->s_free);
+	if (n_sems > 1) mt_sem_free(&ctx->s_read);
+	if (n_sems > 2) mt_sem_free(&ctx->s_crypt);
+
+	for (i = 0; i < ctx->n_buffs; i++)
+	{
+		if (ctx->buffs[i].data != NULL) {
+			zeroauto(ctx->buffs[i].data, ctx->buff_size);
+			mt_free(ctx->buffs[i].data);
+		}
+	}
+	return resl;
+}
+
+int dc_img_encrypt_init(dc_image *img, const void *pass, u32 pass_len, int cipher, u32 unit_size, u64 stor_off)
+{
+	dc_header *header = mt_alloc(sizeof(dc_header));
+	xts_key   *h_key  = mt_alloc(sizeof(xts_key));
+	u8         buff[DC_AREA_SIZE];
+	int        resl;
+
+	do
+	{
+		if ( (header == NULL) || (h_key == NULL) ) {
+			resl = ST_NOMEM; break;
+		}
+		if (unit_size == 0) unit_size = SECTOR_SIZE;
+
+		if ( (img->d_key != NULL) || !(img->o_flags & IMG_WRITE) || (cipher >= CF_CIPHERS_NUM) || (IS_INVALID_UNIT_SIZE(unit_size) != 0) ) {
+			resl = ST_ERROR; break;
+		}
+		if (stor_off == 0) {
+			stor_off = (img->dsk_size - DC_AREA_SIZE) & ~(SECTOR_SIZE - 1);
+		}
+		if ( (img->dsk_size < DC_AREA_SIZE * 2) || (stor_off % SECTOR_SIZE) ||
+			 (stor_off < DC_AREA_SIZE) || (stor_off + DC_AREA_SIZE > img->dsk_size) )
+		{
+			resl = ST_INV_DATA_SIZE; break;
+		}
+		/* create volume header as dc_encrypt_start */
+		zeroauto(header, sizeof(dc_header));
+
+		if ( (conv_random(header->salt, PKCS5_SALT_SIZE) == 0) ||
+			 (conv_random(&header->disk_id, sizeof(u32)) == 0) || (conv_random(header->key_1, DISKKEY_SIZE) == 0) )
+		{
+			resl = ST_ERROR; break;
+		}
+		header->flags    = VF_TMP_MODE;
+		header->alg_1    = cipher;
+		header->unit_size = d16(unit_size);
+		header->stor_off = stor_off;
+		header->tmp_size = DC_AREA_SIZE;
+		DC_SET_HDR_SIGN(header);
+
+		if (stor_off + DC_AREA_SIZE < img->dsk_size) {
+			/* storage inside file system, as $dcsys$ file */
+			header->flags   |= VF_STORAGE_FILE;
+			header->use_size = img->dsk_size;
+		} else {
+			/* storage at end of image, as dc_format_start */
+			header->use_size = stor_off;
+		}
+		conv_hdr_key(h_key, header, cipher, pass, pass_len);
+
+		/* save old sectors to redirection area */
+		if ( (resl = dc_img_raw_io(img, buff, DC_AREA_SIZE, 0, 0)) != ST_OK ) {
+			break;
+		}
+		if ( (resl = dc_img_set_header(img, header)) != ST_OK ) {
+			break;
+		}
+		if ( (resl = dc_img_write(img, buff, DC_AREA_SIZE, 0)) != ST_OK ) {
+			break;
+		}
+		/* save initial state */
+		resl = conv_save_state(img, header, h_key, DC_AREA_SIZE);
+	} while (0);
+
+	/* prevent leaks */
+	zeroauto(buff, sizeof(buff));
+
+	if (header != NULL) {
+		zeroauto(header, sizeof(dc_header));
+		mt_free(header);
+	}
+	if (h_key != NULL) {
+		zeroauto(h_key, sizeof(xts_key));
+		mt_free(h_key);
+	}
+	return resl;
+}
+
+int dc_img_convert(
+	  dc_image *img, int op, const void *pass, u32 pass_len, int cipher,
+	  dc_conv_conf *conf, dc_img_callback callback, void *param
+	  )
+{
+	conv_ctx *ctx;
+	u8        buff[DC_AREA_SIZE];
+	int       resl;
+
+	if ( (ctx = calloc(1, sizeof(conv_ctx))) == NULL ) {
+		return ST_NOMEM;
+	}
+	ctx->img        = img;
+	ctx->header     = mt_alloc(sizeof(dc_header));
+	ctx->h_key      = mt_alloc(sizeof(xts_key));
+	ctx->buff_size  = (conf != NULL) && (conf->buff_size != 0) ? conf->buff_size : CONV_BUFSZ;
+	ctx->n_buffs    = (conf != NULL) && (conf->n_buffs != 0) ? conf->n_buffs : CONV_BUFFS;
+	ctx->n_buffs    = max(2, min(ctx->n_buffs, CONV_MAX_BUFFS));
+	ctx->checkpoint = (conf != NULL) && (conf->checkpoint != 0) ? conf->checkpoint : CONV_CHECKPOINT;
+	ctx->unit_size  = (conf != NULL) && (conf->unit_size != 0) ? conf->unit_size : SECTOR_SIZE;
+
+	do
+	{
+		if ( (ctx->header == NULL) || (ctx->h_key == NULL) ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( !(img->o_flags & IMG_WRITE) || (ctx->buff_size % SECTOR_SIZE) || (ctx->buff_size == 0) ) {
+			resl = ST_ERROR; break;
+		}
+		if ( (resl = dc_img_read_header(img, pass, pass_len, ctx->header, ctx->h_key)) != ST_OK ) {
+			break;
+		}
+		/* encrypted CD images can not be converted */
+		if (ctx->header->flags & VF_NO_REDIR) {
+			resl = ST_INV_VOLUME; break;
+		}
+		switch (op)
+		{
+			case CONV_ENCRYPT:
+				{
+					if ( !(ctx->header->flags & VF_TMP_MODE) ) {
+						resl = ST_ENCRYPTED; break;
+					}
+					if (ctx->header->flags & VF_REENCRYPT) {
+						resl = ST_ERROR; break;
+					}
+				}
+			break;
+			case CONV_REENCRYPT:
+				{
+					if ( (ctx->header->flags & VF_TMP_MODE) && !(ctx->header->flags & VF_REENCRYPT) ) {
+						resl = ST_ERROR; break;
+					}
+					if (ctx->header->flags & VF_REENCRYPT) {
+						break;
+					}
+					if ( (cipher >= CF_CIPHERS_NUM) || (IS_INVALID_UNIT_SIZE(ctx->unit_size) != 0) ) {
+						resl = ST_ERROR; break;
+					}
+					/* start re-encryption as dc_reencrypt_start */
+					autocpy(ctx->header->key_2, ctx->header->key_1, DISKKEY_SIZE);
+
+					if ( (conv_random(ctx->header->salt, PKCS5_SALT_SIZE) == 0) ||
+						 (conv_random(ctx->header->key_1, DISKKEY_SIZE) == 0) )
+					{
+						resl = ST_ERROR; break;
+					}
+					ctx->header->alg_2  = ctx->header->alg_1;
+					ctx->header->alg_1  = cipher;
+					ctx->header->unit_size_2 = d16(DC_UNIT_SIZE(ctx->header, unit_size));
+					ctx->header->unit_size   = d16(ctx->unit_size);
+					ctx->header->flags |= VF_TMP_MODE | VF_REENCRYPT;
+					DC_SET_HDR_SIGN(ctx->header);
+
+					conv_hdr_key(ctx->h_key, ctx->header, cipher, pass, pass_len);
+
+					/* header sectors are not re-encrypted, they rewritten with new header */
+					resl = conv_save_state(img, ctx->header, ctx->h_key, DC_AREA_SIZE);
+				}
+			break;
+			case CONV_DECRYPT:
+				{
+					if (ctx->header->flags & VF_REENCRYPT) {
+						resl = ST_ERROR; break;
+					}
+					if ( !(ctx->header->flags & VF_TMP_MODE) ) {
+						/* start decryption as dc_decrypt_start */
+						ctx->header->flags |= VF_TMP_MODE;
+						resl = conv_save_state(img, ctx->header, ctx->h_key, img->dsk_size);
+					}
+				}
+			break;
+			default: resl = ST_ERROR;
+		}
+		if (resl != ST_OK) {
+			break;
+		}
+		if ( (resl = dc_img_set_header(img, ctx->header)) != ST_OK ) {
+			break;
+		}
+		if (op == CONV_DECRYPT) {
+			ctx->start    = DC_AREA_SIZE;
+			ctx->end      = img->tmp_size;
+			ctx->backward = 1;
+		} else {
+			ctx->start = img->tmp_size;
+			ctx->end   = img->dsk_size;
+		}
+		if ( (resl = conv_run(ctx, op, callback, param)) != ST_OK )
+		{
+			/* save progress to continue later */
+			conv_save_state(img, ctx->header, ctx->h_key, ctx->tmp_size);
+			break;
+		}
+		if (op == CONV_DECRYPT)
+		{
+			/* write redirected part back to zero offset, this removes volume header */
+			ctx->header->tmp_size = DC_AREA_SIZE;
+
+			if ( (resl = dc_img_set_header(img, ctx->header)) != ST_OK ) {
+				break;
+			}
+			if ( (resl = dc_img_read(img, buff, DC_AREA_SIZE, 0)) != ST_OK ) {
+				break;
+			}
+			if ( (resl = dc_img_raw_io(img, buff, DC_AREA_SIZE, 0, 1)) == ST_OK ) {
+				resl = dc_img_flush(img);
+			}
+		} else
+		{
+			/* finish as dc_save_enc_state */
+			ctx->header->flags      &= ~(VF_TMP_MODE | VF_REENCRYPT);
+			ctx->header->tmp_wp_mode = 0;
+
+			if (op == CONV_REENCRYPT) {
+				zeroauto(ctx->header->key_2, DISKKEY_SIZE);
+				ctx->header->alg_2 = 0;
+				ctx->header->unit_size_2 = 0;
+			}
+			DC_SET_HDR_SIGN(ctx->header);
+
+			if ( (resl = conv_save_state(img, ctx->header, ctx->h_key, 0)) == ST_OK ) {
+				resl = dc_img_set_header(img, ctx->header);
+			}
+		}
+	} while (0);
+
+	/* prevent leaks */
+	zeroauto(buff, sizeof(buff));
+
+	if (ctx->header != NULL) {
+		zeroauto(ctx->header, sizeof(dc_header));
+		mt_free(ctx->header);
+	}
+	if (ctx->h_key != NULL) {
+		zeroauto(ctx->h_key, sizeof(xts_key));
+		mt_free(ctx->h_key);
+	}
+	free(ctx);
+
+	return resl;
+}
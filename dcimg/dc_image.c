@@ -0,0 +1,627 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef CRYPTO_PORTABLE
+ #include <stdlib.h>
+ #include <unistd.h>
+ #include <fcntl.h>
+ #include <sys/stat.h>
+#else
+ #include <windows.h>
+ #include <winioctl.h>
+#endif
+#include "defines.h"
+#include "dcconst.h"
+#include "volume.h"
+#include "pkcs5.h"
+#include "crc32.h"
+#include "dc_image.h"
+
+static u32 intersect(u64 *i_st, u64 start1, u32 size1, u64 start2, u64 size2)
+{
+	u64 end, i;
+	end = min(start1 + size1, start2 + size2);
+	*i_st = i = max(start1, start2);
+	return d32((i < end) ? end - i : 0);
+}
+
+#ifdef CRYPTO_PORTABLE
+
+static int img_file_open(dc_image *img, const char *path)
+{
+	struct stat st;
+
+	if ( (img->fd = open(path, (img->o_flags & IMG_WRITE) ? O_RDWR : O_RDONLY)) == -1 ) {
+		return ST_NO_OPEN_FILE;
+	}
+	if (fstat(img->fd, &st) != 0) {
+		return ST_IO_ERROR;
+	}
+	/* block devices report zero size in stat */
+	if (S_ISBLK(st.st_mode) != 0) {
+		img->dsk_size = d64(lseek(img->fd, 0, SEEK_END));
+	} else {
+		img->dsk_size = d64(st.st_size);
+	}
+	return ST_OK;
+}
+
+static void img_file_close(dc_image *img)
+{
+	if (img->fd != -1) close(img->fd);
+}
+
+int dc_img_flush(dc_image *img)
+{
+	return fsync(img->fd) == 0 ? ST_OK : ST_IO_ERROR;
+}
+
+int dc_img_raw_io(dc_image *img, void *buff, u32 size, u64 offset, int write)
+{
+	ssize_t bytes;
+
+	for (; size != 0; size -= d32(bytes), offset += bytes, buff = p8(buff) + bytes)
+	{
+		if (write != 0) {
+			bytes = pwrite(img->fd, buff, size, offset);
+		} else {
+			bytes = pread(img->fd, buff, size, offset);
+		}
+		if (bytes <= 0) return ST_IO_ERROR;
+	}
+	return ST_OK;
+}
+
+#else
+
+static int img_file_open(dc_image *img, const char *path)
+{
+	GET_LENGTH_INFORMATION info;
+	u32                    bytes;
+
+	img->h_file = CreateFileA(
+		path, GENERIC_READ | ((img->o_flags & IMG_WRITE) ? GENERIC_WRITE : 0),
+		FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+
+	if (img->h_file == INVALID_HANDLE_VALUE) {
+		return ST_NO_OPEN_FILE;
+	}
+	if (GetFileSizeEx(img->h_file, pv(&img->dsk_size)) != 0) {
+		return ST_OK;
+	}
+	/* raw devices does not support GetFileSizeEx */
+	if (DeviceIoControl(img->h_file, IOCTL_DISK_GET_LENGTH_INFO, NULL, 0, &info, sizeof(info), &bytes, NULL) == 0) {
+		return ST_IO_ERROR;
+	}
+	img->dsk_size = info.Length.QuadPart;
+	return ST_OK;
+}
+
+static void img_file_close(dc_image *img)
+{
+	if (img->h_file != INVALID_HANDLE_VALUE) CloseHandle(img->h_file);
+}
+
+int dc_img_flush(dc_image *img)
+{
+	return FlushFileBuffers(img->h_file) != 0 ? ST_OK : ST_IO_ERROR;
+}
+
+int dc_img_raw_io(dc_image *img, void *buff, u32 size, u64 offset, int write)
+{
+	OVERLAPPED ovl;
+	u32        bytes;
+	BOOL       succs;
+
+	for (; size != 0; size -= bytes, offset += bytes, buff = p8(buff) + bytes)
+	{
+		zeroauto(&ovl, sizeof(ovl));
+		ovl.Offset     = d32(offset);
+		ovl.OffsetHigh = d32(offset >> 32);
+
+		if (write != 0) {
+			succs = WriteFile(img->h_file, buff, size, &bytes, &ovl);
+		} else {
+			succs = ReadFile(img->h_file, buff, size, &bytes, &ovl);
+		}
+		if ( (succs == FALSE) || (bytes == 0) ) return ST_IO_ERROR;
+	}
+	return ST_OK;
+}
+
+#endif /* CRYPTO_PORTABLE */
+
+static void img_crypt_slices(dc_image *img)
+{
+	u32 i, offs, size;
+
+	while ( (i = d32(lock_inc(&img->next) - 1)) < img->j_count )
+	{
+		offs = i * img->j_slice;
+		size = min(img->j_slice, img->j_size - offs);
+
+		if (img->j_encrypt != 0) {
+			xts_encrypt(img->j_src + offs, img->j_dst + offs, size, img->j_offset + offs, img->j_key);
+		} else {
+			xts_decrypt(img->j_src + offs, img->j_dst + offs, size, img->j_offset + offs, img->j_key);
+		}
+	}
+}
+
+static MT_THREAD_PROC(img_crypt_thread)
+{
+	dc_image *img = param;
+
+	for (;;)
+	{
+		mt_sem_get(&img->s_work);
+
+		if (img->stop != 0) {
+			break;
+		}
+		img_crypt_slices(img);
+		mt_sem_put(&img->s_done, 1);
+	}
+	MT_THREAD_RET;
+}
+
+/* split large requests between crypto threads, calling thread also takes slices */
+void dc_img_crypt(dc_image *img, const u8 *src, u8 *dst, u32 size, u64 offset, xts_key *key, int encrypt)
+{
+	u32 n_help, i;
+
+	if ( (img->n_threads == 0) || (size < DC_IMG_MT_SIZE * 2) )
+	{
+		if (encrypt != 0) {
+			xts_encrypt(src, dst, size, offset, key);
+		} else {
+			xts_decrypt(src, dst, size, offset, key);
+		}
+		return;
+	}
+	img->j_src     = src;
+	img->j_dst     = dst;
+	img->j_size    = size;
+	img->j_offset  = offset;
+	img->j_key     = key;
+	img->j_encrypt = encrypt;
+	img->j_slice   = _align(size / min(img->n_threads + 1, size / DC_IMG_MT_SIZE), SECTOR_SIZE);
+	img->j_count   = (size + img->j_slice - 1) / img->j_slice;
+	img->next      = 0;
+	n_help         = min(img->n_threads, img->j_count - 1);
+
+	mt_sem_put(&img->s_work, n_help);
+	img_crypt_slices(img);
+
+	for (i = 0; i < n_help; i++) {
+		mt_sem_get(&img->s_done);
+	}
+}
+
+/* [offset] - physical offset, [tweak] - volume offset used as XTS tweak */
+static int img_crypt_io(dc_image *img, u8 *buff, u32 size, u64 offset, u64 tweak, xts_key *key, int write)
+{
+	u32 block;
+	int resl;
+
+	if (write == 0)
+	{
+		if ( (resl = dc_img_raw_io(img, buff, size, offset, 0)) == ST_OK && (key != NULL) ) {
+			dc_img_crypt(img, buff, buff, size, tweak, key, 0);
+		}
+		return resl;
+	}
+	if (key == NULL) {
+		return dc_img_raw_io(img, buff, size, offset, 1);
+	}
+	/* encrypt to bounce buffer to keep caller data unchanged */
+	for (resl = ST_OK; (size != 0) && (resl == ST_OK); size -= block)
+	{
+		block = min(size, DC_IMG_EXPORT_SIZE);
+		dc_img_crypt(img, buff, img->w_buff, block, tweak, key, 1);
+		resl = dc_img_raw_io(img, img->w_buff, block, offset, 1);
+
+		buff += block; offset += block; tweak += block;
+	}
+	return resl;
+}
+
+/* same volume layout as in dc_sync_encrypted_io */
+static int img_io(dc_image *img, u8 *buff, u32 size, u64 offset, int write)
+{
+	u64 o1, o2, o3;
+	u32 s1, s2, s3;
+	u8 *p2, *p3;
+	int resl = ST_OK;
+
+	if (img->flags & VF_NO_REDIR) {
+		/* volume data is placed at [stor_off], tweak is not shifted */
+		return img_crypt_io(img, buff, size, img->stor_off + offset, offset, img->d_key, write);
+	}
+	s1 = intersect(&o1, offset, size, 0, DC_AREA_SIZE);
+
+	if (img->flags & VF_TMP_MODE) {
+		s2 = intersect(&o2, offset, size, DC_AREA_SIZE, (img->tmp_size - DC_AREA_SIZE));
+		s3 = intersect(&o3, offset, size, img->tmp_size, img->dsk_size);
+	} else {
+		s2 = intersect(&o2, offset, size, DC_AREA_SIZE, img->dsk_size);
+		s3 = 0;
+	}
+	p2 = buff + s1;
+	p3 = p2 + s2;
+
+	/*
+	   normal mode:
+	    o1:s1 - redirected part
+	    o2:s2 - encrypted part
+	    o3:s3 - unencrypted part
+	   reencrypt mode:
+	    o1:s1 - redirected part
+	    o2:s2 - key_1 encrypted part
+	    o3:s3 - key_2 encrypted part
+	*/
+	do
+	{
+		if ( (s1 != 0) && (resl = img_io(img, buff, s1, img->stor_off + o1, write)) != ST_OK ) {
+			break;
+		}
+		if ( (s2 != 0) && (resl = img_crypt_io(img, p2, s2, o2, o2, img->d_key, write)) != ST_OK ) {
+			break;
+		}
+		if (s3 != 0) {
+			resl = img_crypt_io(img, p3, s3, o3, o3, (img->flags & VF_REENCRYPT) ? img->o_key : NULL, write);
+		}
+	} while (0);
+
+	return resl;
+}
+
+static xts_key *img_key_alloc(const u8 *key, int alg, u32 unit_size)
+{
+	xts_key *skey;
+
+	if ( (skey = mt_alloc(xts_key_size(alg))) != NULL ) {
+		xts_set_key(key, alg, skey);
+		xts_set_unit(skey, unit_size);
+	}
+	return skey;
+}
+
+/* size is allocated size, skey->size of key used with several ciphers is size of last cipher */
+static void img_key_free(xts_key *skey, u32 size)
+{
+	if (skey != NULL) {
+		zeroauto(skey, size);
+		mt_free(skey);
+	}
+}
+
+int dc_img_open(dc_image **out, const char *path, u32 o_flags, u32 n_threads)
+{
+	dc_image *img;
+	int       resl;
+
+	if ( (img = calloc(1, sizeof(dc_image))) == NULL ) {
+		return ST_NOMEM;
+	}
+#ifdef CRYPTO_PORTABLE
+	img->fd = -1;
+#else
+	img->h_file = INVALID_HANDLE_VALUE;
+#endif
+	img->o_flags = o_flags;
+
+	do
+	{
+		if ( (resl = img_file_open(img, path)) != ST_OK ) {
+			break;
+		}
+		if ( (o_flags & IMG_WRITE) && (img->w_buff = mt_alloc(DC_IMG_EXPORT_SIZE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if (n_threads == 0) {
+			n_threads = mt_cpu_count();
+		}
+		n_threads = max(1, min(n_threads, DC_IMG_MAX_THREADS));
+
+		if (mt_sem_make(&img->s_work, 0) == 0) {
+			resl = ST_NOMEM; break;
+		}
+		if (mt_sem_make(&img->s_done, 0) == 0) {
+			mt_sem_free(&img->s_work); resl = ST_NOMEM; break;
+		}
+		/* calling thread is also used for crypt */
+		for (img->n_threads = 0; img->n_threads < n_threads - 1; img->n_threads++) {
+			if (mt_thread_start(&img->threads[img->n_threads], img_crypt_thread, img) == 0) break;
+		}
+		xts_init(1);
+		resl = ST_OK;
+	} while (0);
+
+	if (resl == ST_OK) {
+		out[0] = img;
+	} else
+	{
+		if (img->w_buff != NULL) mt_free(img->w_buff);
+		img_file_close(img);
+		free(img);
+	}
+	return resl;
+}
+
+void dc_img_close(dc_image *img)
+{
+	u32 i;
+
+	img->stop = 1;
+	mt_sem_put(&img->s_work, img->n_threads);
+
+	for (i = 0; i < img->n_threads; i++) {
+		mt_thread_join(&img->threads[i]);
+	}
+	mt_sem_free(&img->s_work);
+	mt_sem_free(&img->s_done);
+
+	img_key_free(img->d_key, xts_key_size(img->alg_1));
+	img_key_free(img->o_key, xts_key_size(img->alg_2));
+
+	if (img->w_buff != NULL) {
+		zeroauto(img->w_buff, DC_IMG_EXPORT_SIZE);
+		mt_free(img->w_buff);
+	}
+	img_file_close(img);
+	free(img);
+}
+
+int dc_img_read_header(dc_image *img, const void *pass, u32 pass_len, dc_header *header, xts_key *h_key)
+{
+	dc_header *hcopy;
+	u8         dk[DISKKEY_SIZE];
+	int        i, resl;
+
+	if ( (hcopy = mt_alloc(sizeof(dc_header))) == NULL ) {
+		return ST_NOMEM;
+	}
+	do
+	{
+		if ( (img->dsk_size < sizeof(dc_header)) || (dc_img_raw_io(img, header, sizeof(dc_header), 0, 0) != ST_OK) ) {
+			resl = ST_RW_ERR; break;
+		}
+		sha512_pkcs5_2(
+			1000, pass, pass_len, pv(header->salt), PKCS5_SALT_SIZE, pv(dk), PKCS_DERIVE_MAX);
+
+		for (i = 0, resl = ST_PASS_ERR; i < CF_CIPHERS_NUM; i++)
+		{
+			xts_set_key(dk, i, h_key);
+			xts_decrypt(pv(header), pv(hcopy), sizeof(dc_header), 0, h_key);
+
+			if ( (IS_VALID_VOLM_SIGN(hcopy) != 0) &&
+				 (hcopy->hdr_crc == crc32(pv(&hcopy->version), DC_CRC_AREA_SIZE)) )
+			{
+				/* copy decrypted part to output */
+				autocpy(&header->sign, &hcopy->sign, DC_ENCRYPTEDDATASIZE);
+				resl = ST_OK; break;
+			}
+		}
+	} while (0);
+
+	/* prevent leaks */
+	zeroauto(dk, sizeof(dk));
+	zeroauto(hcopy, sizeof(dc_header));
+	mt_free(hcopy);
+
+	return resl;
+}
+
+int dc_img_write_header(dc_image *img, dc_header *header, xts_key *h_key)
+{
+	dc_header *hcopy;
+	int        resl;
+
+	if ( (hcopy = mt_alloc(sizeof(dc_header))) == NULL ) {
+		return ST_NOMEM;
+	}
+	header->hdr_crc = crc32(pv(&header->version), DC_CRC_AREA_SIZE);
+
+	/* encrypt volume header and restore salt */
+	xts_encrypt(pv(header), pv(hcopy), sizeof(dc_header), 0, h_key);
+	autocpy(hcopy->salt, header->salt, PKCS5_SALT_SIZE);
+
+	resl = dc_img_raw_io(img, hcopy, sizeof(dc_header), 0, 1);
+
+	mt_free(hcopy);
+	return resl;
+}
+
+int dc_img_set_header(dc_image *img, const dc_header *header)
+{
+	xts_key *d_key, *o_key = NULL;
+
+	/* same checks as in dc_mount_device */
+	if ( (IS_INVALID_VOL_FLAGS(header->flags) != 0) ||
+		 (header->stor_off == 0) || (header->stor_off % SECTOR_SIZE) ||
+		 (header->alg_1 >= CF_CIPHERS_NUM) || (header->alg_2 >= CF_CIPHERS_NUM) ||
+		 ( (header->flags & VF_TMP_MODE) && (header->tmp_size < DC_AREA_SIZE) ) ||
+		 (header->version > DC_HDR_VERSION) || (IS_INVALID_UNIT_SIZE(DC_UNIT_SIZE(header, unit_size)) != 0) ||
+		 ( (header->flags & VF_REENCRYPT) && (IS_INVALID_UNIT_SIZE(DC_UNIT_SIZE(header, unit_size_2)) != 0) ) )
+	{
+		return ST_INV_VOLUME;
+	}
+	if ( (d_key = img_key_alloc(header->key_1, header->alg_1, DC_UNIT_SIZE(header, unit_size))) == NULL ) {
+		return ST_NOMEM;
+	}
+	if ( (header->flags & VF_REENCRYPT) &&
+		 (o_key = img_key_alloc(header->key_2, header->alg_2, DC_UNIT_SIZE(header, unit_size_2))) == NULL ) {
+		img_key_free(d_key, xts_key_size(header->alg_1)); return ST_NOMEM;
+	}
+	img_key_free(img->d_key, xts_key_size(img->alg_1));
+	img_key_free(img->o_key, xts_key_size(img->alg_2));
+
+	img->d_key    = d_key;
+	img->o_key    = o_key;
+	img->flags    = header->flags;
+	img->disk_id  = header->disk_id;
+	img->version  = header->version;
+	img->alg_1    = header->alg_1;
+	img->alg_2    = header->alg_2;
+	img->unit_1   = DC_UNIT_SIZE(header, unit_size);
+	img->unit_2   = (header->flags & VF_REENCRYPT) ? DC_UNIT_SIZE(header, unit_size_2) : 0;
+	img->stor_off = header->stor_off;
+	img->use_size = min(header->use_size, img->dsk_size);
+	img->tmp_size = (header->flags & VF_TMP_MODE) ? header->tmp_size : 0;
+
+	if ( (header->flags & VF_NO_REDIR) && (img->stor_off + img->use_size > img->dsk_size) ) {
+		img->use_size -= min(img->stor_off, img->use_size);
+	}
+	return ST_OK;
+}
+
+int dc_img_mount(dc_image *img, const void *pass, u32 pass_len)
+{
+	dc_header *header = mt_alloc(sizeof(dc_header));
+	xts_key   *h_key  = mt_alloc(sizeof(xts_key));
+	int        resl;
+
+	do
+	{
+		if ( (header == NULL) || (h_key == NULL) ) {
+			resl = ST_NOMEM; break;
+		}
+		if (img->d_key != NULL) {
+			resl = ST_ALR_MOUNT; break;
+		}
+		if ( (resl = dc_img_read_header(img, pass, pass_len, header, h_key)) != ST_OK ) {
+			break;
+		}
+		resl = dc_img_set_header(img, header);
+	} while (0);
+
+	if (header != NULL) {
+		zeroauto(header, sizeof(dc_header));
+		mt_free(header);
+	}
+	img_key_free(h_key, sizeof(xts_key));
+
+	return resl;
+}
+
+static int img_check_io(dc_image *img, u32 size, u64 offset)
+{
+	if (img->d_key == NULL) {
+		return ST_NO_MOUNT;
+	}
+	if ( (size % SECTOR_SIZE) || (offset % SECTOR_SIZE) || (offset + size > img->use_size) ) {
+		return ST_INV_DATA_SIZE;
+	}
+	return ST_OK;
+}
+
+int dc_img_read(dc_image *img, void *buff, u32 size, u64 offset)
+{
+	int resl;
+
+	if ( (resl = img_check_io(img, size, offset)) != ST_OK ) {
+		return resl;
+	}
+	return img_io(img, buff, size, offset, 0);
+}
+
+int dc_img_write(dc_image *img, const void *buff, u32 size, u64 offset)
+{
+	int resl;
+
+	if ( (resl = img_check_io(img, size, offset)) != ST_OK ) {
+		return resl;
+	}
+	if ( !(img->o_flags & IMG_WRITE) ||
+		 ( (img->flags & VF_STORAGE_FILE) && (offset < img->stor_off + DC_AREA_SIZE) && (offset + size > img->stor_off) ) )
+	{
+		return ST_ACCESS_DENIED;
+	}
+	/* buffer is not modified on write */
+	return img_io(img, pv(buff), size, offset, 1);
+}
+
+int dc_img_export(dc_image *img, const char *path, dc_img_callback callback, void *param)
+{
+	u8 *buff   = NULL;
+	u64 offset = 0;
+	u32 size;
+	int resl;
+#ifdef CRYPTO_PORTABLE
+	int fd = -1;
+#else
+	HANDLE h_file = INVALID_HANDLE_VALUE;
+	u32    bytes;
+#endif
+
+	do
+	{
+		if (img->d_key == NULL) {
+			resl = ST_NO_MOUNT; break;
+		}
+		if ( (buff = mt_alloc(DC_IMG_EXPORT_SIZE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+#ifdef CRYPTO_PORTABLE
+		if ( (fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600)) == -1 ) {
+			resl = ST_NO_CREATE_FILE; break;
+		}
+#else
+		if ( (h_file = CreateFileA(path, GENERIC_WRITE, 0, NULL, CREATE_NEW, 0, NULL)) == INVALID_HANDLE_VALUE ) {
+			resl = ST_NO_CREATE_FILE; break;
+		}
+#endif
+		for (resl = ST_OK; (offset < img->use_size) && (resl == ST_OK); offset += size)
+		{
+			size = d32(min(img->use_size - offset, DC_IMG_EXPORT_SIZE));
+
+			/* volume size may be not aligned to sector size (encrypted ISO) */
+			if ( (resl = img_io(img, buff, _align(size, SECTOR_SIZE), offset, 0)) != ST_OK ) {
+				break;
+			}
+#ifdef CRYPTO_PORTABLE
+			if (write(fd, buff, size) != size) resl = ST_IO_ERROR;
+#else
+			if ( (WriteFile(h_file, buff, size, &bytes, NULL) == 0) || (bytes != size) ) resl = ST_IO_ERROR;
+#endif
+			if ( (resl == ST_OK) && (callback != NULL) ) {
+				resl = callback(img->use_size, offset + size, param);
+			}
+		}
+	} while (0);
+
+	if (buff != NULL) {
+		zeroauto(buff, DC_IMG_EXPORT_SIZE);
+		mt_free(buff);
+	}
+#ifdef CRYPTO_PORTABLE
+	if (fd != -1) {
+		close(fd);
+		if (resl != ST_OK) unlink(path);
+	}
+#else
+	if (h_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(h_file);
+		if (resl != ST_OK) DeleteFileA(path);
+	}
+#endif
+	return resl;
+}
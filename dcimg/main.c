@@ -0,0 +1,334 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#ifdef CRYPTO_PORTABLE
+ #include <strings.h>
+ #define _stricmp strcasecmp
+#else
+ #include <windows.h>
+#endif
+#include "defines.h"
+#include "dcconst.h"
+#include "dc_image.h"
+#include "dc_convert.h"
+
+static int    g_argc;
+static char **g_argv;
+static volatile int g_cancel;
+
+static const char *cipher_names[] = {
+	"AES", "Twofish", "Serpent", "AES-Twofish", "Twofish-Serpent", "Serpent-AES", "AES-Twofish-Serpent"
+};
+
+static void print_usage()
+{
+	printf(
+		"dcimg <command> <image> [params]\n\n"
+		"  commands:\n"
+		"    -info   <image>                   print volume information\n"
+		"    -read   <image> <file>            write decrypted range to file\n"
+		"        -o [offset] -s [size]          range in bytes, multiple of 512\n"
+		"    -write  <image> <file>            write file to volume at offset\n"
+		"        -o [offset]\n"
+		"    -export <image> <file>            write whole decrypted volume to new file\n"
+		"    -encrypt   <image>                encrypt image or continue encryption\n"
+		"        -new -c [cipher]               create volume header on unencrypted image\n"
+		"        -storage [offset]              redirection area offset, default - end of image\n"
+		"    -reencrypt <image> -c [cipher]    change volume cipher and key\n"
+		"    -decrypt   <image>                decrypt image or continue decryption\n"
+		"  params:\n"
+		"    -p [password]                     password, asked if not specified\n"
+		"    -t [threads]                      number of crypto threads, 0 - all processors\n"
+		"    -b [size]                         conversion buffer size in KB\n"
+		"    -u [size]                         XTS data unit of new key, 512 or 4096 bytes\n"
+		"  conversion progress is saved periodically, Ctrl+C stops it safely\n"
+		"  <image> is a volume image or raw block device\n"
+		);
+}
+
+static int is_param(const char *name)
+{
+	int i;
+
+	for (i = 0; i < g_argc; i++) {
+		if (strcmp(g_argv[i], name) == 0) return 1;
+	}
+	return 0;
+}
+
+static char *get_param(const char *name)
+{
+	int i;
+
+	for (i = 0; i < g_argc - 1; i++) {
+		if (strcmp(g_argv[i], name) == 0) return g_argv[i + 1];
+	}
+	return NULL;
+}
+
+/* convert password to UTF-16LE, windows components hash password in this form */
+static u32 make_pass(const char *str, u8 *out)
+{
+	u32 ch, len = 0;
+#ifdef CRYPTO_PORTABLE
+	const u8 *p = pv(str);
+	int       n;
+
+	while ( (*p != 0) && (len < MAX_PASSWORD * 2) )
+	{
+		if (p[0] < 0x80) { ch = p[0]; n = 0; } else
+		if ((p[0] & 0xE0) == 0xC0) { ch = p[0] & 0x1F; n = 1; } else
+		if ((p[0] & 0xF0) == 0xE0) { ch = p[0] & 0x0F; n = 2; } else { ch = p[0] & 0x07; n = 3; }
+
+		for (p++; (n != 0) && ((*p & 0xC0) == 0x80); n--, p++) {
+			ch = (ch << 6) | (*p & 0x3F);
+		}
+		if (ch >= 0x10000) {
+			ch -= 0x10000;
+			out[len++] = d8(0xD800 + (ch >> 10)); out[len++] = d8((0xD800 + (ch >> 10)) >> 8);
+			ch = 0xDC00 + (ch & 0x3FF);
+		}
+		out[len++] = d8(ch); out[len++] = d8(ch >> 8);
+	}
+#else
+	wchar_t pass[MAX_PASSWORD + 1];
+	int     n = MultiByteToWideChar(CP_ACP, 0, str, -1, pass, MAX_PASSWORD + 1);
+
+	for (ch = 0; (n > 1) && (ch < d32(n - 1)); ch++) {
+		out[len++] = d8(pass[ch]); out[len++] = d8(pass[ch] >> 8);
+	}
+	zeroauto(pass, sizeof(pass));
+#endif
+	return min(len, MAX_PASSWORD * 2);
+}
+
+static int export_callback(u64 total, u64 done, void *param)
+{
+	fprintf(stderr, "\rexported %llu of %llu MB",
+		(unsigned long long)(done >> 20), (unsigned long long)(total >> 20));
+	return ST_OK;
+}
+
+static int convert_callback(u64 total, u64 done, void *param)
+{
+	fprintf(stderr, "\rprocessed %llu of %llu MB",
+		(unsigned long long)(done >> 20), (unsigned long long)(total >> 20));
+
+	return g_cancel != 0 ? ST_CANCEL : ST_OK;
+}
+
+static void on_interrupt(int sig)
+{
+	g_cancel = 1;
+}
+
+static int get_cipher(const char *name)
+{
+	int i;
+
+	for (i = 0; (name != NULL) && (i < array_num(cipher_names)); i++) {
+		if (_stricmp(cipher_names[i], name) == 0) return i;
+	}
+	return -1;
+}
+
+static int img_convert(dc_image *img, const char *cmd, const u8 *pass, u32 pass_len)
+{
+	dc_conv_conf conf;
+	char        *p;
+	int          op, cipher = get_cipher(get_param("-c"));
+	int          resl;
+
+	if (strcmp(cmd, "-encrypt") == 0) op = CONV_ENCRYPT; else
+	if (strcmp(cmd, "-reencrypt") == 0) op = CONV_REENCRYPT; else op = CONV_DECRYPT;
+
+	if ( ((op == CONV_REENCRYPT) || (is_param("-new") != 0)) && (cipher < 0) ) {
+		fprintf(stderr, "Invalid cipher\n"); return ST_ERROR;
+	}
+	memset(&conf, 0, sizeof(conf));
+	conf.buff_size = (p = get_param("-b")) != NULL ? atoi(p) * 1024 : 0;
+	conf.unit_size = (p = get_param("-u")) != NULL ? atoi(p) : 0;
+
+	if ( (conf.unit_size != 0) && (IS_INVALID_UNIT_SIZE(conf.unit_size) != 0) ) {
+		fprintf(stderr, "Invalid data unit size\n"); return ST_ERROR;
+	}
+	if (is_param("-new") != 0)
+	{
+		resl = dc_img_encrypt_init(
+			img, pass, pass_len, cipher, conf.unit_size, (p = get_param("-storage")) != NULL ? strtoull(p, NULL, 0) : 0);
+
+		if (resl != ST_OK) {
+			return resl;
+		}
+	}
+	signal(SIGINT, on_interrupt);
+
+	resl = dc_img_convert(img, op, pass, pass_len, cipher, &conf, convert_callback, NULL);
+	fprintf(stderr, "\n");
+
+	if (resl == ST_CANCEL) {
+		fprintf(stderr, "Stopped, progress saved\n");
+	}
+	return resl;
+}
+
+static int img_info(dc_image *img)
+{
+	printf(
+		"volume version:  %d\n"
+		"disk id:         %08x\n"
+		"cipher:          %s\n"
+		"data unit:       %u\n"
+		"flags:           %08x\n"
+		"device size:     %llu\n"
+		"volume size:     %llu\n"
+		"%-17s%llu\n",
+		img->version, img->disk_id, cipher_names[img->alg_1], img->unit_1, img->flags,
+		(unsigned long long)img->dsk_size, (unsigned long long)img->use_size,
+		(img->flags & VF_NO_REDIR) ? "data offset:" : "redir offset:", (unsigned long long)img->stor_off);
+
+	if (img->flags & VF_TMP_MODE) {
+		printf("encrypted part:  %llu\n", (unsigned long long)img->tmp_size);
+	}
+	if (img->flags & VF_REENCRYPT) {
+		printf("old cipher:      %s\n", cipher_names[img->alg_2]);
+		printf("old data unit:   %u\n", img->unit_2);
+	}
+	return ST_OK;
+}
+
+/* copy range between volume and file with DC_IMG_EXPORT_SIZE blocks */
+static int img_copy(dc_image *img, const char *path, u64 offset, u64 size, int write)
+{
+	FILE *f;
+	u8   *buff;
+	u32   block;
+	int   resl = ST_OK;
+
+	if ( (buff = malloc(DC_IMG_EXPORT_SIZE)) == NULL ) {
+		return ST_NOMEM;
+	}
+	if ( (f = fopen(path, write != 0 ? "rb" : "wb")) == NULL ) {
+		free(buff); return write != 0 ? ST_NO_OPEN_FILE : ST_NO_CREATE_FILE;
+	}
+	for (; (size != 0) && (resl == ST_OK); size -= block, offset += block)
+	{
+		block = d32(min(size, DC_IMG_EXPORT_SIZE));
+
+		if (write != 0)
+		{
+			if ( (block = d32(fread(buff, 1, block, f))) == 0 ) {
+				break;
+			}
+			/* pad last block to sector size */
+			memset(buff + block, 0, _align(block, SECTOR_SIZE) - block);
+			block = _align(block, SECTOR_SIZE);
+			resl  = dc_img_write(img, buff, block, offset);
+		} else
+		{
+			if ( (resl = dc_img_read(img, buff, block, offset)) == ST_OK && (fwrite(buff, 1, block, f) != block) ) {
+				resl = ST_IO_ERROR;
+			}
+		}
+	}
+	zeroauto(buff, DC_IMG_EXPORT_SIZE);
+	free(buff); fclose(f);
+
+	return resl;
+}
+
+int main(int argc, char *argv[])
+{
+	dc_image *img = NULL;
+	u8        pass[MAX_PASSWORD * 2];
+	char      line[MAX_PASSWORD * 4];
+	char     *p, *cmd;
+	u32       pass_len, o_flags;
+	u64       offset, size;
+	int       convert, resl;
+
+	g_argc = argc; g_argv = argv;
+
+	if ( (argc < 3) || (argv[1][0] != '-') ) {
+		print_usage(); return ST_ERROR;
+	}
+	cmd     = argv[1];
+	convert = (strcmp(cmd, "-encrypt") == 0) || (strcmp(cmd, "-reencrypt") == 0) || (strcmp(cmd, "-decrypt") == 0);
+	o_flags = (convert != 0) || (strcmp(cmd, "-write") == 0) ? IMG_WRITE : 0;
+
+	do
+	{
+		resl = dc_img_open(&img, argv[2], o_flags, (p = get_param("-t")) != NULL ? atoi(p) : 0);
+
+		if (resl != ST_OK) {
+			img = NULL; break;
+		}
+		if ( (p = get_param("-p")) == NULL )
+		{
+			fprintf(stderr, "Enter password: ");
+
+			if (fgets(line, sizeof(line), stdin) == NULL) {
+				resl = ST_CANCEL; break;
+			}
+			line[strcspn(line, "\r\n")] = 0; p = line;
+		}
+		pass_len = make_pass(p, pass);
+		resl     = convert != 0 ? img_convert(img, cmd, pass, pass_len) : dc_img_mount(img, pass, pass_len);
+
+		zeroauto(pass, sizeof(pass));
+		zeroauto(line, sizeof(line));
+
+		if ( (resl != ST_OK) || (convert != 0) ) {
+			break;
+		}
+		offset = (p = get_param("-o")) != NULL ? strtoull(p, NULL, 0) : 0;
+		size   = (p = get_param("-s")) != NULL ? strtoull(p, NULL, 0) : img->use_size - min(offset, img->use_size);
+
+		if (strcmp(cmd, "-info") == 0) {
+			resl = img_info(img); break;
+		}
+		if (argc < 4) {
+			print_usage(); resl = ST_ERROR; break;
+		}
+		if (strcmp(cmd, "-read") == 0) {
+			resl = img_copy(img, argv[3], offset, size, 0); break;
+		}
+		if (strcmp(cmd, "-write") == 0) {
+			resl = img_copy(img, argv[3], offset, ~0ull, 1); break;
+		}
+		if (strcmp(cmd, "-export") == 0) {
+			resl = dc_img_export(img, argv[3], export_callback, NULL);
+			fprintf(stderr, "\n"); break;
+		}
+		print_usage(); resl = ST_ERROR;
+	} while (0);
+
+	if (img != NULL) {
+		dc_img_close(img);
+	}
+	if (resl != ST_OK) {
+		fprintf(stderr, "Error: %d\n", resl);
+	}
+	return resl;
+}
@@ -1,6 +1,6 @@
-#ifndef _MALLOC_
-#define _MALLOC_
-
-void *malloc(int size);
-
+#ifndef _MALLOC_
+#define _MALLOC_
+
+void *malloc(int size);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef _CD_PIPE_H_
+#define _CD_PIPE_H_
+
+#include "defines.h"
+#include "xts_fast.h"
+
+#define CD_PIPE_BUFSZ       (1024 * 1024) /* default buffer size            */
+#define CD_PIPE_BUFFS       8             /* default number of buffers      */
+#define CD_PIPE_MAX_BUFFS   64
+#define CD_PIPE_MAX_THREADS 32
+#define CD_PIPE_ALIGN       4096          /* buffers alignment for unbuffered I/O */
+
+typedef int (cd_callback)(u64 iso_sz, u64 enc_sz, void *param);
+
+/* positional I/O callbacks, [bytes] may be less than [size] only at end of file */
+typedef int (*cd_read_proc) (void *ctx, void *buff, u32 size, u64 offset, u32 *bytes);
+typedef int (*cd_write_proc)(void *ctx, const void *buff, u32 size, u64 offset);
+
+typedef struct _cd_pipe_conf {
+	u32 buff_size; /* size of one buffer, multiple of CD_PIPE_ALIGN, 0 - default */
+	u32 n_buffs;   /* number of buffers in flight, 0 - default                   */
+	u32 n_threads; /* number of crypto threads, 0 - number of processors         */
+
+} cd_pipe_conf;
+
+/*
+   reads [iso_sz] bytes from source, encrypts them in parallel and writes to
+   destination at [w_offset]; the data tail is padded with zeroes to CD_SECTOR_SIZE.
+   this code is platform independent for testing in user mode
+*/
+int cd_pipe_encrypt(
+	  cd_read_proc  read_p,  void *r_ctx,
+	  cd_write_proc write_p, void *w_ctx, u64 w_offset,
+	  u64 iso_sz, xts_key *v_key, cd_pipe_conf *conf, cd_callback callback, void *param
+	  );
+
+#endif
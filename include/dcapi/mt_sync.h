@@ -0,0 +1,41 @@
+#ifndef _MT_SYNC_H_
+#define _MT_SYNC_H_
+
+/* minimal threads and semaphores wrapper for platform independent user mode code */
+
+#ifdef CRYPTO_PORTABLE
+ #include <pthread.h>
+ #include <semaphore.h>
+
+ typedef pthread_t mt_thread;
+ typedef sem_t     mt_sem;
+
+ #define MT_THREAD_PROC(_name) void *_name(void *param)
+ #define MT_THREAD_RET         return NULL
+ typedef void *(*mt_thread_proc)(void *param);
+#else
+ #include <windows.h>
+
+ typedef HANDLE mt_thread;
+ typedef HANDLE mt_sem;
+
+ #define MT_THREAD_PROC(_name) DWORD WINAPI _name(void *param)
+ #define MT_THREAD_RET         return 0
+ typedef LPTHREAD_START_ROUTINE mt_thread_proc;
+#endif
+
+int  mt_sem_make(mt_sem *s, u32 count);
+void mt_sem_free(mt_sem *s);
+void mt_sem_get(mt_sem *s);
+void mt_sem_put(mt_sem *s, u32 count);
+
+int  mt_thread_start(mt_thread *t, mt_thread_proc proc, void *param);
+void mt_thread_join(mt_thread *t);
+
+/* page aligned memory for I/O buffers */
+void *mt_alloc(u32 size);
+void  mt_free(void *p);
+
+u32 mt_cpu_count();
+
+#endif
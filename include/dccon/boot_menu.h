@@ -1,6 +1,6 @@
-#ifndef _BOOT_MENU_
-#define _BOOT_MENU_
-
-int boot_menu(int argc, wchar_t *argv[]);
-
+#ifndef _BOOT_MENU_
+#define _BOOT_MENU_
+
+int boot_menu(int argc, wchar_t *argv[]);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef _DC_CONVERT_H_
+#define _DC_CONVERT_H_
+
+#include "dc_image.h"
+
+/*
+   offline encryption, re-encryption and decryption of volume images.
+   progress is saved to volume header (VF_TMP_MODE, tmp_size) in the same
+   way as driver does, so interrupted conversion can be continued here or
+   by driver after mount.
+*/
+
+#define CONV_ENCRYPT   0
+#define CONV_REENCRYPT 1
+#define CONV_DECRYPT   2
+
+#define CONV_BUFSZ      (4 * 1024 * 1024)  /* default buffer size       */
+#define CONV_BUFFS      8                  /* default number of buffers */
+#define CONV_MAX_BUFFS  64
+#define CONV_CHECKPOINT (64 * 1024 * 1024) /* default progress save interval */
+
+typedef struct _dc_conv_conf {
+	u32 buff_size;  /* size of one I/O buffer, multiple of SECTOR_SIZE, 0 - default */
+	u32 n_buffs;    /* number of buffers in flight, 0 - default                     */
+	u64 checkpoint; /* bytes processed between progress saves, 0 - default          */
+	u32 unit_size;  /* XTS data unit of new key on re-encryption, 0 - SECTOR_SIZE   */
+
+} dc_conv_conf;
+
+/*
+   create volume header on unencrypted image, [stor_off] - redirection area offset,
+   0 - last DC_AREA_SIZE bytes of image which are excluded from volume.
+   area inside image must be unused by file system (as $dcsys$ file created by driver),
+   [unit_size] - XTS data unit size, 0 - SECTOR_SIZE
+*/
+int dc_img_encrypt_init(dc_image *img, const void *pass, u32 pass_len, int cipher, u32 unit_size, u64 stor_off);
+
+/* start or continue conversion, [cipher] is used only when re-encryption started */
+int dc_img_convert(
+	  dc_image *img, int op, const void *pass, u32 pass_len, int cipher,
+	  dc_conv_conf *conf, dc_img_callback callback, void *param
+	  );
+
+#endif
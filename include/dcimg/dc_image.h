@@ -0,0 +1,90 @@
+#ifndef _DC_IMAGE_H_
+#define _DC_IMAGE_H_
+
+#include "defines.h"
+#include "volume.h"
+#include "xts_fast.h"
+#include "mt_sync.h"
+
+/*
+   offline access to volume images and raw block devices from user mode.
+   volume layout is handled the same way as in driver and bootloader:
+   redirected first DC_AREA_SIZE bytes, VF_NO_REDIR data offset and
+   partially encrypted (VF_TMP_MODE/VF_REENCRYPT) volumes.
+   image object is not thread safe, requests are parallelized internally.
+*/
+
+#define DC_IMG_MAX_THREADS 32
+#define DC_IMG_MT_SIZE     (64 * 1024)       /* minimal request size for parallel crypt */
+#define DC_IMG_EXPORT_SIZE (4 * 1024 * 1024) /* export block size */
+
+/* open flags */
+#define IMG_WRITE 0x01 /* open image for writing */
+
+typedef int (*dc_img_callback)(u64 total, u64 done, void *param);
+
+typedef struct _dc_image {
+#ifdef CRYPTO_PORTABLE
+	int           fd;
+#else
+	HANDLE        h_file;
+#endif
+	u32           o_flags;  /* open flags                      */
+	u32           flags;    /* volume flags from header (VF_*) */
+	u32           disk_id;
+	u16           version;
+	u64           dsk_size; /* size of image file or device    */
+	u64           use_size; /* size of volume data             */
+	u64           stor_off; /* redirection area or data offset */
+	u64           tmp_size; /* encrypted part of partially encrypted volume */
+	int           alg_1;
+	int           alg_2;
+	u32           unit_1;   /* XTS data unit of volume key     */
+	u32           unit_2;   /* XTS data unit of old key        */
+	xts_key      *d_key;    /* volume key                      */
+	xts_key      *o_key;    /* old volume key (VF_REENCRYPT)   */
+	u8           *w_buff;   /* bounce buffer for writes        */
+
+	/* parallel crypt */
+	u32           n_threads;
+	mt_thread     threads[DC_IMG_MAX_THREADS];
+	mt_sem        s_work;
+	mt_sem        s_done;
+	volatile int  stop;
+	volatile long next;     /* next slice of current request   */
+	const u8     *j_src;    /* current request                 */
+	u8           *j_dst;
+	u32           j_size;
+	u32           j_slice;  /* slice size                      */
+	u32           j_count;  /* number of slices                */
+	u64           j_offset;
+	xts_key      *j_key;
+	int           j_encrypt;
+
+} dc_image;
+
+/* [n_threads] - number of crypto threads, 0 - number of processors */
+int  dc_img_open(dc_image **img, const char *path, u32 o_flags, u32 n_threads);
+void dc_img_close(dc_image *img);
+
+/* [pass] is password in UTF-16LE as hashed by windows components */
+int dc_img_mount(dc_image *img, const void *pass, u32 pass_len);
+
+/* offset and size must be multiple of SECTOR_SIZE */
+int dc_img_read(dc_image *img, void *buff, u32 size, u64 offset);
+int dc_img_write(dc_image *img, const void *buff, u32 size, u64 offset);
+
+/* write decrypted volume data to new plaintext image */
+int dc_img_export(dc_image *img, const char *path, dc_img_callback callback, void *param);
+
+/* volume header access, [header] is decrypted header with original salt */
+int dc_img_read_header(dc_image *img, const void *pass, u32 pass_len, dc_header *header, xts_key *h_key);
+int dc_img_write_header(dc_image *img, dc_header *header, xts_key *h_key);
+int dc_img_set_header(dc_image *img, const dc_header *header);
+
+/* physical I/O without volume layout translation */
+int  dc_img_raw_io(dc_image *img, void *buff, u32 size, u64 offset, int write);
+int  dc_img_flush(dc_image *img);
+void dc_img_crypt(dc_image *img, const u8 *src, u8 *dst, u32 size, u64 offset, xts_key *key, int encrypt);
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef _DEFINES_GCC_H_
+#define _DEFINES_GCC_H_
+
+/*
+   GCC/Clang replacements for the MSVC specific part of defines.h,
+   used only for the portable crypto library (CRYPTO_PORTABLE build)
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef uint64_t u64;
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t  u8;
+
+typedef int64_t s64;
+typedef int32_t s32;
+typedef int16_t s16;
+typedef int8_t  s8;
+
+#define d8(_x)  ((u8)(_x))
+#define d16(_x) ((u16)(_x))
+#define d32(_x) ((u32)(_x))
+#define d64(_x) ((u64)(_x))
+#define dSZ(_x) ((size_t)(_x))
+
+typedef void (*callback)(void*);
+typedef void (*callback_ex)(void*,void*);
+
+#define BE16(x) __builtin_bswap16(x)
+#define BE32(x) __builtin_bswap32(x)
+#define BE64(x) __builtin_bswap64(x)
+
+#define ROR64(x,y) ( ((u64)(x) >> (y)) | ((u64)(x) << (64 - (y))) )
+#define ROL64(x,y) ( ((u64)(x) << (y)) | ((u64)(x) >> (64 - (y))) )
+#define ROL32(x,y) ( ((u32)(x) << (y)) | ((u32)(x) >> (32 - (y))) )
+#define ROR32(x,y) ( ((u32)(x) >> (y)) | ((u32)(x) << (32 - (y))) )
+
+#define align16 __attribute__((aligned(16)))
+#define naked   __attribute__((naked))
+
+#define _stdcall
+#define __stdcall
+#define __forceinline  inline __attribute__((always_inline))
+#define __declspec(_x)
+
+#define p8(_x)   ((u8*)(_x))
+#define p16(_x)  ((u16*)(_x))
+#define p32(_x)  ((u32*)(_x))
+#define p64(_x)  ((u64*)(_x))
+#define pv(_x)   ((void*)(_x))
+#define ppv(_x)  ((void**)(_x))
+
+#define in_reg(a,base,size)     ( (a >= base) && (a < base+size)  )
+#define is_intersect(start1, size1, start2, size2) ( max(start1, start2) < min(start1 + size1, start2 + size2) )
+#define addof(a,o)              ( pv(p8(a)+o) )
+
+#ifndef max
+ #define max(a,b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#ifndef min
+ #define min(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef _align
+ #define _align(size, align) (((size) + ((align) - 1)) & ~((align) - 1))
+#endif
+
+#ifndef PAGE_SIZE
+ #define PAGE_SIZE 0x1000
+#endif
+
+#ifndef CACHE_LINE
+ #define CACHE_LINE 64
+#endif
+
+#ifndef MAX_PATH
+ #define MAX_PATH 260
+#endif
+
+#define array_num(x) ( sizeof(x) / sizeof((x)[0]) )  /* return number of elements in array */
+
+/* secure zeroing must survive dead store elimination */
+#define zeromem(m,s)  { memset(m, 0, s); __asm__ __volatile__("" : : "r"(m) : "memory"); }
+#define zerofast(m,s) zeromem(m,s)
+#define zeroauto(m,s) zeromem(m,s)
+
+#define mincpy(a,b,c)  memcpy(pv(a), pv(b), (size_t)(c))
+#define fastcpy(a,b,c) memcpy(pv(a), pv(b), (size_t)(c))
+#define autocpy(a,b,c) memcpy(pv(a), pv(b), (size_t)(c))
+
+#define lock_inc(_x)          ( __sync_add_and_fetch(_x, 1) )
+#define lock_dec(_x)          ( __sync_sub_and_fetch(_x, 1) )
+#define lock_xchg(_p, _v)     ( __sync_lock_test_and_set(_p, _v) )
+#define lock_xchg_add(_p, _v) ( __sync_fetch_and_add(_p, _v) )
+
+#endif
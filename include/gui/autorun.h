@@ -1,12 +1,12 @@
-#ifndef _AUTORUN_
-#define _AUTORUN_
-
-int autorun_set(
-		int run
-	);
-
-int on_app_start(
-		wchar_t *cmd_line
-	);
-
+#ifndef _AUTORUN_
+#define _AUTORUN_
+
+int autorun_set(
+		int run
+	);
+
+int on_app_start(
+		wchar_t *cmd_line
+	);
+
 #endif
\ No newline at end of file
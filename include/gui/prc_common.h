@@ -1,13 +1,13 @@
-#ifndef _PRCCOMMON_
-#define _PRCCOMMON_
-
-INT_PTR
-CALLBACK
-_tab_proc(
-		HWND   hwnd,
-		UINT   message,
-		WPARAM wparam,
-		LPARAM lparam
-	);
-
+#ifndef _PRCCOMMON_
+#define _PRCCOMMON_
+
+INT_PTR
+CALLBACK
+_tab_proc(
+		HWND   hwnd,
+		UINT   message,
+		WPARAM wparam,
+		LPARAM lparam
+	);
+
 #endif
\ No newline at end of file
@@ -1,7 +1,7 @@
-#ifndef _PRCMAIN_
-#define _PRCMAIN_
-
-
-
-
+#ifndef _PRCMAIN_
+#define _PRCMAIN_
+
+
+
+
 #endif
\ No newline at end of file
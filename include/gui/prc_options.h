@@ -1,8 +1,8 @@
-#ifndef _PRCOPTIONS_
-#define _PRCOPTIONS_
-
-int _dlg_options(
-		HWND hwnd
-	);
-
+#ifndef _PRCOPTIONS_
+#define _PRCOPTIONS_
+
+int _dlg_options(
+		HWND hwnd
+	);
+
 #endif
\ No newline at end of file
@@ -1,9 +1,9 @@
-#ifndef _UIDRAW_
-#define _UIDRAW_
-
-int _draw_proc(
-		int    message,
-		LPARAM lparam
-	);
-
+#ifndef _UIDRAW_
+#define _UIDRAW_
+
+int _draw_proc(
+		int    message,
+		LPARAM lparam
+	);
+
 #endif
\ No newline at end of file
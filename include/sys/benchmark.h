@@ -1,6 +1,7 @@
-#ifndef _BENCHMARK_
-#define _BENCHMARK_
-
-int dc_k_benchmark(crypt_info *crypt, dc_bench *info);
-
+#ifndef _BENCHMARK_
+#define _BENCHMARK_
+
+int dc_k_benchmark(crypt_info *crypt, dc_bench *info);
+int dc_k_benchmark_ex(dc_bench_ctl *bctl);
+
 #endif
\ No newline at end of file
@@ -1,6 +1,6 @@
-#ifndef _BOOT_PASS_
-#define _BOOT_PASS_
-
-void dc_get_boot_pass();
-
+#ifndef _BOOT_PASS_
+#define _BOOT_PASS_
+
+void dc_get_boot_pass();
+
 #endif
\ No newline at end of file
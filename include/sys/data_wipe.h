@@ -1,31 +1,51 @@
-#ifndef _DATA_WIPE_
-#define _DATA_WIPE_
-
-#include "prng.h"
-
-typedef struct _wipe_mode {
-	int passes; /* number of wipe passes */
-	struct {
-		int type;    /* pass type      */		
-		u8  patt[3]; /* pattern data   */
-	} pass[];
-} wipe_mode;
-
-#define P_PAT   0 /* three-byte pattern   */
-#define P_RAND  1 /* random data        */
-
-typedef struct wipe_ctx {
-	xts_key   *key;
-	wipe_mode *mode;
-	void      *hook;
-	u8        *buff;
-	int        size;
-	u64        offs;
-
-} wipe_ctx;
-
-int  dc_wipe_init(wipe_ctx *ctx, void *hook, int max_size, int method, int cipher);
-int  dc_wipe_process(wipe_ctx *ctx, u64 offset, int size);
-void dc_wipe_free(wipe_ctx *ctx);
-
+#ifndef _DATA_WIPE_
+#define _DATA_WIPE_
+
+#include "prng.h"
+
+typedef struct _wipe_mode {
+	int passes; /* number of wipe passes */
+	struct {
+		int type;    /* pass type      */		
+		u8  patt[3]; /* pattern data   */
+	} pass[];
+} wipe_mode;
+
+#define P_PAT   0 /* three-byte pattern   */
+#define P_RAND  1 /* random data        */
+
+#define WP_MAX_IO     8  /* maximum number of outstanding write requests */
+#define WP_MAX_PASSES 35 /* maximum number of passes in wipe mode */
+#define WP_PATT_UNIT  (3 * 512) /* pattern period aligned to sector size */
+#define WP_PATT_SIZE  (32 * WP_PATT_UNIT) /* maximum precomputed pattern buffer size */
+
+typedef struct wipe_ctx {
+	xts_key   *key;
+	wipe_mode *mode;
+	void      *hook;
+	u8        *buff[2]; /* double buffer for random passes pipelining */
+	u8        *patt[WP_MAX_PASSES]; /* precomputed data of pattern passes */
+	u8        *p_buff;  /* memory for precomputed patterns */
+	int        r_passes; /* number of random passes */
+	u32        p_size;   /* size of each pattern buffer */
+	int        size;
+	u64        offs;
+	void      *io;      /* write requests slots */
+	/* current pass write state */
+	u8        *w_buff;
+	u32        w_size;
+	u32        w_sent;
+	u64        w_offs;
+	u32        w_wrap;  /* pattern buffer size, requests restart from buffer begin */
+	u32        w_blen;  /* maximum request size */
+	u32        w_head;
+	u32        w_tail;
+	int        w_fail;
+
+} wipe_ctx;
+
+int  dc_wipe_init(wipe_ctx *ctx, void *hook, int max_size, int method, int cipher);
+int  dc_wipe_process(wipe_ctx *ctx, u64 offset, int size);
+void dc_wipe_free(wipe_ctx *ctx);
+
 #endif
\ No newline at end of file
@@ -1,113 +1,147 @@
-#ifndef _DEVHOOK_
-#define _DEVHOOK_
-
-#include <ntdddisk.h>
-#include <ntddstor.h>
-#include <ntddvol.h>
-#include "defines.h"
-#include "xts_fast.h"
-#include "driver.h"
-#include "data_wipe.h"
-
-typedef enum _dc_pnp_state {
-
-    NotStarted = 0,         // Not started yet
-    Started,                // Device has received the START_DEVICE IRP
-    Stopped,                // Device has received the STOP_DEVICE IRP
-    Deleted                 // Device has received the REMOVE_DEVICE IRP
-
-} dc_pnp_state;
-
-
-typedef align16 struct _dev_hook
-{
-	u32            ext_type;    /* device extention type */
-	PDEVICE_OBJECT orig_dev;
-	PDEVICE_OBJECT hook_dev;
-	PDEVICE_OBJECT pdo_dev;
-	LIST_ENTRY     hooks_list;
-	IO_REMOVE_LOCK remv_lock;
-
-	wchar_t        dev_name[MAX_DEVICE + 1];
-
-	xts_key        dsk_key;
-
-	u32            flags;        /* device flags */
-	u32            mnt_flags;    /* mount flags  */
-	u32            disk_id;      /* unique volume id */
-	u16            vf_version;   /* volume format version */
-
-	KEVENT         paging_count_event;
-	LONG           paging_count;
-	
-	u32            chg_count;    /* media changes counter */
-	u32            chg_mount;    /* mount changes counter */
-	u32            chg_last_v;   /* changes counter at last IOCTL_STORAGE_CHECK_VERIFY */
-
-	u32            max_chunk;
-	int            mnt_probed;
-	int            mnt_probe_cnt;
-
-	crypt_info     crypt;
-	wipe_ctx       wp_ctx;
-
-	u8            *tmp_buff;
-	xts_key       *hdr_key;
-	xts_key       *tmp_key;
-	dc_header      tmp_header;
-
-	u64            dsk_size; /* full device size */
-	u64            use_size; /* user available part size */
-	u32            bps;      /* bytes per sector */
-
-	u64            tmp_size;	
-	u64            stor_off;
-
-	KMUTEX         busy_lock;
-	KMUTEX         key_lock;
-
-	int            sync_init_type;
-	int            sync_init_status; /* sync mode init status */
-
-	/* hook RW helper thread fields */
-	KEVENT         rw_init_event;
-	KEVENT         rw_work_event;
-	HANDLE         rw_thread;
-	LIST_ENTRY     rw_queue_head;
-	KSPIN_LOCK     rw_queue_lock;
-	
-	/* fields for synchronous requests processing */
-	LIST_ENTRY     sync_req_queue;
-	LIST_ENTRY     sync_irp_queue;
-	KSPIN_LOCK     sync_req_lock;
-	KEVENT         sync_req_event;
-	KEVENT         sync_enter_event;
-
-	dc_pnp_state   pnp_state;
-	dc_pnp_state   pnp_prev_state;
-
-} dev_hook;
-
-dev_hook *dc_find_hook(wchar_t *dev_name);
-
-void dc_insert_hook(dev_hook *hook);
-void dc_remove_hook(dev_hook *hook);
-
-void dc_reference_hook(dev_hook *hook);
-void dc_deref_hook(dev_hook *hook);
-
-dev_hook *dc_first_hook();
-dev_hook *dc_next_hook(dev_hook *hook);
-
-#define dc_set_pnp_state(_hook_, _state_) \
-	(_hook_)->pnp_prev_state = (_hook_)->pnp_state; \
-	(_hook_)->pnp_state = (_state_);
-
-#define dc_restore_pnp_state(_hook_) \
-	(_hook_)->pnp_state = (_hook_)->pnp_prev_state;
-
-void dc_init_devhook();
-
-
-
+#ifndef _DEVHOOK_
+#define _DEVHOOK_
+
+#include <ntdddisk.h>
+#include <ntddstor.h>
+#include <ntddvol.h>
+#include "defines.h"
+#include "xts_fast.h"
+#include "driver.h"
+#include "data_wipe.h"
+#include "throttle.h"
+
+typedef enum _dc_pnp_state {
+
+    NotStarted = 0,         // Not started yet
+    Started,                // Device has received the START_DEVICE IRP
+    Stopped,                // Device has received the STOP_DEVICE IRP
+    Deleted                 // Device has received the REMOVE_DEVICE IRP
+
+} dc_pnp_state;
+
+
+/*
+   fields are grouped by access pattern so that interlocked writes done
+   on every request do not invalidate cache lines read by other CPUs.
+   Device extension is aligned only to 16 bytes, so regions are separated
+   by full cache line instead of aligning them.
+*/
+#define HOOK_PAD(_n) u8 pad_##_n[CACHE_LINE]
+
+typedef align16 struct _dev_hook
+{
+	/* read-mostly fields, used on every I/O request */
+	u32            ext_type;    /* device extention type */
+	u32            flags;       /* device flags */
+	PDEVICE_OBJECT orig_dev;
+	PDEVICE_OBJECT hook_dev;
+	PDEVICE_OBJECT pdo_dev;
+	int            mnt_probed;
+	u32            max_chunk;
+
+	u64            dsk_size; /* full device size */
+	u64            use_size; /* user available part size */
+	u64            tmp_size;	
+	u64            stor_off;
+	xts_key       *tmp_key;
+	xts_key       *dsk_key;     /* allocated by xts_key_size, kept until next mount */
+
+	HOOK_PAD(0);
+	/* written by every request on any CPU */
+	IO_REMOVE_LOCK remv_lock;
+
+	HOOK_PAD(1);
+	/* request queues, written by dispatch routines and worker threads */
+	KEVENT         rw_work_event;
+	LIST_ENTRY     rw_queue_head;
+	KSPIN_LOCK     rw_queue_lock;
+	LIST_ENTRY     sync_irp_queue;
+	KSPIN_LOCK     sync_req_lock;
+	KEVENT         sync_req_event;
+
+	HOOK_PAD(2);
+	/* cold fields */
+	LIST_ENTRY     hooks_list;
+	wchar_t        dev_name[MAX_DEVICE + 1];
+
+	u32            mnt_flags;    /* mount flags  */
+	u32            disk_id;      /* unique volume id */
+	u16            vf_version;   /* volume format version */
+	u32            bps;          /* bytes per sector */
+
+	KEVENT         paging_count_event;
+	LONG           paging_count;
+	
+	u32            chg_count;    /* media changes counter */
+	u32            chg_mount;    /* mount changes counter */
+	u32            chg_last_v;   /* changes counter at last IOCTL_STORAGE_CHECK_VERIFY */
+	u32            mnt_time;     /* last mount attempt time, ms */
+	int            mnt_probe_cnt;
+
+	crypt_info     crypt;
+	wipe_ctx       wp_ctx;
+
+	u8            *tmp_buff;
+	xts_key       *hdr_key;
+	dc_header      tmp_header;
+
+	/* bad regions found during encryption/decryption */
+	dc_bad_range   bad_range[MAX_BAD_RANGES];
+	u32            bad_count;
+	u32            bad_lost;
+	KSPIN_LOCK     bad_lock;
+
+	KMUTEX         busy_lock;
+	KMUTEX         key_lock;
+
+	int            sync_init_type;
+	int            sync_init_status; /* sync mode init status */
+
+	/* hook RW helper thread fields */
+	KEVENT         rw_init_event;
+	HANDLE         rw_thread;
+	
+	/* fields for synchronous requests processing */
+	LIST_ENTRY     sync_req_queue;
+	KEVENT         sync_enter_event;
+	io_throttle    sync_thr; /* conversion speed controller */
+
+	/* autonomous conversion fields */
+	u32            sync_run;        /* RUN_XXX mode */
+	u32            sync_run_wp;     /* data wipe mode */
+	int            sync_run_stop;   /* stop request for format thread */
+	int            sync_run_status; /* last conversion status */
+	PKEVENT        sync_run_event;  /* progress notification event */
+
+	dc_pnp_state   pnp_state;
+	dc_pnp_state   pnp_prev_state;
+
+} dev_hook;
+
+dev_hook *dc_find_hook(wchar_t *dev_name);
+
+void dc_insert_hook(dev_hook *hook);
+void dc_remove_hook(dev_hook *hook);
+
+void dc_reference_hook(dev_hook *hook);
+void dc_deref_hook(dev_hook *hook);
+
+dev_hook *dc_first_hook();
+dev_hook *dc_next_hook(dev_hook *hook);
+
+/* devices state change counter for DC_CTL_ENUM */
+void dc_hooks_changed();
+u32  dc_hooks_seq();
+
+#define dc_set_pnp_state(_hook_, _state_) \
+	(_hook_)->pnp_prev_state = (_hook_)->pnp_state; \
+	(_hook_)->pnp_state = (_state_);
+
+#define dc_restore_pnp_state(_hook_) \
+	(_hook_)->pnp_state = (_hook_)->pnp_prev_state;
+
+void dc_init_devhook();
+
+
+
 #endif
\ No newline at end of file
@@ -1,158 +1,264 @@
-#ifndef _DRIVER_
-#define _DRIVER_
-
-#include "defines.h"
-#include "version.h"
-#include "volume.h"
-#include "dcconst.h"
-
-#ifdef IS_DRIVER
- #include <ntdddisk.h>
- #include <ntddstor.h>
- #include <ntddvol.h>
-#endif
-
-#define DC_GET_VERSION       CTL_CODE(FILE_DEVICE_UNKNOWN, 0,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_ADD_PASS      CTL_CODE(FILE_DEVICE_UNKNOWN, 1,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_CLEAR_PASS    CTL_CODE(FILE_DEVICE_UNKNOWN, 2,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_MOUNT         CTL_CODE(FILE_DEVICE_UNKNOWN, 3,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_MOUNT_ALL     CTL_CODE(FILE_DEVICE_UNKNOWN, 4,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_UNMOUNT       CTL_CODE(FILE_DEVICE_UNKNOWN, 5,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_STATUS        CTL_CODE(FILE_DEVICE_UNKNOWN, 7,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_ADD_SEED      CTL_CODE(FILE_DEVICE_UNKNOWN, 8,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_CHANGE_PASS   CTL_CODE(FILE_DEVICE_UNKNOWN, 9,  METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_ENCRYPT_START CTL_CODE(FILE_DEVICE_UNKNOWN, 10, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_DECRYPT_START CTL_CODE(FILE_DEVICE_UNKNOWN, 11, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_RE_ENC_START  CTL_CODE(FILE_DEVICE_UNKNOWN, 12, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_ENCRYPT_STEP  CTL_CODE(FILE_DEVICE_UNKNOWN, 13, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_DECRYPT_STEP  CTL_CODE(FILE_DEVICE_UNKNOWN, 14, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_SYNC_STATE    CTL_CODE(FILE_DEVICE_UNKNOWN, 15, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_RESOLVE       CTL_CODE(FILE_DEVICE_UNKNOWN, 16, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_GET_RAND      CTL_CODE(FILE_DEVICE_UNKNOWN, 19, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_BENCHMARK     CTL_CODE(FILE_DEVICE_UNKNOWN, 20, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_BSOD          CTL_CODE(FILE_DEVICE_UNKNOWN, 21, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_GET_CONF      CTL_CODE(FILE_DEVICE_UNKNOWN, 22, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_SET_CONF      CTL_CODE(FILE_DEVICE_UNKNOWN, 23, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_LOCK_MEM      CTL_CODE(FILE_DEVICE_UNKNOWN, 24, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_CTL_UNLOCK_MEM    CTL_CODE(FILE_DEVICE_UNKNOWN, 25, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_FORMAT_START      CTL_CODE(FILE_DEVICE_UNKNOWN, 26, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_FORMAT_STEP       CTL_CODE(FILE_DEVICE_UNKNOWN, 27, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_FORMAT_DONE       CTL_CODE(FILE_DEVICE_UNKNOWN, 28, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_BACKUP_HEADER     CTL_CODE(FILE_DEVICE_UNKNOWN, 29, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define DC_RESTORE_HEADER    CTL_CODE(FILE_DEVICE_UNKNOWN, 30, METHOD_BUFFERED, FILE_ANY_ACCESS)
-
-#define FSCTL_LOCK_VOLUME               CTL_CODE(FILE_DEVICE_FILE_SYSTEM,  6, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define FSCTL_UNLOCK_VOLUME             CTL_CODE(FILE_DEVICE_FILE_SYSTEM,  7, METHOD_BUFFERED, FILE_ANY_ACCESS)
-#define FSCTL_DISMOUNT_VOLUME           CTL_CODE(FILE_DEVICE_FILE_SYSTEM,  8, METHOD_BUFFERED, FILE_ANY_ACCESS)
-
-#define MAX_DEVICE              64 // maximum device name length
-
-#define DC_DEVICE_NAME     L"\\Device\\dcrypt"
-#define DC_LINK_NAME       L"\\DosDevices\\dcrypt"
-#define DC_WIN32_NAME      L"\\\\.\\dcrypt"
-#define DC_OLD_WIN32_NAME  L"\\\\.\\TcWde"
-
-#pragma pack (push, 1)
-
-#ifndef BOOT_LDR
-
-typedef struct _crypt_info {
-	u8 cipher_id;  /* cipher id */
-	u8 wp_mode;    /* data wipe mode (for encryption) */
-
-} crypt_info;
-
-typedef struct _dc_ioctl {
-	dc_pass    passw1;  /* password                         */
-	dc_pass    passw2;  /* new password (for changing pass) */
-	wchar_t    device[MAX_DEVICE + 1];
-	u32        flags;   /* mount/unmount flags             */
-	int        status;  /* operation status code           */
-	int        n_mount; /* number of mounted devices       */
-	crypt_info crypt;
-
-} dc_ioctl;
-
-typedef struct _dc_lock_ctl {
-	void *data;
-	u32   size;
-	int   resl;
-
-} dc_lock_ctl;
-
-typedef struct _dc_rand_ctl {
-	void *buff;
-	u32   size;
-
-} dc_rand_ctl;
-
-typedef struct _dc_backup_ctl {
-	u16        device[MAX_DEVICE + 1];
-	dc_pass    pass;
-	u8         backup[DC_AREA_SIZE];
-	int        status;
-
-} dc_backup_ctl;
-
-#define TEST_BLOCK_LEN 2048*1024 /* speed test block size */
-#define TEST_BLOCK_NUM 20        /* number of test blocks */
-
-typedef struct _dc_status {
-	u64        dsk_size;
-	u64        tmp_size;
-	u32        flags;
-	u32        mnt_flags;
-	u32        disk_id;
-	s32        paging_count;	
-	crypt_info crypt;
-	u16        vf_version;   /* volume format version */
-	wchar_t    mnt_point[MAX_PATH];
-
-} dc_status;
-
-typedef struct _dc_bench {
-	u32 data_size;
-	u64 enc_time;
-	u64 cpu_freq;
-
-} dc_bench;
-
-typedef struct _dc_conf {
-	u32 conf_flags;
-	u32 load_flags;
-
-} dc_conf;
-
-#define IS_UNMOUNTABLE(d) ( !((d)->flags & (F_SYSTEM | F_HIBERNATE)) && \
-                             ((d)->paging_count == 0) )
-
-#define IS_EQUAL_PASS(p1,p2) ( (p1 && p2) && \
-                               ((p1)->size == (p2)->size) && \
-	                             (memcmp((p1)->pass, (p2)->pass, (p1)->size) == 0) )
-
-#endif
-
-#pragma pack (pop)
-
-#define OS_UNK   0
-#define OS_WIN2K 1
-#define OS_VISTA 2
-
-#define DC_MEM_RETRY_TIME    10
-#define DC_MEM_RETRY_TIMEOUT (1000 * 30)
-
-#ifdef IS_DRIVER
- extern PDEVICE_OBJECT dc_device;
- extern PDRIVER_OBJECT dc_driver;
- extern u32            dc_os_type; 
- extern u32            dc_io_count;
- extern u32            dc_dump_disable;
- extern u32            dc_no_usb_mount;
- extern u32            dc_conf_flags;
- extern u32            dc_load_flags;
- extern u32            dc_boot_kbs;
- extern int            dc_cpu_count; 
-#endif
-
-
+#ifndef _DRIVER_
+#define _DRIVER_
+
+#include "defines.h"
+#include "version.h"
+#include "volume.h"
+#include "dcconst.h"
+
+#ifdef IS_DRIVER
+ #include <ntdddisk.h>
+ #include <ntddstor.h>
+ #include <ntddvol.h>
+#endif
+
+#define DC_GET_VERSION       CTL_CODE(FILE_DEVICE_UNKNOWN, 0,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_ADD_PASS      CTL_CODE(FILE_DEVICE_UNKNOWN, 1,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_CLEAR_PASS    CTL_CODE(FILE_DEVICE_UNKNOWN, 2,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_MOUNT         CTL_CODE(FILE_DEVICE_UNKNOWN, 3,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_MOUNT_ALL     CTL_CODE(FILE_DEVICE_UNKNOWN, 4,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_UNMOUNT       CTL_CODE(FILE_DEVICE_UNKNOWN, 5,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_STATUS        CTL_CODE(FILE_DEVICE_UNKNOWN, 7,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_ADD_SEED      CTL_CODE(FILE_DEVICE_UNKNOWN, 8,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_CHANGE_PASS   CTL_CODE(FILE_DEVICE_UNKNOWN, 9,  METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_ENCRYPT_START CTL_CODE(FILE_DEVICE_UNKNOWN, 10, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_DECRYPT_START CTL_CODE(FILE_DEVICE_UNKNOWN, 11, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_RE_ENC_START  CTL_CODE(FILE_DEVICE_UNKNOWN, 12, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_ENCRYPT_STEP  CTL_CODE(FILE_DEVICE_UNKNOWN, 13, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_DECRYPT_STEP  CTL_CODE(FILE_DEVICE_UNKNOWN, 14, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_SYNC_STATE    CTL_CODE(FILE_DEVICE_UNKNOWN, 15, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_RESOLVE       CTL_CODE(FILE_DEVICE_UNKNOWN, 16, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_GET_RAND      CTL_CODE(FILE_DEVICE_UNKNOWN, 19, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_BENCHMARK     CTL_CODE(FILE_DEVICE_UNKNOWN, 20, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_BSOD          CTL_CODE(FILE_DEVICE_UNKNOWN, 21, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_GET_CONF      CTL_CODE(FILE_DEVICE_UNKNOWN, 22, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_SET_CONF      CTL_CODE(FILE_DEVICE_UNKNOWN, 23, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_LOCK_MEM      CTL_CODE(FILE_DEVICE_UNKNOWN, 24, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_UNLOCK_MEM    CTL_CODE(FILE_DEVICE_UNKNOWN, 25, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_FORMAT_START      CTL_CODE(FILE_DEVICE_UNKNOWN, 26, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_FORMAT_STEP       CTL_CODE(FILE_DEVICE_UNKNOWN, 27, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_FORMAT_DONE       CTL_CODE(FILE_DEVICE_UNKNOWN, 28, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_BACKUP_HEADER     CTL_CODE(FILE_DEVICE_UNKNOWN, 29, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_RESTORE_HEADER    CTL_CODE(FILE_DEVICE_UNKNOWN, 30, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_BAD_BLOCKS    CTL_CODE(FILE_DEVICE_UNKNOWN, 31, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_SET_THROTTLE  CTL_CODE(FILE_DEVICE_UNKNOWN, 32, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_RUN           CTL_CODE(FILE_DEVICE_UNKNOWN, 33, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_BENCH_EX      CTL_CODE(FILE_DEVICE_UNKNOWN, 34, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define DC_CTL_ENUM          CTL_CODE(FILE_DEVICE_UNKNOWN, 35, METHOD_BUFFERED, FILE_ANY_ACCESS)
+
+#define FSCTL_LOCK_VOLUME               CTL_CODE(FILE_DEVICE_FILE_SYSTEM,  6, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define FSCTL_UNLOCK_VOLUME             CTL_CODE(FILE_DEVICE_FILE_SYSTEM,  7, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define FSCTL_DISMOUNT_VOLUME           CTL_CODE(FILE_DEVICE_FILE_SYSTEM,  8, METHOD_BUFFERED, FILE_ANY_ACCESS)
+
+#define MAX_DEVICE              64 // maximum device name length
+
+#define DC_DEVICE_NAME     L"\\Device\\dcrypt"
+#define DC_LINK_NAME       L"\\DosDevices\\dcrypt"
+#define DC_WIN32_NAME      L"\\\\.\\dcrypt"
+#define DC_OLD_WIN32_NAME  L"\\\\.\\TcWde"
+
+#pragma pack (push, 1)
+
+#ifndef BOOT_LDR
+
+typedef struct _crypt_info {
+	u8  cipher_id; /* cipher id */
+	u8  wp_mode;   /* data wipe mode (for encryption) */
+	u16 unit_size; /* XTS data unit size, 0 - SECTOR_SIZE */
+
+} crypt_info;
+
+#define CRYPT_UNIT_SIZE(_c) ( (_c)->unit_size != 0 ? (_c)->unit_size : SECTOR_SIZE )
+
+typedef struct _dc_ioctl {
+	dc_pass    passw1;  /* password                         */
+	dc_pass    passw2;  /* new password (for changing pass) */
+	wchar_t    device[MAX_DEVICE + 1];
+	u32        flags;   /* mount/unmount flags             */
+	int        status;  /* operation status code           */
+	int        n_mount; /* number of mounted devices       */
+	crypt_info crypt;
+
+} dc_ioctl;
+
+typedef struct _dc_lock_ctl {
+	void *data;
+	u32   size;
+	int   resl;
+
+} dc_lock_ctl;
+
+typedef struct _dc_rand_ctl {
+	void *buff;
+	u32   size;
+
+} dc_rand_ctl;
+
+typedef struct _dc_backup_ctl {
+	u16        device[MAX_DEVICE + 1];
+	dc_pass    pass;
+	u8         backup[DC_AREA_SIZE];
+	int        status;
+
+} dc_backup_ctl;
+
+#define MAX_BAD_RANGES 64 /* maximum number of remembered bad regions */
+
+typedef struct _dc_bad_range {
+	u64 offset; /* bad region offset */
+	u64 size;   /* bad region size   */
+
+} dc_bad_range;
+
+typedef struct _dc_bad_ctl {
+	wchar_t      device[MAX_DEVICE + 1];
+	u32          count; /* number of known bad regions          */
+	u32          lost;  /* regions not stored because map full */
+	dc_bad_range range[MAX_BAD_RANGES];
+	int          status;
+
+} dc_bad_ctl;
+
+typedef struct _dc_throttle_ctl {
+	wchar_t device[MAX_DEVICE + 1];
+	u32     max_latency; /* target foreground latency in msecs, 0 - no throttling */
+	u32     max_speed;   /* maximum conversion speed in KB/s, 0 - unlimited */
+	int     status;
+
+} dc_throttle_ctl;
+
+#define MAX_THR_LATENCY (60 * 1000) /* largest target latency, msecs */
+
+/* autonomous conversion modes */
+#define RUN_NONE    0
+#define RUN_ENCRYPT 1
+#define RUN_DECRYPT 2
+#define RUN_FORMAT  3
+
+typedef struct _dc_run_ctl {
+	wchar_t device[MAX_DEVICE + 1];
+	u32     mode;    /* RUN_NONE - stop conversion */
+	u32     wp_mode; /* data wipe mode */
+	void   *h_event; /* progress notification event, may be NULL */
+	int     status;
+
+} dc_run_ctl;
+
+#define TEST_BLOCK_LEN 2048*1024 /* speed test block size */
+#define TEST_BLOCK_NUM 20        /* number of test blocks */
+#define TEST_RND_LEN   64*1024   /* random generator test size */
+
+typedef struct _dc_status {
+	u64        dsk_size;
+	u64        tmp_size;
+	u32        flags;
+	u32        mnt_flags;
+	u32        disk_id;
+	s32        paging_count;	
+	crypt_info crypt;
+	u16        vf_version;   /* volume format version */
+	u32        run_mode;     /* autonomous conversion mode */
+	int        run_status;   /* last autonomous conversion status */
+	u32        mnt_time;     /* last mount attempt time, ms */
+	wchar_t    mnt_point[MAX_PATH];
+
+} dc_status;
+
+typedef struct _dc_enum_item {
+	wchar_t   device[MAX_DEVICE + 1];
+	dc_status status;
+
+} dc_enum_item;
+
+/* DC_CTL_ENUM output, followed by [items] dc_enum_item structures */
+typedef struct _dc_enum_ctl {
+	u32 seq;   /* devices state change counter */
+	u32 count; /* number of hooked devices */
+	u32 items; /* number of returned items */
+
+} dc_enum_ctl;
+
+#define DC_ENUM_SIZE(_items) ( sizeof(dc_enum_ctl) + (_items) * sizeof(dc_enum_item) )
+
+typedef struct _dc_bench {
+	u32 data_size;
+	u64 enc_time;
+	u64 cpu_freq;
+	u64 ks_time;   /* keystream (random fill) time */
+	u32 rnd_size;  /* random generator test size */
+	u64 pool_time; /* rnd_get_bytes time, entropy pool path */
+	u64 drbg_time; /* rnd_get_bytes time, per-CPU DRBG path */
+
+} dc_bench;
+
+/* extended benchmark dispatch modes */
+#define BENCH_INLINE   0 /* process requests in submitting threads */
+#define BENCH_PARALLEL 1 /* split requests across fast_crypt worker pool */
+
+#define BENCH_MIN_REQ     512             /* minimum request size */
+#define BENCH_MAX_REQ     (4*1024*1024)   /* maximum request size */
+#define BENCH_MAX_DATA    (256*1024*1024) /* maximum data size per run */
+#define BENCH_MAX_REQS    65536           /* maximum timed requests per run */
+#define BENCH_MAX_THREADS 32              /* maximum submitting threads */
+#define BENCH_MAX_MEM     (16*1024*1024)  /* maximum request buffers size of all threads */
+
+typedef struct _dc_bench_ctl {
+	u32 cipher_id;
+	u32 is_encrypt;
+	u32 req_size;   /* request size, multiple of BENCH_MIN_REQ */
+	u32 mode;       /* BENCH_INLINE or BENCH_PARALLEL */
+	u32 threads;    /* number of submitting threads */
+	u32 data_size;  /* data size to process */
+	u32 unit_size;  /* XTS data unit size, 0 - SECTOR_SIZE */
+	/* results */
+	u32 req_count;  /* number of processed requests */
+	u64 time;       /* total time, performance counter ticks */
+	u64 cpu_freq;   /* performance counter frequency */
+	u64 cycles;     /* total time, TSC cycles */
+	u64 lat_p50;    /* request latency percentiles, performance counter ticks */
+	u64 lat_p90;
+	u64 lat_p99;
+	u64 lat_max;
+	int status;
+
+} dc_bench_ctl;
+
+typedef struct _dc_conf {
+	u32 conf_flags;
+	u32 load_flags;
+
+} dc_conf;
+
+#define IS_UNMOUNTABLE(d) ( !((d)->flags & (F_SYSTEM | F_HIBERNATE)) && \
+                             ((d)->paging_count == 0) )
+
+#define IS_EQUAL_PASS(p1,p2) ( (p1 && p2) && \
+                               ((p1)->size == (p2)->size) && \
+	                             (memcmp((p1)->pass, (p2)->pass, (p1)->size) == 0) )
+
+#endif
+
+#pragma pack (pop)
+
+#define OS_UNK   0
+#define OS_WIN2K 1
+#define OS_VISTA 2
+
+#define DC_MEM_RETRY_TIME    10
+#define DC_MEM_RETRY_TIMEOUT (1000 * 30)
+
+#ifdef IS_DRIVER
+ extern PDEVICE_OBJECT dc_device;
+ extern PDRIVER_OBJECT dc_driver;
+ extern u32            dc_os_type; 
+ extern u32            dc_io_count;
+ extern u32            dc_dump_disable;
+ extern u32            dc_no_usb_mount;
+ extern u32            dc_conf_flags;
+ extern u32            dc_load_flags;
+ extern u32            dc_boot_kbs;
+ extern int            dc_cpu_count; 
+#endif
+
+
 #endif
\ No newline at end of file
@@ -1,35 +1,46 @@
-#ifndef _ENC_DEC_
-#define _ENC_DEC_
-
-typedef void (*s_callback)(void*,void*,int);
-
-int  dc_enable_sync_mode(dev_hook *hook);
-int  dc_encrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt);
-int  dc_decrypt_start(wchar_t *dev_name, dc_pass *password);
-int  dc_reencrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt);
-int  dc_send_sync_packet(wchar_t *dev_name, u32 type, void *param);
-void dc_sync_all_encs();
-
-typedef struct _sync_packet {
-	LIST_ENTRY entry_list;
-	u32        type;
-	PIRP       irp;
-	void      *param;
-	KEVENT     sync_event;
-	int        status;
-
-} sync_packet;
-
-#define S_OP_ENC_BLOCK  0
-#define S_OP_DEC_BLOCK  1
-#define S_OP_SYNC       2
-#define S_OP_FINALIZE   3
-
-#define S_INIT_NONE       0
-#define S_INIT_ENC        1
-#define S_INIT_DEC        2
-#define S_CONTINUE_ENC    3
-#define S_INIT_RE_ENC     4
-#define S_CONTINUE_RE_ENC 5
-
+#ifndef _ENC_DEC_
+#define _ENC_DEC_
+
+typedef void (*s_callback)(void*,void*,int);
+
+int  dc_enable_sync_mode(dev_hook *hook);
+int  dc_encrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt);
+int  dc_decrypt_start(wchar_t *dev_name, dc_pass *password);
+int  dc_reencrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt);
+int  dc_send_sync_packet(wchar_t *dev_name, u32 type, void *param);
+void dc_sync_all_encs();
+void dc_reset_bad_blocks(dev_hook *hook);
+int  dc_get_bad_blocks(wchar_t *dev_name, dc_bad_ctl *ctl);
+int  dc_set_throttle(wchar_t *dev_name, u32 max_latency, u32 max_speed);
+int  dc_conversion_run(wchar_t *dev_name, u32 mode, u32 wp_mode, HANDLE h_event);
+void dc_run_notify(dev_hook *hook);
+void dc_run_finish(dev_hook *hook, int status);
+
+typedef struct _sync_packet {
+	LIST_ENTRY entry_list;
+	u32        type;
+	PIRP       irp;
+	void      *param;
+	KEVENT     sync_event;
+	int        status;
+
+} sync_packet;
+
+#define S_OP_ENC_BLOCK  0
+#define S_OP_DEC_BLOCK  1
+#define S_OP_SYNC       2
+#define S_OP_FINALIZE   3
+#define S_OP_RUN        4
+
+#define S_RUN_SAVE_STEPS 20 /* save state and notify progress every 20 blocks */
+
+#define S_MIN_CHUNK (64 * 1024) /* minimum conversion chunk size */
+
+#define S_INIT_NONE       0
+#define S_INIT_ENC        1
+#define S_INIT_DEC        2
+#define S_CONTINUE_ENC    3
+#define S_INIT_RE_ENC     4
+#define S_CONTINUE_RE_ENC 5
+
 #endif
\ No newline at end of file
@@ -1,8 +1,8 @@
-#ifndef _FSF_CONTROL_H_
-#define _FSF_CONTROL_H_
-
-void dc_fsf_connect();
-void dc_fsf_set_flags(wchar_t *dev_name, u32 flags);
-void dc_fsf_set_conf();
-
+#ifndef _FSF_CONTROL_H_
+#define _FSF_CONTROL_H_
+
+void dc_fsf_connect();
+void dc_fsf_set_flags(wchar_t *dev_name, u32 flags);
+void dc_fsf_set_conf();
+
 #endif
\ No newline at end of file
@@ -1,12 +1,18 @@
-#ifndef _PRNG_
-#define _PRNG_
-
-#include "defines.h"
-#include "aes_key.h"
-
-void rnd_add_buff(void *data, int size);
-void rnd_reseed_now();
-int  rnd_get_bytes(u8 *buf, int len);
-int  rnd_init_prng();
-
+#ifndef _PRNG_
+#define _PRNG_
+
+#include "defines.h"
+#include "aes_key.h"
+
+#define RND_BULK_MIN    4096               /* minimum request size served by DRBG */
+#define RND_DRBG_RESEED (16 * 1024 * 1024) /* DRBG reseed interval */
+#define RND_SAMPLES     32                 /* I/O samples per CPU buffer */
+
+void rnd_add_buff(void *data, int size);
+void rnd_add_sample(void *irp, u64 offset, int last);
+void rnd_reseed_now();
+int  rnd_get_pool_bytes(u8 *buf, int len);
+int  rnd_get_bytes(u8 *buf, int len);
+int  rnd_init_prng();
+
 #endif
\ No newline at end of file
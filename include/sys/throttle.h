@@ -0,0 +1,32 @@
+#ifndef _THROTTLE_
+#define _THROTTLE_
+
+#include "defines.h"
+
+typedef struct _io_throttle {
+	u32 target_lat; /* target foreground latency (microseconds), 0 - throttling disabled */
+	u32 max_bw;     /* maximum conversion bandwidth (KB/s), 0 - unlimited */
+	u32 min_chunk;  /* minimum conversion chunk size */
+	u32 max_chunk;  /* maximum conversion chunk size */
+	u32 chunk;      /* next conversion chunk size */
+	u32 delay;      /* delay before next chunk (microseconds) */
+	u32 avg_lat;    /* smoothed foreground latency */
+	u32 avg_depth;  /* smoothed foreground queue depth (1/16 units) */
+
+} io_throttle;
+
+#define THR_MIN_DELAY  1000    /* 1 msec  */
+#define THR_MAX_DELAY  500000  /* 0.5 sec */
+
+void throttle_set(io_throttle *thr, u32 target_lat, u32 max_bw);
+void throttle_reset(io_throttle *thr, u32 min_chunk, u32 max_chunk);
+
+/*
+   fg_count - number of foreground requests completed since last update
+   fg_lat   - summary latency of these requests (microseconds)
+   fg_depth - maximum foreground queue depth observed
+   elapsed  - time spent to process last chunk (microseconds)
+*/
+void throttle_update(io_throttle *thr, u32 fg_count, u32 fg_lat, u32 fg_depth, u32 elapsed);
+
+#endif
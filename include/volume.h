@@ -1,81 +1,108 @@
-#ifndef _VOLUME_H_
-#define _VOLUME_H_
-
-#include "defines.h"
-
-#define DC_VOLM_SIGN 0x50524344
-
-// Header key derivation
-#define PKCS5_SALT_SIZE			64
-
-// Master key + secondary key (LRW mode)
-#define DISKKEY_SIZE			256
-#define MAX_KEY_SIZE            (32*3)
-#define PKCS_DERIVE_MAX         (MAX_KEY_SIZE*2)
-
-#define SECTOR_SIZE                 512
-#define MAX_SECTOR_SIZE             2048
-#define CD_SECTOR_SIZE              2048
-
-#define MIN_PASSWORD			1		// Minimum password length
-#define MAX_PASSWORD			128		// Maximum password length
-
-#define DC_HDR_VERSION 1
-
-#define VF_NONE           0x00
-#define VF_TMP_MODE       0x01 /* temporary encryption mode */
-#define VF_REENCRYPT      0x02 /* volume re-encryption in progress */
-#define VF_STORAGE_FILE   0x04 /* redirected area are placed in file */
-#define VF_NO_REDIR       0x08 /* redirection area is not present */
-#define VF_EXTENDED       0x10 /* this volume placed on extended partition */
-
-#define ENC_BLOCK_SIZE  (1280 * 1024)
-
-#pragma pack (push, 1)
-
-typedef struct _dc_pass {
-	int     size;
-	wchar_t pass[MAX_PASSWORD];
-} dc_pass;
-
-typedef struct _dc_header {
-	u8  salt[PKCS5_SALT_SIZE]; /* pkcs5.2 salt */
-	u32 sign;                  /* signature 'DCRP' */
-	u32 hdr_crc;               /* crc32 of decrypted volume header */
-	u16 version;               /* volume format version */
-	u32 flags;                 /* volume flags */
-	u32 disk_id;               /* unigue volume identifier */
-	int alg_1;                 /* crypt algo 1 */
-	u8  key_1[DISKKEY_SIZE];   /* crypt key 1  */
-	int alg_2;                 /* crypt algo 2 */
-	u8  key_2[DISKKEY_SIZE];   /* crypt key 2  */
-
-	union {
-		u64 stor_off;    /* redirection area offset */
-		u64 data_off;    /* volume data offset, if redirection area is not used */
-	};
-	u64 use_size;    /* user available volume size */
-	u64 tmp_size;    /* temporary part size      */
-	u8  tmp_wp_mode; /* data wipe mode */
-
-	u8  reserved[1422 - 1];
-
-} dc_header;
-
-#define IS_INVALID_VOL_FLAGS(_f) ( ((_f) & VF_NO_REDIR) && \
-	((_f) & (VF_TMP_MODE | VF_REENCRYPT | VF_STORAGE_FILE)) )
-
-#define IS_INVALID_SECTOR_SIZE(_s) ( ((_s) % SECTOR_SIZE) || \
-	((_s) > MAX_SECTOR_SIZE) || (sizeof(dc_header) % (_s)) )
-
-
-#define DC_AREA_SIZE         (2 * 1024)
-#define DC_AREA_SECTORS      (DC_AREA_SIZE / SECTOR_SIZE)
-#define DC_ENCRYPTEDDATASIZE (DC_AREA_SIZE - PKCS5_SALT_SIZE)
-#define DC_CRC_AREA_SIZE     (DC_ENCRYPTEDDATASIZE - 8)
-
-
-#pragma pack (pop)
-
-
+#ifndef _VOLUME_H_
+#define _VOLUME_H_
+
+#include "defines.h"
+
+#define DC_VOLM_SIGN    0x50524344 /* 'DCRP' */
+#define DC_VOLM_SIGN_4K 0x4B524344 /* 'DCRK', volume with large data units, unknown to old versions */
+
+// Header key derivation
+#define PKCS5_SALT_SIZE			64
+
+// Master key + secondary key (LRW mode)
+#define DISKKEY_SIZE			256
+#define MAX_KEY_SIZE            (32*3)
+#define PKCS_DERIVE_MAX         (MAX_KEY_SIZE*2)
+
+#define SECTOR_SIZE                 512
+#define MAX_SECTOR_SIZE             2048
+#define CD_SECTOR_SIZE              2048
+
+#define MIN_PASSWORD			1		// Minimum password length
+#define MAX_PASSWORD			128		// Maximum password length
+
+#define DC_HDR_VER_1    1
+#define DC_HDR_VERSION  2
+#define DC_HDR_VER_UNIT 2 /* first version with XTS data unit size fields */
+
+#define DC_MAX_UNIT_SIZE 4096 /* largest XTS data unit */
+
+#define VF_NONE           0x00
+#define VF_TMP_MODE       0x01 /* temporary encryption mode */
+#define VF_REENCRYPT      0x02 /* volume re-encryption in progress */
+#define VF_STORAGE_FILE   0x04 /* redirected area are placed in file */
+#define VF_NO_REDIR       0x08 /* redirection area is not present */
+#define VF_EXTENDED       0x10 /* this volume placed on extended partition */
+
+#define ENC_BLOCK_SIZE  (1280 * 1024)
+
+#pragma pack (push, 1)
+
+typedef struct _dc_pass {
+	int     size;
+	wchar_t pass[MAX_PASSWORD];
+} dc_pass;
+
+typedef struct _dc_header {
+	u8  salt[PKCS5_SALT_SIZE]; /* pkcs5.2 salt */
+	u32 sign;                  /* signature 'DCRP' */
+	u32 hdr_crc;               /* crc32 of decrypted volume header */
+	u16 version;               /* volume format version */
+	u32 flags;                 /* volume flags */
+	u32 disk_id;               /* unigue volume identifier */
+	int alg_1;                 /* crypt algo 1 */
+	u8  key_1[DISKKEY_SIZE];   /* crypt key 1  */
+	int alg_2;                 /* crypt algo 2 */
+	u8  key_2[DISKKEY_SIZE];   /* crypt key 2  */
+
+	union {
+		u64 stor_off;    /* redirection area offset */
+		u64 data_off;    /* volume data offset, if redirection area is not used */
+	};
+	u64 use_size;    /* user available volume size */
+	u64 tmp_size;    /* temporary part size      */
+	u8  tmp_wp_mode; /* data wipe mode */
+	u16 unit_size;   /* XTS data unit size of key_1, 0 - SECTOR_SIZE */
+	u16 unit_size_2; /* XTS data unit size of key_2, 0 - SECTOR_SIZE */
+
+	u8  reserved[1422 - 5];
+
+} dc_header;
+
+#define IS_INVALID_VOL_FLAGS(_f) ( ((_f) & VF_NO_REDIR) && \
+	((_f) & (VF_TMP_MODE | VF_REENCRYPT | VF_STORAGE_FILE)) )
+
+/* version 1 volumes always use 512 bytes data units */
+#define DC_UNIT_SIZE(_h, _u) ( \
+	((_h)->version >= DC_HDR_VER_UNIT) && ((_h)->_u != 0) ? (_h)->_u : SECTOR_SIZE )
+
+/* header uses data units larger than SECTOR_SIZE and must not be mounted by old versions */
+#define DC_HDR_LARGE_UNIT(_h) ( \
+	((_h)->unit_size != 0 && (_h)->unit_size != SECTOR_SIZE) || \
+	(((_h)->flags & VF_REENCRYPT) && (_h)->unit_size_2 != 0 && (_h)->unit_size_2 != SECTOR_SIZE) )
+
+/* version 1 and old signature are kept while all data units are SECTOR_SIZE */
+#define DC_SET_HDR_SIGN(_h) { \
+	(_h)->sign    = DC_HDR_LARGE_UNIT(_h) ? DC_VOLM_SIGN_4K : DC_VOLM_SIGN; \
+	(_h)->version = DC_HDR_LARGE_UNIT(_h) ? DC_HDR_VERSION : DC_HDR_VER_1; \
+}
+
+#define IS_VALID_VOLM_SIGN(_h) ( ((_h)->sign == DC_VOLM_SIGN) || \
+	((_h)->sign == DC_VOLM_SIGN_4K && (_h)->version >= DC_HDR_VER_UNIT) )
+
+#define IS_INVALID_UNIT_SIZE(_s) ( ((_s) != SECTOR_SIZE) && ((_s) != DC_MAX_UNIT_SIZE) )
+
+#define IS_INVALID_SECTOR_SIZE(_s) ( ((_s) % SECTOR_SIZE) || \
+	((_s) > MAX_SECTOR_SIZE) || (sizeof(dc_header) % (_s)) )
+
+
+#define DC_AREA_SIZE         (2 * 1024)
+#define DC_AREA_SECTORS      (DC_AREA_SIZE / SECTOR_SIZE)
+#define DC_ENCRYPTEDDATASIZE (DC_AREA_SIZE - PKCS5_SALT_SIZE)
+#define DC_CRC_AREA_SIZE     (DC_ENCRYPTEDDATASIZE - 8)
+
+
+#pragma pack (pop)
+
+
 #endif
\ No newline at end of file
@@ -1,6 +1,6 @@
-@echo off
-copy release\i386\dcrypt.sys    bartpe\dcrypt.sys
-copy release\i386\dc_fsf.sys    bartpe\dc_fsf.sys
-copy release\i386\dcrypt.exe    bartpe\dcrypt.exe
-copy release\i386\dcapi.dll     bartpe\dcapi.dll
+@echo off
+copy release\i386\dcrypt.sys    bartpe\dcrypt.sys
+copy release\i386\dc_fsf.sys    bartpe\dc_fsf.sys
+copy release\i386\dcrypt.exe    bartpe\dcrypt.exe
+copy release\i386\dcapi.dll     bartpe\dcapi.dll
 copy release\i386\dccon.exe     bartpe\dccon.exe
\ No newline at end of file
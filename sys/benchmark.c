@@ -1,74 +1,236 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2007-2008 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <ntifs.h>
-#include "defines.h"
-#include "driver.h"
-#include "xts_fast.h"
-#include "prng.h"
-#include "fast_crypt.h"
-#include "benchmark.h"
-#include "misc_mem.h"
-
-int dc_k_benchmark(crypt_info *crypt, dc_bench *info)
-{
-	u8       key[DISKKEY_SIZE];	
-	u8      *buff = NULL;
-	xts_key *dc_k = NULL;
-	u64      freq, time;
-	u64      offset;
-	int      resl, i;
-
-	do
-	{
-		if ( (buff = mm_alloc(TEST_BLOCK_LEN, 0)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		if ( (dc_k = mm_alloc(sizeof(xts_key), 0)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		offset = 0;
-
-		for (i = 0; i < TEST_BLOCK_LEN; i++) {
-			buff[i] = d8(i);
-		}
-		for (i = 0; i < DISKKEY_SIZE; i++) {
-			key[i] = d8(i);
-		}		
-		xts_set_key(key, crypt->cipher_id, dc_k);
-
-		time = KeQueryPerformanceCounter(pv(&freq)).QuadPart;
-
-		for (i = 0; i < TEST_BLOCK_NUM; i++) {
-			dc_fast_encrypt(buff, buff, TEST_BLOCK_LEN, offset, dc_k);
-			offset += TEST_BLOCK_LEN;
-		}
-		time = KeQueryPerformanceCounter(NULL).QuadPart - time;
-
-		info->data_size = TEST_BLOCK_LEN * TEST_BLOCK_NUM;
-		info->enc_time  = time;
-		info->cpu_freq  = freq; resl = ST_OK;
-	} while (0);
-
-	if (buff != NULL) { mm_free(buff); }
-	if (dc_k != NULL) { mm_free(dc_k); }
-
-	return resl;
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2007-2008 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ntifs.h>
+#include "defines.h"
+#include "driver.h"
+#include "xts_fast.h"
+#include "prng.h"
+#include "fast_crypt.h"
+#include "benchmark.h"
+#include "misc_mem.h"
+#include "misc.h"
+
+int dc_k_benchmark(crypt_info *crypt, dc_bench *info)
+{
+	u8       key[DISKKEY_SIZE];	
+	u8      *buff = NULL;
+	xts_key *dc_k = NULL;
+	u64      freq, time;
+	u64      offset;
+	int      resl, i;
+
+	do
+	{
+		if ( (crypt->cipher_id >= CF_CIPHERS_NUM) || (IS_INVALID_UNIT_SIZE(CRYPT_UNIT_SIZE(crypt)) != 0) ) {
+			resl = ST_ERROR; break;
+		}
+		if ( (buff = mm_alloc(TEST_BLOCK_LEN, 0)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( (dc_k = mm_alloc(xts_key_size(crypt->cipher_id), 0)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		offset = 0;
+
+		for (i = 0; i < TEST_BLOCK_LEN; i++) {
+			buff[i] = d8(i);
+		}
+		for (i = 0; i < DISKKEY_SIZE; i++) {
+			key[i] = d8(i);
+		}		
+		xts_set_key(key, crypt->cipher_id, dc_k);
+		xts_set_unit(dc_k, CRYPT_UNIT_SIZE(crypt));
+
+		time = KeQueryPerformanceCounter(pv(&freq)).QuadPart;
+
+		for (i = 0; i < TEST_BLOCK_NUM; i++) {
+			dc_fast_encrypt(buff, buff, TEST_BLOCK_LEN, offset, dc_k);
+			offset += TEST_BLOCK_LEN;
+		}
+		time = KeQueryPerformanceCounter(NULL).QuadPart - time;
+
+		info->data_size = TEST_BLOCK_LEN * TEST_BLOCK_NUM;
+		info->enc_time  = time;
+		info->cpu_freq  = freq;
+
+		time = KeQueryPerformanceCounter(NULL).QuadPart;
+
+		for (i = 0, offset = 0; i < TEST_BLOCK_NUM; i++) {
+			dc_fast_keystream(buff, TEST_BLOCK_LEN, offset, dc_k);
+			offset += TEST_BLOCK_LEN;
+		}
+		info->ks_time = KeQueryPerformanceCounter(NULL).QuadPart - time;
+
+		/* random generator, entropy pool against DRBG */
+		time = KeQueryPerformanceCounter(NULL).QuadPart;
+		rnd_get_pool_bytes(buff, TEST_RND_LEN);
+		info->pool_time = KeQueryPerformanceCounter(NULL).QuadPart - time;
+
+		time = KeQueryPerformanceCounter(NULL).QuadPart;
+		rnd_get_bytes(buff, TEST_RND_LEN);
+		info->drbg_time = KeQueryPerformanceCounter(NULL).QuadPart - time;
+
+		info->rnd_size = TEST_RND_LEN;
+		resl = ST_OK;
+	} while (0);
+
+	if (buff != NULL) { mm_free(buff); }
+	if (dc_k != NULL) { mm_free(dc_k); }
+
+	return resl;
+}
+
+typedef struct _bench_ctx {
+	dc_bench_ctl *bctl;
+	xts_key      *key;
+	u8           *buff;  /* req_size bytes per thread */
+	u32          *lat;   /* latency of each request   */
+	int           next;  /* next request index        */
+	int           n_thr; /* thread index counter      */
+
+} bench_ctx;
+
+static void dc_bench_worker(bench_ctx *ctx)
+{
+	dc_bench_ctl *bctl = ctx->bctl;
+	u8           *buff = ctx->buff + (lock_inc(&ctx->n_thr) - 1) * bctl->req_size;
+	u64           time, offset;
+	int           i;
+
+	while ( (i = lock_inc(&ctx->next) - 1) < (int)bctl->req_count )
+	{
+		offset = d64(i) * bctl->req_size;
+		time   = KeQueryPerformanceCounter(NULL).QuadPart;
+
+		if (bctl->mode == BENCH_PARALLEL) {
+			dc_fast_crypt_op(bctl->is_encrypt, ctx->key, buff, buff, bctl->req_size, offset);
+		} else if (bctl->is_encrypt != 0) {
+			xts_encrypt(buff, buff, bctl->req_size, offset, ctx->key);
+		} else {
+			xts_decrypt(buff, buff, bctl->req_size, offset, ctx->key);
+		}
+		ctx->lat[i] = d32(KeQueryPerformanceCounter(NULL).QuadPart - time);
+	}
+}
+
+static void dc_bench_thread(bench_ctx *ctx)
+{
+	dc_bench_worker(ctx);
+	PsTerminateSystemThread(STATUS_SUCCESS);
+}
+
+static void dc_sort_u32(u32 *data, int count)
+{
+	u32 v;
+	int gap, i, j;
+
+	/* shell sort, latency arrays are small enough */
+	for (gap = count / 2; gap > 0; gap /= 2)
+	{
+		for (i = gap; i < count; i++)
+		{
+			for (v = data[i], j = i; (j >= gap) && (data[j - gap] > v); j -= gap) {
+				data[j] = data[j - gap];
+			}
+			data[j] = v;
+		}
+	}
+}
+
+int dc_k_benchmark_ex(dc_bench_ctl *bctl)
+{
+	HANDLE    threads[BENCH_MAX_THREADS];
+	u8        key[DISKKEY_SIZE];
+	bench_ctx ctx;
+	u64       freq, time, tsc;
+	int       resl, n_thread, i;
+
+	zeroauto(&ctx, sizeof(ctx));
+	ctx.bctl = bctl;
+
+	do
+	{
+		if ( (bctl->cipher_id >= CF_CIPHERS_NUM) || (bctl->mode > BENCH_PARALLEL) ||
+			 (bctl->req_size < BENCH_MIN_REQ) || (bctl->req_size > BENCH_MAX_REQ) || (bctl->req_size % BENCH_MIN_REQ) ||
+			 (bctl->threads == 0) || (bctl->threads > BENCH_MAX_THREADS) || (bctl->req_size * bctl->threads > BENCH_MAX_MEM) ||
+			 (IS_INVALID_UNIT_SIZE(CRYPT_UNIT_SIZE(bctl)) != 0) )
+		{
+			resl = ST_ERROR; break;
+		}
+		bctl->is_encrypt = (bctl->is_encrypt != 0);
+		bctl->data_size  = min(max(bctl->data_size, bctl->req_size), BENCH_MAX_DATA);
+		bctl->req_count  = min(bctl->data_size / bctl->req_size, BENCH_MAX_REQS);
+		bctl->data_size  = bctl->req_count * bctl->req_size;
+
+		if ( (ctx.buff = mm_alloc(bctl->req_size * bctl->threads, 0)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( (ctx.lat = mm_alloc(bctl->req_count * sizeof(u32), 0)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( (ctx.key = mm_alloc(xts_key_size(bctl->cipher_id), 0)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		for (i = 0; i < DISKKEY_SIZE; i++) {
+			key[i] = d8(i);
+		}
+		for (i = 0; i < (int)(bctl->req_size * bctl->threads); i++) {
+			ctx.buff[i] = d8(i);
+		}
+		xts_set_key(key, bctl->cipher_id, ctx.key);
+		xts_set_unit(ctx.key, CRYPT_UNIT_SIZE(bctl));
+
+		time = KeQueryPerformanceCounter(pv(&freq)).QuadPart;
+		tsc  = __rdtsc();
+
+		/* calling thread is one of the submitting threads */
+		for (n_thread = 0; n_thread < (int)bctl->threads - 1; n_thread++)
+		{
+			if (start_system_thread(dc_bench_thread, &ctx, &threads[n_thread]) != ST_OK) {
+				break;
+			}
+		}
+		dc_bench_worker(&ctx);
+
+		for (i = 0; i < n_thread; i++) {
+			ZwWaitForSingleObject(threads[i], FALSE, NULL);
+			ZwClose(threads[i]);
+		}
+		bctl->cycles   = __rdtsc() - tsc;
+		bctl->time     = KeQueryPerformanceCounter(NULL).QuadPart - time;
+		bctl->cpu_freq = freq;
+		bctl->threads  = n_thread + 1;
+
+		dc_sort_u32(ctx.lat, bctl->req_count);
+
+		bctl->lat_p50 = ctx.lat[(bctl->req_count - 1) * 50 / 100];
+		bctl->lat_p90 = ctx.lat[(bctl->req_count - 1) * 90 / 100];
+		bctl->lat_p99 = ctx.lat[(bctl->req_count - 1) * 99 / 100];
+		bctl->lat_max = ctx.lat[bctl->req_count - 1];
+		resl = ST_OK;
+	} while (0);
+
+	if (ctx.buff != NULL) { mm_free(ctx.buff); }
+	if (ctx.lat != NULL)  { mm_free(ctx.lat); }
+	if (ctx.key != NULL)  { mm_free(ctx.key); }
+
+	return resl;
 }
\ No newline at end of file
@@ -1,187 +1,366 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2007-2008 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <ntifs.h>
-#include "defines.h"
-#include "prng.h"
-#include "devhook.h"
-#include "data_wipe.h"
-#include "misc.h"
-#include "fast_crypt.h"
-#include "misc_mem.h"
-
-static wipe_mode dod_mode = { /* US DoD 5220.22-M (8-306. / E, C and E) */
-	7, 
-	{
-		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 1
-		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 2
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 3
-		{ P_PAT,  { 0x00, 0x00, 0x00 } }, // 4
-		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 5
-		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 6
-		{ P_RAND, { 0x00, 0x00, 0x00 } }  // 7
-	}
-};
-
-static wipe_mode dod_mode_e = { /* US DoD 5220.22-M (8-306. / E) */
-	3, 
-	{
-		{ P_PAT,  { 0x00, 0x00, 0x00 } }, // 1
-		{ P_PAT,  { 0xFF, 0xFF, 0xFF } }, // 2
-		{ P_RAND, { 0x00, 0x00, 0x00 } }  // 3
-	}
-};
-
-static wipe_mode gutmann_mode = { /* Gutmann */
-	35,
-	{
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 1
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 2
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 3
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 4
-		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 5
-		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 6
-		{ P_PAT,  { 0x92, 0x49, 0x24 } }, // 7
-		{ P_PAT,  { 0x49, 0x24, 0x92 } }, // 8
-		{ P_PAT,  { 0x24, 0x92, 0x49 } }, // 9
-		{ P_PAT,  { 0x00, 0x00, 0x00 } }, // 10
-		{ P_PAT,  { 0x11, 0x11, 0x11 } }, // 11
-		{ P_PAT,  { 0x22, 0x22, 0x22 } }, // 12
-		{ P_PAT,  { 0x33, 0x33, 0x33 } }, // 13
-		{ P_PAT,  { 0x44, 0x44, 0x44 } }, // 14
-		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 15
-		{ P_PAT,  { 0x66, 0x66, 0x66 } }, // 16
-		{ P_PAT,  { 0x77, 0x77, 0x77 } }, // 17
-		{ P_PAT,  { 0x88, 0x88, 0x88 } }, // 18
-		{ P_PAT,  { 0x99, 0x99, 0x99 } }, // 19
-		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 20
-		{ P_PAT,  { 0xBB, 0xBB, 0xBB } }, // 21
-		{ P_PAT,  { 0xCC, 0xCC, 0xCC } }, // 22
-		{ P_PAT,  { 0xDD, 0xDD, 0xDD } }, // 23
-		{ P_PAT,  { 0xEE, 0xEE, 0xEE } }, // 24
-		{ P_PAT,  { 0xFF, 0xFF, 0xFF } }, // 25
-		{ P_PAT,  { 0x92, 0x49, 0x24 } }, // 26
-		{ P_PAT,  { 0x49, 0x24, 0x92 } }, // 27
-		{ P_PAT,  { 0x24, 0x92, 0x49 } }, // 28
-		{ P_PAT,  { 0x6D, 0xB6, 0xDB } }, // 29
-		{ P_PAT,  { 0xB6, 0xDB, 0x6D } }, // 30
-		{ P_PAT,  { 0xDB, 0x6D, 0xB6 } }, // 31
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 32
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 33
-		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 34
-		{ P_RAND, { 0x00, 0x00, 0x00 } }  // 35
-	}
-};
-
-static wipe_mode *wipe_modes[] = {
-	NULL, 
-	&dod_mode_e, 
-	&dod_mode, 
-	&gutmann_mode
-};
-
-
-int dc_wipe_init(wipe_ctx *ctx, void *hook, int max_size, int method, int cipher)
-{
-	char key[32];
-	int  resl;
-
-	do
-	{
-		zeroauto(ctx, sizeof(wipe_ctx));
-		
-		if (method > sizeof(wipe_modes) / sizeof(wipe_mode)) {
-			resl = ST_INV_WIPE_MODE; break;
-		}
-		ctx->mode = wipe_modes[method];
-		resl      = ST_NOMEM;
-
-		if (ctx->mode != NULL) 
-		{
-			if ( (ctx->buff = mm_alloc(max_size, MEM_SECURE)) == NULL ) {
-				break;
-			}
-			if ( (ctx->key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-				break;
-			}
-			/* generate random key */
-			rnd_get_bytes(key, sizeof(key));
-			xts_set_key(key, cipher, ctx->key);
-		}
-		ctx->hook = hook;
-		ctx->size = max_size;
-		resl      = ST_OK;
-	} while (0);
-
-	/* prevent leaks */
-	zeroauto(key, sizeof(key));
-
-	if (resl != ST_OK) {
-		if (ctx->buff != NULL) { mm_free(ctx->buff); }
-		if (ctx->key != NULL)  { mm_free(ctx->key); }
-	}
-	return resl;
-}
-
-void dc_wipe_free(wipe_ctx *ctx)
-{
-	/* prevent leaks */
-	if (ctx->buff != NULL) { mm_free(ctx->buff); }
-	if (ctx->key != NULL)  { mm_free(ctx->key); }
-
-	ctx->buff = NULL; ctx->key = NULL;
-}
-
-int dc_wipe_process(wipe_ctx *ctx, u64 offset, int size)
-{
-	wipe_mode *mode = ctx->mode;
-	u8        *buff = ctx->buff;
-	int        resl;
-	int        i, j;
-
-	do
-	{
-		if (size > ctx->size) {
-			resl = ST_INV_DATA_SIZE; break;
-		}
-		if (mode == NULL) {
-			resl = ST_OK; break;
-		}
-		for (i = 0; i < mode->passes; i++) 
-		{			
-			if (mode->pass[i].type == P_PAT) 
-			{
-				for (j = 0; j < size; j++) {
-					buff[j] = mode->pass[i].patt[j % 3];
-				}
-			} else 
-			{
-				zerofast(buff, size);
-				dc_fast_encrypt(buff, buff, size, ctx->offs, ctx->key);
-				ctx->offs += size;
-			}
-			if ( (resl = dc_device_rw(ctx->hook, IRP_MJ_WRITE, buff, size, offset)) != ST_OK ) {
-				break;
-			}
-		}
-	} while (0);
-
-	return resl;
-}
\ No newline at end of file
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2007-2008 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ntifs.h>
+#include "defines.h"
+#include "prng.h"
+#include "devhook.h"
+#include "data_wipe.h"
+#include "misc.h"
+#include "fast_crypt.h"
+#include "misc_mem.h"
+
+static wipe_mode dod_mode = { /* US DoD 5220.22-M (8-306. / E, C and E) */
+	7, 
+	{
+		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 1
+		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 2
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 3
+		{ P_PAT,  { 0x00, 0x00, 0x00 } }, // 4
+		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 5
+		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 6
+		{ P_RAND, { 0x00, 0x00, 0x00 } }  // 7
+	}
+};
+
+static wipe_mode dod_mode_e = { /* US DoD 5220.22-M (8-306. / E) */
+	3, 
+	{
+		{ P_PAT,  { 0x00, 0x00, 0x00 } }, // 1
+		{ P_PAT,  { 0xFF, 0xFF, 0xFF } }, // 2
+		{ P_RAND, { 0x00, 0x00, 0x00 } }  // 3
+	}
+};
+
+static wipe_mode gutmann_mode = { /* Gutmann */
+	35,
+	{
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 1
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 2
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 3
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 4
+		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 5
+		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 6
+		{ P_PAT,  { 0x92, 0x49, 0x24 } }, // 7
+		{ P_PAT,  { 0x49, 0x24, 0x92 } }, // 8
+		{ P_PAT,  { 0x24, 0x92, 0x49 } }, // 9
+		{ P_PAT,  { 0x00, 0x00, 0x00 } }, // 10
+		{ P_PAT,  { 0x11, 0x11, 0x11 } }, // 11
+		{ P_PAT,  { 0x22, 0x22, 0x22 } }, // 12
+		{ P_PAT,  { 0x33, 0x33, 0x33 } }, // 13
+		{ P_PAT,  { 0x44, 0x44, 0x44 } }, // 14
+		{ P_PAT,  { 0x55, 0x55, 0x55 } }, // 15
+		{ P_PAT,  { 0x66, 0x66, 0x66 } }, // 16
+		{ P_PAT,  { 0x77, 0x77, 0x77 } }, // 17
+		{ P_PAT,  { 0x88, 0x88, 0x88 } }, // 18
+		{ P_PAT,  { 0x99, 0x99, 0x99 } }, // 19
+		{ P_PAT,  { 0xAA, 0xAA, 0xAA } }, // 20
+		{ P_PAT,  { 0xBB, 0xBB, 0xBB } }, // 21
+		{ P_PAT,  { 0xCC, 0xCC, 0xCC } }, // 22
+		{ P_PAT,  { 0xDD, 0xDD, 0xDD } }, // 23
+		{ P_PAT,  { 0xEE, 0xEE, 0xEE } }, // 24
+		{ P_PAT,  { 0xFF, 0xFF, 0xFF } }, // 25
+		{ P_PAT,  { 0x92, 0x49, 0x24 } }, // 26
+		{ P_PAT,  { 0x49, 0x24, 0x92 } }, // 27
+		{ P_PAT,  { 0x24, 0x92, 0x49 } }, // 28
+		{ P_PAT,  { 0x6D, 0xB6, 0xDB } }, // 29
+		{ P_PAT,  { 0xB6, 0xDB, 0x6D } }, // 30
+		{ P_PAT,  { 0xDB, 0x6D, 0xB6 } }, // 31
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 32
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 33
+		{ P_RAND, { 0x00, 0x00, 0x00 } }, // 34
+		{ P_RAND, { 0x00, 0x00, 0x00 } }  // 35
+	}
+};
+
+static wipe_mode *wipe_modes[] = {
+	NULL, 
+	&dod_mode_e, 
+	&dod_mode, 
+	&gutmann_mode
+};
+
+
+typedef struct _wipe_io {
+	KEVENT          event;
+	IO_STATUS_BLOCK iosb;
+	NTSTATUS        status;
+	int             pending;
+
+} wipe_io;
+
+static void dc_wipe_fill_patt(u8 *buff, u8 *patt, int size)
+{
+	int len, i;
+
+	if ( (patt[0] == patt[1]) && (patt[1] == patt[2]) ) {
+		memset(buff, patt[0], size); return;
+	}
+	/* write one pattern period and expand it by doubling copies */
+	for (i = 0; i < min(size, 3); i++) {
+		buff[i] = patt[i];
+	}
+	for (len = 3; len < size; len += i) {
+		i = min(len, size - len);
+		memcpy(buff + len, buff, i);
+	}
+}
+
+/*
+   count distinct patterns of wipe mode and random passes,
+   if [p_buff] is not NULL then build pattern passes data once
+*/
+static int dc_wipe_patterns(wipe_ctx *ctx, u8 *p_buff)
+{
+	wipe_mode *mode = ctx->mode;
+	u8        *patt;
+	int        i, j, n;
+
+	for (i = 0, n = 0, ctx->r_passes = 0; i < mode->passes; i++)
+	{
+		if (mode->pass[i].type != P_PAT) {
+			ctx->r_passes++; continue;
+		}
+		patt = mode->pass[i].patt;
+
+		for (j = 0; j < i; j++) 
+		{
+			if ( (mode->pass[j].type == P_PAT) && (memcmp(mode->pass[j].patt, patt, 3) == 0) ) {
+				break;
+			}
+		}
+		if (j < i) {
+			/* same pattern already built */
+			ctx->patt[i] = ctx->patt[j]; continue;
+		}
+		if (p_buff != NULL) {
+			ctx->patt[i] = p_buff + n * ctx->p_size;
+			dc_wipe_fill_patt(ctx->patt[i], patt, ctx->p_size);
+		}
+		n++;
+	}
+	return n;
+}
+
+int dc_wipe_init(wipe_ctx *ctx, void *hook, int max_size, int method, int cipher)
+{
+	char key[32];
+	int  resl, n;
+
+	do
+	{
+		zeroauto(ctx, sizeof(wipe_ctx));
+		
+		if (method > sizeof(wipe_modes) / sizeof(wipe_mode)) {
+			resl = ST_INV_WIPE_MODE; break;
+		}
+		ctx->mode = wipe_modes[method];
+		resl      = ST_NOMEM;
+
+		if (ctx->mode != NULL) 
+		{
+			/* pattern buffer is not larger than one wiped chunk */
+			ctx->p_size = min(WP_PATT_SIZE, (max_size + WP_PATT_UNIT - 1) / WP_PATT_UNIT * WP_PATT_UNIT);
+			n           = dc_wipe_patterns(ctx, NULL);
+
+			/* random pass buffers, second one prepares next pass while current is written */
+			if ( (ctx->r_passes > 0) && (ctx->buff[0] = mm_alloc(max_size, MEM_SECURE)) == NULL ) {
+				break;
+			}
+			if ( (ctx->r_passes > 1) && (ctx->buff[1] = mm_alloc(max_size, MEM_SECURE)) == NULL ) {
+				break;
+			}
+			if ( (ctx->io = mm_alloc(sizeof(wipe_io) * WP_MAX_IO, 0)) == NULL ) {
+				break;
+			}
+			if ( (ctx->key = mm_alloc(xts_key_size(cipher), MEM_SECURE)) == NULL ) {
+				break;
+			}
+			/* pattern passes are same for all chunks */
+			if ( (n != 0) && (ctx->p_buff = mm_alloc(n * ctx->p_size, 0)) == NULL ) {
+				break;
+			}
+			dc_wipe_patterns(ctx, ctx->p_buff);
+
+			/* generate random key */
+			rnd_get_bytes(key, sizeof(key));
+			xts_set_key(key, cipher, ctx->key);
+		}
+		ctx->hook = hook;
+		ctx->size = max_size;
+		resl      = ST_OK;
+	} while (0);
+
+	/* prevent leaks */
+	zeroauto(key, sizeof(key));
+
+	if (resl != ST_OK) {
+		dc_wipe_free(ctx);
+	}
+	return resl;
+}
+
+void dc_wipe_free(wipe_ctx *ctx)
+{
+	/* prevent leaks */
+	if (ctx->buff[0] != NULL) { mm_free(ctx->buff[0]); }
+	if (ctx->buff[1] != NULL) { mm_free(ctx->buff[1]); }
+	if (ctx->io != NULL)      { mm_free(ctx->io); }
+	if (ctx->key != NULL)     { mm_free(ctx->key); }
+	if (ctx->p_buff != NULL)  { mm_free(ctx->p_buff); }
+
+	ctx->buff[0] = NULL; ctx->buff[1] = NULL;
+	ctx->io = NULL; ctx->key = NULL; ctx->p_buff = NULL;
+}
+
+static void dc_wipe_fill_rand(wipe_ctx *ctx, u8 *buff, int size)
+{
+	dc_fast_keystream(buff, size, ctx->offs, ctx->key);
+	ctx->offs += size;
+}
+
+static void dc_wipe_write_issue(wipe_ctx *ctx)
+{
+	dev_hook *hook = ctx->hook;
+	wipe_io  *io;
+	PIRP      irp;
+	u64       offset;
+	u32       blen;
+	u8       *buff;
+
+	/* keep up to WP_MAX_IO requests of current pass in flight */
+	while ( (ctx->w_fail == 0) && (ctx->w_sent < ctx->w_size) && 
+		    (ctx->w_head - ctx->w_tail < WP_MAX_IO) )
+	{
+		io     = &((wipe_io*)ctx->io)[ctx->w_head % WP_MAX_IO];
+		blen   = min(ctx->w_size - ctx->w_sent, ctx->w_blen);
+		offset = ctx->w_offs + ctx->w_sent;
+		buff   = ctx->w_wrap != 0 ? ctx->w_buff : ctx->w_buff + ctx->w_sent;
+
+		KeInitializeEvent(&io->event, NotificationEvent, FALSE);
+
+		irp = IoBuildSynchronousFsdRequest(
+			IRP_MJ_WRITE, hook->orig_dev, buff, blen, pv(&offset), &io->event, &io->iosb);
+
+		if (irp == NULL) {
+			ctx->w_fail = 1; break;
+		}
+		IoGetNextIrpStackLocation(irp)->Flags |= SL_OVERRIDE_VERIFY_VOLUME;
+
+		io->status  = IoCallDriver(hook->orig_dev, irp);
+		io->pending = (io->status == STATUS_PENDING);
+
+		ctx->w_sent += blen; ctx->w_head++;
+	}
+}
+
+static void dc_wipe_write_begin(wipe_ctx *ctx, u8 *buff, u32 wrap, int size, u64 offset)
+{
+	dev_hook *hook = ctx->hook;
+
+	ctx->w_buff = buff;   ctx->w_size = size;
+	ctx->w_offs = offset; ctx->w_sent = 0;
+	ctx->w_head = 0;      ctx->w_tail = 0;
+	ctx->w_wrap = wrap;   ctx->w_blen = hook->max_chunk;
+
+	if (wrap != 0) {
+		/* each request restarts pattern, so its length must keep pattern phase */
+		ctx->w_blen = min(wrap, hook->max_chunk / WP_PATT_UNIT * WP_PATT_UNIT);
+	}
+	ctx->w_fail = (hook->pnp_state != Started) || (ctx->w_blen == 0);
+
+	dc_wipe_write_issue(ctx);
+}
+
+static int dc_wipe_write_end(wipe_ctx *ctx)
+{
+	wipe_io *io;
+	u32      blen, done;
+	int      resl;
+
+	while (ctx->w_tail != ctx->w_head)
+	{
+		io = &((wipe_io*)ctx->io)[ctx->w_tail % WP_MAX_IO];
+
+		if (io->pending != 0) {
+			wait_object_infinity(&io->event);
+			io->status = io->iosb.Status;
+		}
+		if (NT_SUCCESS(io->status) == FALSE) {
+			ctx->w_fail = 1;
+		}
+		ctx->w_tail++; dc_wipe_write_issue(ctx);
+	}
+	if (ctx->w_fail != 0) {
+		/* rewrite whole pass synchronously, this handles media verification and removal */
+		if (ctx->w_wrap == 0) {
+			return dc_device_rw(ctx->hook, IRP_MJ_WRITE, ctx->w_buff, ctx->w_size, ctx->w_offs);
+		}
+		for (done = 0; done < ctx->w_size; done += blen)
+		{
+			blen = min(ctx->w_size - done, ctx->w_wrap);
+			resl = dc_device_rw(ctx->hook, IRP_MJ_WRITE, ctx->w_buff, blen, ctx->w_offs + done);
+
+			if (resl != ST_OK) {
+				return resl;
+			}
+		}
+	}
+	return ST_OK;
+}
+
+int dc_wipe_process(wipe_ctx *ctx, u64 offset, int size)
+{
+	wipe_mode *mode = ctx->mode;
+	int        resl;
+	int        i, r;
+
+	do
+	{
+		if (size > ctx->size) {
+			resl = ST_INV_DATA_SIZE; break;
+		}
+		if (mode == NULL) {
+			resl = ST_OK; break;
+		}
+		if (ctx->r_passes != 0) {
+			dc_wipe_fill_rand(ctx, ctx->buff[0], size);
+		}
+		for (i = 0, r = 0; i < mode->passes; i++) 
+		{
+			if (mode->pass[i].type == P_PAT) {
+				dc_wipe_write_begin(ctx, ctx->patt[i], ctx->p_size, size, offset);
+			} else
+			{
+				dc_wipe_write_begin(ctx, ctx->buff[r & 1], 0, size, offset);
+
+				/* passes are written in order, next random pass data is prepared while current pass is written */
+				if (++r < ctx->r_passes) {
+					dc_wipe_fill_rand(ctx, ctx->buff[r & 1], size);
+				}
+			}
+			if ( (resl = dc_wipe_write_end(ctx)) != ST_OK ) {
+				break;
+			}
+		}
+	} while (0);
+
+	return resl;
+}
@@ -1,983 +1,1413 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2007-2009 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <ntifs.h>
-#include "defines.h"
-#include "devhook.h"
-#include "driver.h"
-#include "prng.h"
-#include "misc.h"
-#include "readwrite.h"
-#include "crc32.h"
-#include "pkcs5.h"
-#include "mount.h"
-#include "enc_dec.h"
-#include "data_wipe.h"
-#include "misc_irp.h"
-#include "fast_crypt.h"
-#include "misc_volume.h"
-#include "debug.h"
-#include "storage.h"
-#include "fsf_control.h"
-#include "crypto_head.h"
-#include "misc_mem.h"
-
-typedef struct _sync_struct {
-	KEVENT sync_event;
-	int    status;
-
-} sync_struct;
-
-typedef struct _sync_context {
-	int finish;
-	int saved;
-	int winit;
-
-} sync_context;
-
-static
-int dc_device_rw_skip_bads(
-	   dev_hook *hook, u32 function, void *buff, u32 size, u64 offset
-	   )
-{
-	u32 block;
-	int resl;
-
-	resl = dc_device_rw(
-		hook, function, buff, size, offset);
-
-	if (resl == ST_RW_ERR)
-	{
-		while (block = min(size, 4096))
-		{
-			resl = dc_device_rw(
-				hook, function, buff, block, offset);
-
-			if ( (resl == ST_MEDIA_CHANGED) || (resl == ST_NO_MEDIA) ) {
-				break;
-			}
-
-			buff  = p8(buff) + block;
-			size -= block; offset += block;
-		}
-	}
-
-	return resl;
-}
-
-static int dc_enc_update(dev_hook *hook)
-{
-	u8 *buff = hook->tmp_buff;
-	u64 offs = hook->tmp_size;
-	u32 size = d32(min(hook->dsk_size - offs, ENC_BLOCK_SIZE));
-	int r_resl, w_resl;
-
-	if (size == 0) {
-		return ST_FINISHED;
-	}
-
-	do
-	{
-		r_resl = dc_device_rw_skip_bads(
-			hook, IRP_MJ_READ, buff, size, offs);
-
-		if ( (r_resl != ST_OK) && (r_resl != ST_RW_ERR) ) {
-			break;
-		}
-		
-		dc_fast_encrypt(buff, buff, size, offs, &hook->dsk_key);
-
-		dc_wipe_process(&hook->wp_ctx, offs, size);
-
-		w_resl = dc_device_rw_skip_bads(
-			hook, IRP_MJ_WRITE, buff, size, offs);
-
-		if (w_resl == ST_RW_ERR) {
-			r_resl = w_resl;
-		}
-	} while (0);
-
-	if ( (r_resl == ST_OK) || (r_resl == ST_RW_ERR) ) {
-		hook->tmp_size += size;
-	}
-	
-	return r_resl;
-}
-
-static int dc_re_enc_update(dev_hook *hook)
-{
-	u8 *buff = hook->tmp_buff;
-	u64 offs = hook->tmp_size;
-	u32 size = d32(min(hook->dsk_size - offs, ENC_BLOCK_SIZE));	
-	int r_resl, w_resl;
-	
-	if (size == 0) {
-		return ST_FINISHED;
-	}
-
-	do
-	{
-		r_resl = dc_device_rw_skip_bads(
-			hook, IRP_MJ_READ, buff, size, offs);
-
-		if ( (r_resl != ST_OK) && (r_resl != ST_RW_ERR) ) {
-			break;
-		}
-
-		/* wipe old data */
-		dc_wipe_process(&hook->wp_ctx, offs, size);
-
-		/* re-encrypt data */
-		dc_fast_decrypt(buff, buff, size, offs, hook->tmp_key);
-		dc_fast_encrypt(buff, buff, size, offs, &hook->dsk_key);
-
-		w_resl = dc_device_rw_skip_bads(
-			hook, IRP_MJ_WRITE, buff, size, offs);
-
-		if (w_resl == ST_RW_ERR) {
-			r_resl = w_resl;
-		}
-	} while (0);
-
-	if ( (r_resl == ST_OK) || (r_resl == ST_RW_ERR) ) {
-		hook->tmp_size += size;
-	}
-
-	return r_resl;
-}
-
-
-static int dc_dec_update(dev_hook *hook)
-{
-	NTSTATUS status;
-	u8      *buff = hook->tmp_buff;
-	u32      size = d32(min(hook->tmp_size, ENC_BLOCK_SIZE));
-	u64      offs = hook->tmp_size - size;
-	int      r_resl, w_resl;
-	
-	if (size == 0)
-	{
-		/* write redirected part back to zero offset */
-		status = dc_sync_encrypted_io(
-			hook, buff, DC_AREA_SIZE, 0, SL_OVERRIDE_VERIFY_VOLUME, IRP_MJ_READ);
-
-		if (NT_SUCCESS(status) == FALSE) {
-			return ST_RW_ERR;
-		}
-
-		w_resl = dc_device_rw(
-			hook, IRP_MJ_WRITE, buff, DC_AREA_SIZE, 0);
-
-		if (w_resl == ST_OK) {
-			w_resl = ST_FINISHED;
-		}
-
-		return w_resl;
-	}
-
-	do
-	{
-		r_resl = dc_device_rw_skip_bads(
-			hook, IRP_MJ_READ, buff, size, offs);
-		
-		if ( (r_resl != ST_OK) && (r_resl != ST_RW_ERR) ) {
-			break;
-		}
-
-		dc_fast_decrypt(
-			buff, buff, size, offs, &hook->dsk_key);
-
-		w_resl = dc_device_rw_skip_bads(
-			hook, IRP_MJ_WRITE, buff, size, offs);
-
-		if (w_resl == ST_RW_ERR) {
-			r_resl = w_resl;
-		}
-	} while (0);
-
-	if ( (r_resl == ST_OK) || (r_resl == ST_RW_ERR) ) {
-		hook->tmp_size -= size;
-	}
-
-	return r_resl;
-}
-
-static void dc_save_enc_state(dev_hook *hook, int finish)
-{
-	dc_header *header;
-		
-	DbgMsg("dc_save_enc_state\n");
-
-	header = mm_alloc(sizeof(dc_header), MEM_FAST | MEM_SUCCESS | MEM_SECURE);
-
-	if (header == NULL) {
-		return;
-	}
-	/* copy volume header */
-	autocpy(header, &hook->tmp_header, sizeof(dc_header));
-
-	if (finish != 0)
-	{
-		header->flags      &= ~(VF_TMP_MODE | VF_REENCRYPT);
-		header->tmp_size    = 0;
-		header->tmp_wp_mode = 0;
-
-		if (hook->flags & F_REENCRYPT) {
-			zeroauto(header->key_2, DISKKEY_SIZE); 
-			header->alg_2 = 0;
-		}
-	} else 
-	{
-		header->flags      |= VF_TMP_MODE;
-		header->tmp_size    = hook->tmp_size;
-		header->tmp_wp_mode = hook->crypt.wp_mode;
-
-		if (hook->flags & F_REENCRYPT) {
-			header->flags |= VF_REENCRYPT;
-		} 
-	}
-
-	header->hdr_crc = crc32(pv(&header->version), DC_CRC_AREA_SIZE);
-
-	/* encrypt volume header */
-	xts_encrypt(pv(header), pv(header), sizeof(dc_header), 0, hook->hdr_key);
-
-	/* save original salt */
-	autocpy(header->salt, hook->tmp_header.salt, PKCS5_SALT_SIZE);
-	
-	/* write volume header */
-	dc_device_rw(hook, IRP_MJ_WRITE, header, sizeof(dc_header), 0);
-
-	/* free memory */
-	mm_free(header);
-}
-
-
-static int dc_init_sync_mode(dev_hook *hook, sync_context *ctx)
-{
-	NTSTATUS status;
-	xts_key *tmp_key;
-	u8      *buff = hook->tmp_buff;
-	int      resl;
-	
-	do
-	{
-		switch (lock_xchg(&hook->sync_init_type, 0))
-		{
-			case S_INIT_ENC:
-				{
-					/* initialize encryption process */
-					
-					/* save old sectors */
-					resl = dc_device_rw(
-						hook, IRP_MJ_READ, buff, DC_AREA_SIZE, 0);
-
-					if (resl != ST_OK) {
-						break;
-					}
-
-					status = dc_sync_encrypted_io(
-						hook, buff, DC_AREA_SIZE, 0, SL_OVERRIDE_VERIFY_VOLUME, IRP_MJ_WRITE);
-
-					if (NT_SUCCESS(status) == FALSE) {
-						resl = ST_RW_ERR; break;
-					}
-					
-					/* wipe old sectors */
-					dc_wipe_process(&hook->wp_ctx, 0, DC_AREA_SIZE);
-					/* save initial state */
-					dc_save_enc_state(hook, 0);
-				}
-			break;
-			case S_INIT_DEC:
-			case S_CONTINUE_ENC: 
-				{
-					resl = ST_OK;
-				}
-			break;
-			case S_INIT_RE_ENC:
-				{
-					DbgMsg("S_INIT_RE_ENC\n");
-
-					if ( (tmp_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-						resl = ST_NOMEM; break;
-					}
-					/* swap keys */
-					autocpy(tmp_key, &hook->dsk_key, sizeof(xts_key));
-					autocpy(&hook->dsk_key, hook->tmp_key, sizeof(xts_key));
-					autocpy(hook->tmp_key, tmp_key, sizeof(xts_key));
-
-					/* set re-encryption flag */
-					hook->flags |= F_REENCRYPT;
-					/* wipe old volume header */
-					dc_wipe_process(&hook->wp_ctx, 0, DC_AREA_SIZE);
-					/* save initial state */
-					dc_save_enc_state(hook, 0);
-					
-					mm_free(tmp_key); 
-					resl = ST_OK;
-				}
-			break;
-			case S_CONTINUE_RE_ENC:
-				{
-					DbgMsg("S_CONTINUE_RE_ENC\n");
-
-					if ( (tmp_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-						resl = ST_NOMEM; break;
-					}
-
-					/* initialize secondary volume key */
-					xts_set_key(hook->tmp_header.key_2, hook->tmp_header.alg_2, tmp_key);
-					hook->tmp_key = tmp_key;
-
-					/* set re-encryption flag */
-					hook->flags |= F_REENCRYPT; resl = ST_OK;
-				}
-			break;
-		}
-	} while (0);
-
-	return resl;
-}
-
-static int dc_process_sync_packet(
-		     dev_hook *hook, sync_packet *packet, sync_context *ctx)
-{
-	int new_wp = (int)(packet->param);
-	int resl;
-
-	switch (packet->type)
-	{
-		case S_OP_ENC_BLOCK:
-			{
-				if (ctx->finish == 0)
-				{
-					if ( (new_wp != hook->crypt.wp_mode) && (new_wp < WP_NUM) )
-					{
-						dc_wipe_free(&hook->wp_ctx);
-
-						resl = dc_wipe_init(
-							&hook->wp_ctx, hook, ENC_BLOCK_SIZE, new_wp, hook->crypt.cipher_id);
-
-						if (resl == ST_OK) 
-						{
-							hook->crypt.wp_mode = d8(new_wp);
-							dc_save_enc_state(hook, 0);
-						} else {
-							dc_wipe_init(&hook->wp_ctx, hook, ENC_BLOCK_SIZE, WP_NONE, 0);
-						}
-					}
-
-					if (hook->flags & F_REENCRYPT) {
-						resl = dc_re_enc_update(hook);
-					} else {
-						resl = dc_enc_update(hook);
-					}
-
-					if (resl == ST_FINISHED) {
-						dc_save_enc_state(hook, 1); ctx->finish = 1;
-					} else ctx->saved = 0;
-				} else {
-					resl = ST_FINISHED;
-				}
-			}
-		break;
-		case S_OP_DEC_BLOCK:
-			{
-				if (hook->flags & F_REENCRYPT) {
-					resl = ST_ERROR; break;
-				}
-
-				if (ctx->finish == 0)
-				{
-					if ( (resl = dc_dec_update(hook)) == ST_FINISHED) {
-						dc_process_unmount(hook, MF_NOFSCTL | MF_NOSYNC);
-						ctx->finish = 1;
-					} else ctx->saved = 0;
-				} else {
-					resl = ST_FINISHED;
-				}
-			}
-		break;
-		case S_OP_SYNC:
-			{
-				if ( (ctx->finish == 0) && (ctx->saved == 0) ) {
-					dc_save_enc_state(hook, 0); ctx->saved = 1;
-				}
-				resl = ST_OK;
-			}
-		break;
-		case S_OP_FINALIZE:
-			{
-				if ( (ctx->finish == 0) && (ctx->saved == 0) ) {
-					dc_save_enc_state(hook, 0); ctx->finish = 1;
-				}
-				resl = ST_FINISHED;						
-			}
-		break;
-	}
-
-	return resl;
-}
-
-static void dc_sync_op_routine(dev_hook *hook)
-{
-	sync_packet *packet;
-	PLIST_ENTRY  entry;
-	u8          *buff;
-	sync_context sctx;
-	int          resl, init_t;
-	int          del_storage;
-	
-	DbgMsg("sync thread started\n");
-
-	lock_inc(&dc_dump_disable);
-	dc_reference_hook(hook);
-
-	/* initialize sync mode data */
-	InitializeListHead(&hook->sync_req_queue);
-	InitializeListHead(&hook->sync_irp_queue);
-	KeInitializeSpinLock(&hook->sync_req_lock);
-
-	KeInitializeEvent(
-		&hook->sync_req_event, SynchronizationEvent, FALSE);
-
-	/* enable synchronous irp processing */
-	hook->flags |= (F_ENABLED | F_SYNC);
-	
-	zeroauto(&sctx, sizeof(sctx));
-	init_t = hook->sync_init_type;
-	del_storage = 0;
-
-	/* allocate resources */
-	if (buff = mm_alloc(ENC_BLOCK_SIZE, 0))
-	{
-		hook->tmp_buff = buff;
-
-		resl = dc_wipe_init(
-			&hook->wp_ctx, hook, ENC_BLOCK_SIZE, hook->crypt.wp_mode, hook->crypt.cipher_id);
-
-		if (resl == ST_OK) 
-		{
-			sctx.winit = 1;
-			/* init sync mode */
-			resl = dc_init_sync_mode(hook, &sctx);
-		}			 
-	} else {
-		resl = ST_NOMEM;
-	}
-	DbgMsg("sync mode initialized\n");
-	/* save init status */
-	hook->sync_init_status = resl;
-
-	if (resl == ST_OK) 
-	{
-		/* signal of init finished */
-		KeSetEvent(
-			&hook->sync_enter_event, IO_NO_INCREMENT, FALSE);		
-	} else 
-	{
-		if ( (init_t == S_INIT_ENC) || (init_t == S_CONTINUE_ENC) || (init_t == S_CONTINUE_RE_ENC) ) {
-			hook->flags &= ~(F_ENABLED | F_SYNC | F_REENCRYPT | F_PROTECT_DCSYS);
-		} else {
-			hook->flags &= ~F_SYNC;
-		}
-		goto cleanup;
-	}
-
-	do
-	{
-		wait_object_infinity(&hook->sync_req_event);
-
-		do
-		{
-			if (hook->flags & F_SYNC)
-			{
-				while (entry = ExInterlockedRemoveHeadList(&hook->sync_irp_queue, &hook->sync_req_lock))
-				{
-					dc_sync_irp_io(
-						hook, CONTAINING_RECORD(entry, IRP, Tail.Overlay.ListEntry));
-				}
-			}
-
-			if (entry = ExInterlockedRemoveHeadList(&hook->sync_req_queue, &hook->sync_req_lock))
-			{
-				packet = CONTAINING_RECORD(entry, sync_packet, entry_list);
-
-				/* process packet */
-				resl = dc_process_sync_packet(hook, packet, &sctx);
-
-				/* prevent system power state changes */
-				PoSetSystemState(ES_SYSTEM_REQUIRED);
-
-				/* disable synchronous irp processing */
-				if (resl == ST_FINISHED) {
-					del_storage  = !(hook->flags & F_ENABLED) && 
-						            (hook->tmp_header.flags & VF_STORAGE_FILE);
-					hook->flags &= ~(F_SYNC | F_REENCRYPT);					
-				}
-
-				/* signal of packet completion */
-				packet->status = resl;
-				
-				KeSetEvent(
-					&packet->sync_event, IO_NO_INCREMENT, FALSE);
-
-				if ( (resl == ST_MEDIA_CHANGED) || (resl == ST_NO_MEDIA) ) {
-					dc_process_unmount(hook, MF_NOFSCTL | MF_NOSYNC);
-					resl = ST_FINISHED; sctx.finish = 1;
-				}
-			}
-		} while (entry != NULL);
-	} while (hook->flags & F_SYNC);
-cleanup:;
-
-	/* pass all IRPs to default routine */
-	while (entry = ExInterlockedRemoveHeadList(&hook->sync_irp_queue, &hook->sync_req_lock))
-	{
-		dc_read_write_irp(
-			hook, CONTAINING_RECORD(entry, IRP, Tail.Overlay.ListEntry));
-	}
-
-	/* free resources */
-	if (sctx.winit != 0) {
-		dc_wipe_free(&hook->wp_ctx);
-	}
-	if (buff != NULL) {
-		mm_free(buff);
-	}
-	/* stop RW thread if needed */
-	if ( !(hook->flags & F_ENABLED) ) {
-		dc_stop_rw_thread(hook);
-	}
-	/* prevent leaks */
-	wait_object_infinity(&hook->key_lock);
-
-	if (hook->hdr_key != NULL) {
-		mm_free(hook->hdr_key); hook->hdr_key = NULL;
-	}
-	if (hook->tmp_key != NULL) {
-		mm_free(hook->tmp_key); hook->tmp_key = NULL;
-	}
-	zeroauto(&hook->tmp_header, sizeof(hook->tmp_header));
-	KeReleaseMutex(&hook->key_lock, FALSE);
-
-	/* report init finished if initialization fails */
-	if (resl != ST_FINISHED)
-	{
-		KeSetEvent(
-			&hook->sync_enter_event, IO_NO_INCREMENT, FALSE);	
-	}
-
-	if (del_storage != 0) {
-		dc_delete_storage(hook);
-	}
-
-	dc_deref_hook(hook);
-	lock_dec(&dc_dump_disable);
-
-	DbgMsg("exit from sync thread\n");
-
-	PsTerminateSystemThread(STATUS_SUCCESS);
-}
-
-int dc_enable_sync_mode(dev_hook *hook)
-{
-	int resl;
-
-	do
-	{
-		if (hook->flags & F_SYNC) {
-			resl = ST_ERROR; break;
-		}
-
-		KeInitializeEvent(
-			&hook->sync_enter_event, NotificationEvent, FALSE);		
-
-		resl = start_system_thread(dc_sync_op_routine, hook, NULL);
-
-		if (resl == ST_OK) {
-			wait_object_infinity(&hook->sync_enter_event);
-			resl = hook->sync_init_status;						
-		}
-	} while (0);
-
-	return resl;
-}
-
-int dc_send_sync_packet(wchar_t *dev_name, u32 type, void *param)
-{
-	dev_hook    *hook;
-	sync_packet *packet;
-	int          mutex = 0;
-	int          resl;	
-
-	do
-	{
-		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
-			resl = ST_NF_DEVICE; break;
-		}
-
-		wait_object_infinity(&hook->busy_lock);
-
-		if ( !(hook->flags & F_SYNC) ) {			
-			resl = ST_ERROR; break;
-		}
-
-		if ( (hook->flags & F_PREVENT_ENC) && 
-			 ((type == S_OP_ENC_BLOCK) || (type == S_OP_DEC_BLOCK)) )
-		{
-			resl = ST_CANCEL; break;
-		}
-
-		if ( (packet = mm_alloc(sizeof(sync_packet), 0)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-
-		KeInitializeEvent(
-			&packet->sync_event, NotificationEvent, FALSE);
-
-		packet->type  = type;
-		packet->param = param;		
-
-		ExInterlockedInsertTailList(
-			&hook->sync_req_queue, &packet->entry_list, &hook->sync_req_lock);
-
-		KeSetEvent(
-			&hook->sync_req_event, IO_NO_INCREMENT, FALSE);
-
-		KeReleaseMutex(&hook->busy_lock, FALSE);
-
-		wait_object_infinity(&packet->sync_event);
-
-		resl = packet->status; mutex = 1;
-		mm_free(packet);
-	} while (0);
-
-	if (hook != NULL) 
-	{		
-		if (mutex == 0) {
-			KeReleaseMutex(&hook->busy_lock, FALSE);
-		}
-		dc_deref_hook(hook);
-	}
-	return resl;
-}
-
-void dc_sync_all_encs()
-{
-	dev_hook *hook;
-
-	if (hook = dc_first_hook())
-	{
-		do
-		{
-			dc_send_sync_packet(hook->dev_name, S_OP_SYNC, 0);
-		} while (hook = dc_next_hook(hook));
-	}
-}
-
-int dc_encrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt)
-{
-	dc_header *header;
-	dev_hook  *hook;
-	xts_key   *hdr_key;
-	int        resl;
-	u64        storage;
-				
-	DbgMsg("dc_encrypt_start\n");
-
-	header = NULL; hdr_key = NULL;
-	do
-	{
-		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
-			resl = ST_NF_DEVICE; break;
-		}
-
-		wait_object_infinity(&hook->busy_lock);
-		
-		if (hook->flags & (F_ENABLED | F_UNSUPRT | F_DISABLE | F_CDROM)) {
-			resl = ST_ERROR; break;
-		}
-
-		/* verify encryption info */
-		if ( (crypt->cipher_id >= CF_CIPHERS_NUM) || (crypt->wp_mode >= WP_NUM) ) {
-			resl = ST_ERROR; break;
-		}
-
-		/* get device params */
-		if (dc_get_dev_params(hook) != ST_OK) {
-			resl = ST_RW_ERR; break;
-		}
-
-		/* sync device flags with FS filter */
-		dc_fsf_set_flags(hook->dev_name, hook->flags);
-
-		/* create redirection storage */
-		if ( (resl = dc_create_storage(hook, &storage)) != ST_OK ) {
-			break;
-		}
-		DbgMsg("storage created\n");
-
-		if ( (header = mm_alloc(sizeof(dc_header), MEM_SECURE | MEM_ZEROED)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		/* create volume header */
-		rnd_get_bytes(pv(header->salt),     PKCS5_SALT_SIZE);
-		rnd_get_bytes(pv(&header->disk_id), sizeof(u32));
-		rnd_get_bytes(pv(header->key_1),    DISKKEY_SIZE);
-
-		header->sign     = DC_VOLM_SIGN;
-		header->version  = DC_HDR_VERSION;
-		header->flags    = VF_TMP_MODE | VF_STORAGE_FILE;
-		header->alg_1    = crypt->cipher_id;
-		header->stor_off = storage;
-		header->use_size = hook->dsk_size;
-
-		/* initialize volume key */
-		xts_set_key(header->key_1, crypt->cipher_id, &hook->dsk_key);
-		
-		/* initialize header key */
-		dc_init_hdr_key(
-			hdr_key, header, crypt->cipher_id, password);
-
-		hook->crypt          = crypt[0];
-		hook->use_size       = hook->dsk_size;
-		hook->tmp_size       = DC_AREA_SIZE;
-		hook->stor_off       = storage;
-		hook->vf_version     = DC_HDR_VERSION;
-		hook->sync_init_type = S_INIT_ENC;
-		hook->hdr_key        = hdr_key;
-		hook->disk_id        = header->disk_id;
-		hook->flags         |= F_PROTECT_DCSYS;
-
-		/* start syncronous RW helper thread */		
-		if ( (resl = dc_start_rw_thread(hook)) != ST_OK ) {
-			break;
-		}
-		/* copy header to temp buffer */
-		autocpy(&hook->tmp_header, header, sizeof(dc_header));	
-		
-		if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
-		{
-			DbgMsg("sync init error\n");
-			zeroauto(&hook->tmp_header, sizeof(dc_header));	
-			hdr_key = hook->hdr_key;
-		} else {
-			hdr_key = NULL;
-		}
-		/* syncronize with RW thread */
-		KeSetEvent(&hook->rw_init_event, IO_NO_INCREMENT, FALSE);
-		/* sync device flags with FS filter */
-		dc_fsf_set_flags(hook->dev_name, hook->flags);
-	} while (0);
-
-	if (hdr_key != NULL) { mm_free(hdr_key); }
-	if (header != NULL)  { mm_free(header); }
-
-	if (hook != NULL) {
-		KeReleaseMutex(&hook->busy_lock, FALSE);
-		dc_deref_hook(hook);
-	}
-	return resl;
-}
-
-int dc_reencrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt)
-{
-	dc_header *header = NULL;
-	crypt_info o_crypt;
-	dev_hook  *hook;
-	xts_key   *hdr_key = NULL;
-	xts_key   *dsk_key = NULL;
-	int        resl;
-
-	DbgMsg("dc_reencrypt_start\n");
-
-	do
-	{
-		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
-			resl = ST_NF_DEVICE; break;
-		}
-
-		wait_object_infinity(&hook->busy_lock);
-
-		if ( !(hook->flags & F_ENABLED) || 
-			  (hook->flags & (F_SYNC | F_FORMATTING | F_CDROM)) ) 
-		{
-			resl = ST_ERROR; break;
-		}
-
-		/* verify encryption info */
-		if ( (crypt->cipher_id >= CF_CIPHERS_NUM) || (crypt->wp_mode >= WP_NUM) ) {
-			resl = ST_ERROR; break;
-		}
-
-		/* allocate new volume key */
-		if ( (dsk_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		/* allocate new header key */
-		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		if ( (header = mm_alloc(sizeof(dc_header), MEM_SECURE)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-
-		/* read volume header */
-		resl = dc_device_rw(
-			hook, IRP_MJ_READ, header, sizeof(dc_header), 0);
-
-		if (resl != ST_OK) {
-			break;
-		}
-
-		if (dc_decrypt_header(hdr_key, header, password) == 0) {
-			resl = ST_PASS_ERR;	break;
-		}
-
-		/* copy current volume key to secondary key */
-		autocpy(header->key_2, header->key_1, DISKKEY_SIZE);
-
-		/* generate new salt and volume key */
-		rnd_get_bytes(header->salt,  PKCS5_SALT_SIZE);		
-		rnd_get_bytes(header->key_1, DISKKEY_SIZE);
-
-		/* change other fields */
-		header->alg_2  = header->alg_1;
-		header->alg_1  = crypt->cipher_id;
-		header->flags |= VF_REENCRYPT;
-
-		/* initialize new header key */
-		dc_init_hdr_key(
-			hdr_key, header, header->alg_1, password);
-
-		/* initialize new volume key */
-		xts_set_key(header->key_1, header->alg_1, dsk_key);
-
-		/* save old encryption info */
-		o_crypt = hook->crypt;
-		/* set new encryption info */		
-		hook->crypt          = *crypt;
-		hook->tmp_size       = 0;
-		hook->sync_init_type = S_INIT_RE_ENC;
-		hook->hdr_key        = hdr_key;
-		hook->tmp_key        = dsk_key;
-		
-		/* copy header to temp buffer */
-		autocpy(&hook->tmp_header, header, sizeof(dc_header));
-		
-		if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
-		{
-			zeroauto(&hook->tmp_header, sizeof(dc_header));	
-			hdr_key = hook->hdr_key;
-			dsk_key = hook->tmp_key;
-			/* restore encryption info */
-			hook->crypt = o_crypt;
-		} else {
-			hdr_key = NULL;
-			dsk_key = NULL;
-		}
-	} while (0);
-
-	if (dsk_key != NULL) { mm_free(dsk_key); }
-	if (hdr_key != NULL) { mm_free(hdr_key); }
-	if (header != NULL)  { mm_free(header); }
-
-	if (hook != NULL) {
-		KeReleaseMutex(&hook->busy_lock, FALSE);
-		dc_deref_hook(hook);
-	}
-	return resl;
-}
-
-int dc_decrypt_start(wchar_t *dev_name, dc_pass *password)
-{
-	dc_header *header = NULL;
-	dev_hook  *hook;
-	xts_key   *hdr_key = NULL;
-	int        resl;
-				
-	DbgMsg("dc_decrypt_start\n");
-
-	do
-	{
-		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
-			resl = ST_NF_DEVICE; break;
-		}
-
-		wait_object_infinity(&hook->busy_lock);
-		
-		if ( !(hook->flags & F_ENABLED) || 
-			  (hook->flags & (F_SYNC | F_FORMATTING | F_CDROM)) ) 
-		{
-			resl = ST_ERROR; break;
-		}
-		if ( (header = mm_alloc(sizeof(dc_header), MEM_SECURE)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-
-		/* read volume header */
-		resl = dc_device_rw(
-			hook, IRP_MJ_READ, header, sizeof(dc_header), 0);
-
-		if (resl != ST_OK) {
-			break;
-		}
-
-		/* decrypt volume header */
-		if (dc_decrypt_header(hdr_key, header, password) == 0) {
-			resl = ST_PASS_ERR;	break;
-		}
-
-		hook->crypt.cipher_id = d8(header->alg_1);
-		hook->crypt.wp_mode   = WP_NONE;
-		
-		/* copy header to temp buffer */
-		autocpy(&hook->tmp_header, header, sizeof(dc_header));
-
-		hook->tmp_size       = hook->dsk_size;
-		hook->sync_init_type = S_INIT_DEC;
-		hook->hdr_key        = hdr_key;
-		
-		if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
-		{
-			zeroauto(&hook->tmp_header, sizeof(dc_header));
-			hdr_key = hook->hdr_key;
-		} else {
-			hdr_key = NULL;
-		}
-	} while (0);
-
-	if (hdr_key != NULL) { mm_free(hdr_key); }
-	if (header != NULL)  { mm_free(header); }
-
-	if (hook != NULL) {
-		KeReleaseMutex(&hook->busy_lock, FALSE);
-		dc_deref_hook(hook);
-	}
-	return resl;
-}
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2007-2009 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ntifs.h>
+#include "defines.h"
+#include "devhook.h"
+#include "driver.h"
+#include "prng.h"
+#include "misc.h"
+#include "readwrite.h"
+#include "crc32.h"
+#include "pkcs5.h"
+#include "mount.h"
+#include "enc_dec.h"
+#include "data_wipe.h"
+#include "misc_irp.h"
+#include "fast_crypt.h"
+#include "misc_volume.h"
+#include "debug.h"
+#include "storage.h"
+#include "fsf_control.h"
+#include "crypto_head.h"
+#include "misc_mem.h"
+
+typedef struct _sync_struct {
+	KEVENT sync_event;
+	int    status;
+
+} sync_struct;
+
+typedef struct _sync_context {
+	int finish;
+	int done;     /* conversion completed, finish also set on unmount */
+	int saved;
+	int winit;
+	u32 fg_count; /* foreground requests processed */
+	u32 fg_lat;   /* summary foreground latency */
+	u32 fg_depth; /* maximum foreground queue depth */
+	u32 run_steps; /* blocks processed in autonomous mode */
+
+} sync_context;
+
+#define BB_STACK_DEPTH 32 /* enough for 2^31 sectors range */
+
+typedef struct _bad_probe {
+	u64 offset;
+	u32 size;
+	int fails; /* range already known as failed */
+	int left;  /* range is left half of splitted range */
+
+} bad_probe;
+
+static void dc_add_bad_range(dev_hook *hook, u64 offset, u32 size)
+{
+	dc_bad_range *rng = hook->bad_range;
+	u64           end = offset + size;
+	KIRQL         irql;
+	u32           i, j;
+
+	KeAcquireSpinLock(&hook->bad_lock, &irql);
+
+	/* find first range which is not fully below new range */
+	for (i = 0; (i < hook->bad_count) && (rng[i].offset + rng[i].size < offset); i++);
+
+	if ( (i < hook->bad_count) && (rng[i].offset <= end) )
+	{
+		/* merge new range with all overlapped or adjacent ranges */
+		offset = min(offset, rng[i].offset);
+		end    = max(end, rng[i].offset + rng[i].size);
+
+		for (j = i + 1; (j < hook->bad_count) && (rng[j].offset <= end); j++) {
+			end = max(end, rng[j].offset + rng[j].size);
+		}
+		rng[i].offset = offset;
+		rng[i].size   = end - offset;
+
+		memmove(&rng[i + 1], &rng[j], (hook->bad_count - j) * sizeof(dc_bad_range));
+		hook->bad_count -= j - (i + 1);
+	} else if (hook->bad_count < MAX_BAD_RANGES)
+	{
+		memmove(&rng[i + 1], &rng[i], (hook->bad_count - i) * sizeof(dc_bad_range));
+		rng[i].offset = offset;
+		rng[i].size   = size;
+		hook->bad_count++;
+	} else {
+		hook->bad_lost++;
+	}
+	KeReleaseSpinLock(&hook->bad_lock, irql);
+}
+
+static int dc_find_bad_range(dev_hook *hook, u64 offset, u32 size, u64 *b_off, u64 *b_end)
+{
+	dc_bad_range *rng = hook->bad_range;
+	KIRQL         irql;
+	u32           i;
+	int           found = 0;
+
+	if (hook->bad_count == 0) {
+		return 0;
+	}
+	KeAcquireSpinLock(&hook->bad_lock, &irql);
+
+	for (i = 0; i < hook->bad_count; i++)
+	{
+		if (rng[i].offset >= offset + size) {
+			break;
+		}
+		if (rng[i].offset + rng[i].size > offset) {
+			b_off[0] = rng[i].offset;
+			b_end[0] = rng[i].offset + rng[i].size;
+			found    = 1; break;
+		}
+	}
+	KeReleaseSpinLock(&hook->bad_lock, irql);
+
+	return found;
+}
+
+/*
+   locate bad sectors inside failed range by recursive halving,
+   if left half is readable then right half is failed without check
+*/
+static
+int dc_bisect_bads(
+	   dev_hook *hook, u32 function, void *buff, u32 size, u64 offset
+	   )
+{
+	bad_probe stack[BB_STACK_DEPTH];
+	bad_probe prb;
+	u32       unit = hook->bps != 0 ? hook->bps : SECTOR_SIZE;
+	u32       half;
+	int       top, resl;
+
+	stack[0].offset = offset, stack[0].size = size;
+	stack[0].fails  = 1, stack[0].left = 0; top = 1;
+
+	while (top != 0)
+	{
+		prb = stack[--top];
+
+		if (prb.fails == 0)
+		{
+			resl = dc_device_rw(
+				hook, function, p8(buff) + d32(prb.offset - offset), prb.size, prb.offset);
+
+			if (resl == ST_OK)
+			{
+				if (prb.left != 0) {
+					/* right sibling is at top of stack */
+					stack[top - 1].fails = 1;
+				}
+				continue;
+			}
+			if (resl != ST_RW_ERR) {
+				return resl;
+			}
+		}
+
+		if ( (prb.size <= unit) || (top + 2 > BB_STACK_DEPTH) ) {
+			dc_add_bad_range(hook, prb.offset, prb.size); continue;
+		}
+		half = max(unit, (prb.size / 2) & ~(unit - 1));
+
+		stack[top].offset = prb.offset + half, stack[top].size = prb.size - half;
+		stack[top].fails  = 0, stack[top].left = 0; top++;
+		stack[top].offset = prb.offset, stack[top].size = half;
+		stack[top].fails  = 0, stack[top].left = 1; top++;
+	}
+	return ST_RW_ERR;
+}
+
+/* zero parts of buffer which can not be readed from known bad regions */
+static void dc_zero_bads(dev_hook *hook, void *buff, u32 size, u64 offset)
+{
+	u64 b_off, b_end;
+	u64 pos = offset, end = offset + size;
+
+	while ( (pos < end) && (dc_find_bad_range(hook, pos, d32(end - pos), &b_off, &b_end) != 0) )
+	{
+		b_off = max(b_off, pos);
+		b_end = min(b_end, end);
+
+		zeromem(p8(buff) + d32(b_off - offset), d32(b_end - b_off));
+		pos = b_end;
+	}
+}
+
+/*
+   reads skip known bad regions and return zeroes for them,
+   writes are always issued for full range to give the drive
+   chance to reallocate bad sectors
+*/
+static
+int dc_device_rw_skip_bads(
+	   dev_hook *hook, u32 function, void *buff, u32 size, u64 offset
+	   )
+{
+	void *r_buff = buff;
+	u32   r_size = size;
+	u64   r_offs = offset;
+	u64   b_off, b_end;
+	u32   block;
+	int   resl, succs;
+
+	for (succs = ST_OK; size != 0; buff = p8(buff) + block, size -= block, offset += block)
+	{
+		if ( (function == IRP_MJ_READ) && (dc_find_bad_range(hook, offset, size, &b_off, &b_end) != 0) )
+		{
+			if (b_off <= offset) {
+				/* skip known bad region without I/O */
+				block = d32(min(b_end - offset, size));
+				succs = ST_RW_ERR; continue;
+			}
+			block = d32(b_off - offset);
+		} else {
+			block = size;
+		}
+
+		if ( (resl = dc_device_rw(hook, function, buff, block, offset)) == ST_RW_ERR ) {
+			resl = dc_bisect_bads(hook, function, buff, block, offset);
+		}
+		if (resl == ST_RW_ERR) {
+			succs = resl; continue;
+		}
+		if (resl != ST_OK) {
+			return resl;
+		}
+	}
+	if ( (function == IRP_MJ_READ) && (succs == ST_RW_ERR) ) {
+		dc_zero_bads(hook, r_buff, r_size, r_offs);
+	}
+	return succs;
+}
+
+void dc_reset_bad_blocks(dev_hook *hook)
+{
+	KIRQL irql;
+
+	KeAcquireSpinLock(&hook->bad_lock, &irql);
+	hook->bad_count = 0;
+	hook->bad_lost  = 0;
+	KeReleaseSpinLock(&hook->bad_lock, irql);
+}
+
+int dc_conversion_run(wchar_t *dev_name, u32 mode, u32 wp_mode, HANDLE h_event)
+{
+	dc_run_ctl run;
+	dev_hook  *hook;
+	void      *event = NULL;
+	NTSTATUS   status;
+	int        resl, format;
+
+	if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+		return ST_NF_DEVICE;
+	}
+	format = (hook->flags & F_FORMATTING) != 0;
+	dc_deref_hook(hook);
+
+	if (h_event != NULL)
+	{
+		status = ObReferenceObjectByHandle(
+			h_event, EVENT_MODIFY_STATE, *ExEventObjectType, UserMode, &event, NULL);
+
+		if (NT_SUCCESS(status) == FALSE) {
+			return ST_ERROR;
+		}
+	}
+	if ( (mode == RUN_FORMAT) || (mode == RUN_NONE && format != 0) ) {
+		resl = dc_format_run(dev_name, mode, wp_mode, &event);
+	} else
+	{
+		run.mode    = mode;
+		run.wp_mode = wp_mode;
+		run.h_event = event;
+
+		resl  = dc_send_sync_packet(dev_name, S_OP_RUN, &run);
+		event = run.h_event;
+	}
+	/* release event if it not used */
+	if (event != NULL) {
+		ObDereferenceObject(event);
+	}
+	return resl;
+}
+
+int dc_set_throttle(wchar_t *dev_name, u32 max_latency, u32 max_speed)
+{
+	dev_hook *hook;
+
+	if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+		return ST_NF_DEVICE;
+	}
+	throttle_set(&hook->sync_thr, max_latency * 1000, max_speed);
+	dc_deref_hook(hook);
+
+	return ST_OK;
+}
+
+int dc_get_bad_blocks(wchar_t *dev_name, dc_bad_ctl *ctl)
+{
+	dev_hook *hook;
+	KIRQL     irql;
+
+	if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+		return ST_NF_DEVICE;
+	}
+	KeAcquireSpinLock(&hook->bad_lock, &irql);
+
+	ctl->count = hook->bad_count;
+	ctl->lost  = hook->bad_lost;
+	autocpy(ctl->range, hook->bad_range, sizeof(ctl->range));
+
+	KeReleaseSpinLock(&hook->bad_lock, irql);
+	dc_deref_hook(hook);
+
+	return ST_OK;
+}
+
+static int dc_enc_update(dev_hook *hook)
+{
+	u8 *buff = hook->tmp_buff;
+	u64 offs = hook->tmp_size;
+	u32 size = d32(min(hook->dsk_size - offs, hook->sync_thr.chunk));
+	int r_resl, w_resl;
+
+	if (size == 0) {
+		return ST_FINISHED;
+	}
+
+	do
+	{
+		r_resl = dc_device_rw_skip_bads(
+			hook, IRP_MJ_READ, buff, size, offs);
+
+		if ( (r_resl != ST_OK) && (r_resl != ST_RW_ERR) ) {
+			break;
+		}
+		
+		dc_fast_encrypt(buff, buff, size, offs, hook->dsk_key);
+
+		dc_wipe_process(&hook->wp_ctx, offs, size);
+
+		w_resl = dc_device_rw_skip_bads(
+			hook, IRP_MJ_WRITE, buff, size, offs);
+
+		if (w_resl == ST_RW_ERR) {
+			r_resl = w_resl;
+		}
+	} while (0);
+
+	if ( (r_resl == ST_OK) || (r_resl == ST_RW_ERR) ) {
+		hook->tmp_size += size;
+	}
+	
+	return r_resl;
+}
+
+static int dc_re_enc_update(dev_hook *hook)
+{
+	u8 *buff = hook->tmp_buff;
+	u64 offs = hook->tmp_size;
+	u32 size = d32(min(hook->dsk_size - offs, hook->sync_thr.chunk));	
+	int r_resl, w_resl;
+	
+	if (size == 0) {
+		return ST_FINISHED;
+	}
+
+	do
+	{
+		r_resl = dc_device_rw_skip_bads(
+			hook, IRP_MJ_READ, buff, size, offs);
+
+		if ( (r_resl != ST_OK) && (r_resl != ST_RW_ERR) ) {
+			break;
+		}
+
+		/* wipe old data */
+		dc_wipe_process(&hook->wp_ctx, offs, size);
+
+		/* re-encrypt data */
+		dc_fast_decrypt(buff, buff, size, offs, hook->tmp_key);
+		dc_fast_encrypt(buff, buff, size, offs, hook->dsk_key);
+
+		w_resl = dc_device_rw_skip_bads(
+			hook, IRP_MJ_WRITE, buff, size, offs);
+
+		if (w_resl == ST_RW_ERR) {
+			r_resl = w_resl;
+		}
+	} while (0);
+
+	if ( (r_resl == ST_OK) || (r_resl == ST_RW_ERR) ) {
+		hook->tmp_size += size;
+	}
+
+	return r_resl;
+}
+
+
+static int dc_dec_update(dev_hook *hook)
+{
+	NTSTATUS status;
+	u8      *buff = hook->tmp_buff;
+	u32      size = d32(min(hook->tmp_size, hook->sync_thr.chunk));
+	u64      offs = hook->tmp_size - size;
+	int      r_resl, w_resl;
+	
+	if (size == 0)
+	{
+		/* write redirected part back to zero offset */
+		status = dc_sync_encrypted_io(
+			hook, buff, DC_AREA_SIZE, 0, SL_OVERRIDE_VERIFY_VOLUME, IRP_MJ_READ);
+
+		if (NT_SUCCESS(status) == FALSE) {
+			return ST_RW_ERR;
+		}
+
+		w_resl = dc_device_rw(
+			hook, IRP_MJ_WRITE, buff, DC_AREA_SIZE, 0);
+
+		if (w_resl == ST_OK) {
+			w_resl = ST_FINISHED;
+		}
+
+		return w_resl;
+	}
+
+	do
+	{
+		r_resl = dc_device_rw_skip_bads(
+			hook, IRP_MJ_READ, buff, size, offs);
+		
+		if ( (r_resl != ST_OK) && (r_resl != ST_RW_ERR) ) {
+			break;
+		}
+
+		dc_fast_decrypt(
+			buff, buff, size, offs, hook->dsk_key);
+
+		w_resl = dc_device_rw_skip_bads(
+			hook, IRP_MJ_WRITE, buff, size, offs);
+
+		if (w_resl == ST_RW_ERR) {
+			r_resl = w_resl;
+		}
+	} while (0);
+
+	if ( (r_resl == ST_OK) || (r_resl == ST_RW_ERR) ) {
+		hook->tmp_size -= size;
+	}
+
+	return r_resl;
+}
+
+static void dc_save_enc_state(dev_hook *hook, int finish)
+{
+	dc_header *header;
+		
+	DbgMsg("dc_save_enc_state\n");
+
+	header = mm_alloc(sizeof(dc_header), MEM_FAST | MEM_SUCCESS | MEM_SECURE);
+
+	if (header == NULL) {
+		return;
+	}
+	/* copy volume header */
+	autocpy(header, &hook->tmp_header, sizeof(dc_header));
+
+	if (finish != 0)
+	{
+		header->flags      &= ~(VF_TMP_MODE | VF_REENCRYPT);
+		header->tmp_size    = 0;
+		header->tmp_wp_mode = 0;
+
+		if (hook->flags & F_REENCRYPT) {
+			zeroauto(header->key_2, DISKKEY_SIZE); 
+			header->alg_2 = 0;
+			header->unit_size_2 = 0;
+		}
+		DC_SET_HDR_SIGN(header);
+		hook->vf_version = header->version;
+	} else 
+	{
+		header->flags      |= VF_TMP_MODE;
+		header->tmp_size    = hook->tmp_size;
+		header->tmp_wp_mode = hook->crypt.wp_mode;
+
+		if (hook->flags & F_REENCRYPT) {
+			header->flags |= VF_REENCRYPT;
+		} 
+	}
+
+	header->hdr_crc = crc32(pv(&header->version), DC_CRC_AREA_SIZE);
+
+	/* encrypt volume header */
+	xts_encrypt(pv(header), pv(header), sizeof(dc_header), 0, hook->hdr_key);
+
+	/* save original salt */
+	autocpy(header->salt, hook->tmp_header.salt, PKCS5_SALT_SIZE);
+	
+	/* write volume header */
+	dc_device_rw(hook, IRP_MJ_WRITE, header, sizeof(dc_header), 0);
+
+	/* free memory */
+	mm_free(header);
+	/* report saved progress to DC_CTL_ENUM clients */
+	dc_hooks_changed();
+}
+
+
+static int dc_init_sync_mode(dev_hook *hook, sync_context *ctx)
+{
+	NTSTATUS status;
+	xts_key *tmp_key;
+	u8      *buff = hook->tmp_buff;
+	int      resl;
+	
+	do
+	{
+		switch (lock_xchg(&hook->sync_init_type, 0))
+		{
+			case S_INIT_ENC:
+				{
+					/* initialize encryption process */
+					
+					/* save old sectors */
+					resl = dc_device_rw(
+						hook, IRP_MJ_READ, buff, DC_AREA_SIZE, 0);
+
+					if (resl != ST_OK) {
+						break;
+					}
+
+					status = dc_sync_encrypted_io(
+						hook, buff, DC_AREA_SIZE, 0, SL_OVERRIDE_VERIFY_VOLUME, IRP_MJ_WRITE);
+
+					if (NT_SUCCESS(status) == FALSE) {
+						resl = ST_RW_ERR; break;
+					}
+					
+					/* wipe old sectors */
+					dc_wipe_process(&hook->wp_ctx, 0, DC_AREA_SIZE);
+					/* save initial state */
+					dc_save_enc_state(hook, 0);
+				}
+			break;
+			case S_INIT_DEC:
+			case S_CONTINUE_ENC: 
+				{
+					resl = ST_OK;
+				}
+			break;
+			case S_INIT_RE_ENC:
+				{
+					DbgMsg("S_INIT_RE_ENC\n");
+
+					/* swap keys, old key block stays allocated as secondary key */
+					tmp_key       = hook->dsk_key;
+					hook->dsk_key = hook->tmp_key;
+					hook->tmp_key = tmp_key;
+
+					/* set re-encryption flag */
+					hook->flags |= F_REENCRYPT;
+					/* wipe old volume header */
+					dc_wipe_process(&hook->wp_ctx, 0, DC_AREA_SIZE);
+					/* save initial state */
+					dc_save_enc_state(hook, 0);
+					
+					resl = ST_OK;
+				}
+			break;
+			case S_CONTINUE_RE_ENC:
+				{
+					DbgMsg("S_CONTINUE_RE_ENC\n");
+
+					if ( (tmp_key = mm_alloc(xts_key_size(hook->tmp_header.alg_2), MEM_SECURE)) == NULL ) {
+						resl = ST_NOMEM; break;
+					}
+
+					/* initialize secondary volume key */
+					xts_set_key(hook->tmp_header.key_2, hook->tmp_header.alg_2, tmp_key);
+					xts_set_unit(tmp_key, DC_UNIT_SIZE(&hook->tmp_header, unit_size_2));
+					hook->tmp_key = tmp_key;
+
+					/* set re-encryption flag */
+					hook->flags |= F_REENCRYPT; resl = ST_OK;
+				}
+			break;
+		}
+	} while (0);
+
+	return resl;
+}
+
+static void dc_sync_process_irps(dev_hook *hook, sync_context *ctx)
+{
+	PLIST_ENTRY entry;
+	PIRP        irp;
+	u32         start, depth;
+
+	for (depth = 0; entry = ExInterlockedRemoveHeadList(&hook->sync_irp_queue, &hook->sync_req_lock); depth++)
+	{
+		irp   = CONTAINING_RECORD(entry, IRP, Tail.Overlay.ListEntry);
+		start = d32((ULONG_PTR)irp->Tail.Overlay.DriverContext[0]);
+
+		dc_sync_irp_io(hook, irp);
+
+		ctx->fg_count++;
+		ctx->fg_lat += dc_get_time_us() - start;
+	}
+	ctx->fg_depth = max(ctx->fg_depth, depth);
+}
+
+static void dc_throttle_wait(dev_hook *hook, sync_context *ctx)
+{
+	LARGE_INTEGER time;
+	u32           start = dc_get_time_us();
+	u32           delay = hook->sync_thr.delay;
+	u32           spent;
+
+	/* serve foreground requests while waiting */
+	while ( (spent = dc_get_time_us() - start) < delay )
+	{
+		time.QuadPart = d64(delay - spent) * -10;
+
+		KeWaitForSingleObject(
+			&hook->sync_req_event, Executive, KernelMode, FALSE, &time);
+
+		dc_sync_process_irps(hook, ctx);
+	}
+}
+
+static int dc_throttled_update(dev_hook *hook, sync_context *ctx, int (*update)(dev_hook*))
+{
+	u32 start;
+	int resl;
+
+	dc_throttle_wait(hook, ctx);
+
+	start = dc_get_time_us();
+	resl  = update(hook);
+	
+	throttle_update(
+		&hook->sync_thr, ctx->fg_count, ctx->fg_lat, ctx->fg_depth, dc_get_time_us() - start);
+
+	ctx->fg_count = 0, ctx->fg_lat = 0, ctx->fg_depth = 0;
+	
+	return resl;
+}
+
+static int dc_process_sync_packet(
+		     dev_hook *hook, sync_packet *packet, sync_context *ctx)
+{
+	int new_wp = (int)(packet->param);
+	int resl;
+
+	switch (packet->type)
+	{
+		case S_OP_ENC_BLOCK:
+			{
+				if (ctx->finish == 0)
+				{
+					if ( (new_wp != hook->crypt.wp_mode) && (new_wp < WP_NUM) )
+					{
+						dc_wipe_free(&hook->wp_ctx);
+
+						resl = dc_wipe_init(
+							&hook->wp_ctx, hook, ENC_BLOCK_SIZE, new_wp, hook->crypt.cipher_id);
+
+						if (resl == ST_OK) 
+						{
+							hook->crypt.wp_mode = d8(new_wp);
+							dc_save_enc_state(hook, 0);
+						} else {
+							dc_wipe_init(&hook->wp_ctx, hook, ENC_BLOCK_SIZE, WP_NONE, 0);
+						}
+					}
+
+					if (hook->flags & F_REENCRYPT) {
+						resl = dc_throttled_update(hook, ctx, dc_re_enc_update);
+					} else {
+						resl = dc_throttled_update(hook, ctx, dc_enc_update);
+					}
+
+					if (resl == ST_FINISHED) {
+						dc_save_enc_state(hook, 1); ctx->finish = 1; ctx->done = 1;
+					} else ctx->saved = 0;
+				} else {
+					resl = ST_FINISHED;
+				}
+			}
+		break;
+		case S_OP_DEC_BLOCK:
+			{
+				if (hook->flags & F_REENCRYPT) {
+					resl = ST_ERROR; break;
+				}
+
+				if (ctx->finish == 0)
+				{
+					if ( (resl = dc_throttled_update(hook, ctx, dc_dec_update)) == ST_FINISHED) {
+						dc_process_unmount(hook, MF_NOFSCTL | MF_NOSYNC);
+						ctx->finish = 1; ctx->done = 1;
+					} else ctx->saved = 0;
+				} else {
+					resl = ST_FINISHED;
+				}
+			}
+		break;
+		case S_OP_SYNC:
+			{
+				if ( (ctx->finish == 0) && (ctx->saved == 0) ) {
+					dc_save_enc_state(hook, 0); ctx->saved = 1;
+				}
+				resl = ST_OK;
+			}
+		break;
+		case S_OP_FINALIZE:
+			{
+				if ( (ctx->finish == 0) && (ctx->saved == 0) ) {
+					dc_save_enc_state(hook, 0); ctx->finish = 1;
+				}
+				resl = ST_FINISHED;						
+			}
+		break;
+		case S_OP_RUN:
+			{
+				dc_run_ctl *run = packet->param;
+
+				if (run->mode == RUN_NONE)
+				{
+					if (hook->sync_run != RUN_NONE) {
+						dc_run_finish(hook, ST_OK);
+					}
+					resl = ST_OK; break;
+				}
+				if (ctx->finish != 0) {
+					resl = ST_FINISHED; break;
+				}
+				if (hook->sync_run != RUN_NONE) {
+					resl = ST_DEVICE_BUSY; break;
+				}
+				if ( (run->mode != RUN_ENCRYPT) && (run->mode != RUN_DECRYPT) ||
+					 (run->mode == RUN_DECRYPT) && (hook->flags & F_REENCRYPT) ) 
+				{
+					resl = ST_ERROR; break;
+				}
+				/* take event ownership */
+				hook->sync_run_event  = run->h_event; run->h_event = NULL;
+				hook->sync_run_wp     = run->wp_mode;
+				hook->sync_run_status = ST_OK;
+				hook->sync_run        = run->mode;
+				ctx->run_steps        = 0;
+				resl                  = ST_OK;
+				dc_hooks_changed();
+			}
+		break;
+	}
+
+	return resl;
+}
+
+static int dc_sync_run_ready(dev_hook *hook, sync_context *ctx)
+{
+	return (hook->sync_run != RUN_NONE) && (ctx->finish == 0) &&
+		   (hook->flags & F_SYNC) && !(hook->flags & F_PREVENT_ENC);
+}
+
+static void dc_sync_run_done(dev_hook *hook, sync_context *ctx, int resl)
+{
+	if ( (resl != ST_OK) && (resl != ST_RW_ERR) ) {
+		dc_run_finish(hook, resl); return;
+	}
+	/* periodically save encryption state and report progress */
+	if (++ctx->run_steps % S_RUN_SAVE_STEPS == 0)
+	{
+		if (ctx->saved == 0) {
+			dc_save_enc_state(hook, 0); ctx->saved = 1;
+		}
+		dc_run_notify(hook);
+	}
+}
+
+void dc_run_notify(dev_hook *hook)
+{
+	if (hook->sync_run_event != NULL) {
+		KeSetEvent(hook->sync_run_event, IO_NO_INCREMENT, FALSE);
+	}
+}
+
+void dc_run_finish(dev_hook *hook, int status)
+{
+	hook->sync_run_status = status;
+	
+	if (hook->sync_run_event != NULL) {
+		KeSetEvent(hook->sync_run_event, IO_NO_INCREMENT, FALSE);
+		ObDereferenceObject(hook->sync_run_event);
+		hook->sync_run_event = NULL;
+	}
+	hook->sync_run = RUN_NONE;
+	dc_hooks_changed();
+}
+
+static void dc_sync_op_routine(dev_hook *hook)
+{
+	sync_packet  *packet;
+	sync_packet   run_pk;
+	PLIST_ENTRY   entry;
+	LARGE_INTEGER timeout;
+	u8           *buff;
+	sync_context  sctx;
+	int           resl, init_t;
+	int           del_storage;
+	
+	DbgMsg("sync thread started\n");
+
+	lock_inc(&dc_dump_disable);
+	dc_reference_hook(hook);
+
+	/* initialize sync mode data */
+	InitializeListHead(&hook->sync_req_queue);
+	InitializeListHead(&hook->sync_irp_queue);
+	KeInitializeSpinLock(&hook->sync_req_lock);
+
+	KeInitializeEvent(
+		&hook->sync_req_event, SynchronizationEvent, FALSE);
+
+	/* enable synchronous irp processing */
+	hook->flags |= (F_ENABLED | F_SYNC);
+	
+	zeroauto(&sctx, sizeof(sctx));
+	init_t = hook->sync_init_type;
+	del_storage = 0;
+
+	throttle_reset(&hook->sync_thr, S_MIN_CHUNK, ENC_BLOCK_SIZE);
+
+	/* allocate resources */
+	if (buff = mm_alloc(ENC_BLOCK_SIZE, 0))
+	{
+		hook->tmp_buff = buff;
+
+		resl = dc_wipe_init(
+			&hook->wp_ctx, hook, ENC_BLOCK_SIZE, hook->crypt.wp_mode, hook->crypt.cipher_id);
+
+		if (resl == ST_OK) 
+		{
+			sctx.winit = 1;
+			/* init sync mode */
+			resl = dc_init_sync_mode(hook, &sctx);
+		}			 
+	} else {
+		resl = ST_NOMEM;
+	}
+	DbgMsg("sync mode initialized\n");
+	/* save init status */
+	hook->sync_init_status = resl;
+
+	if (resl == ST_OK) 
+	{
+		dc_hooks_changed();
+		/* signal of init finished */
+		KeSetEvent(
+			&hook->sync_enter_event, IO_NO_INCREMENT, FALSE);		
+	} else 
+	{
+		if ( (init_t == S_INIT_ENC) || (init_t == S_CONTINUE_ENC) || (init_t == S_CONTINUE_RE_ENC) ) {
+			hook->flags &= ~(F_ENABLED | F_SYNC | F_REENCRYPT | F_PROTECT_DCSYS);
+		} else {
+			hook->flags &= ~F_SYNC;
+		}
+		dc_hooks_changed();
+		goto cleanup;
+	}
+
+	do
+	{
+		if (hook->sync_run == RUN_NONE) {
+			wait_object_infinity(&hook->sync_req_event);
+		} else if (dc_sync_run_ready(hook, &sctx) == 0) 
+		{
+			/* autonomous conversion paused */
+			timeout.QuadPart = -10000000; /* 1 sec */
+
+			KeWaitForSingleObject(
+				&hook->sync_req_event, Executive, KernelMode, FALSE, &timeout);
+		}
+
+		do
+		{
+			if (hook->flags & F_SYNC) {
+				dc_sync_process_irps(hook, &sctx);
+			}
+
+			if (entry = ExInterlockedRemoveHeadList(&hook->sync_req_queue, &hook->sync_req_lock)) {
+				packet = CONTAINING_RECORD(entry, sync_packet, entry_list);
+			} else if (dc_sync_run_ready(hook, &sctx) != 0)
+			{
+				/* process next block in autonomous mode */
+				run_pk.type  = hook->sync_run == RUN_ENCRYPT ? S_OP_ENC_BLOCK : S_OP_DEC_BLOCK;
+				run_pk.param = pv(hook->sync_run_wp);
+				packet       = &run_pk;
+			} else {
+				packet = NULL;
+			}
+
+			if (packet != NULL)
+			{
+				/* process packet */
+				resl = dc_process_sync_packet(hook, packet, &sctx);
+
+				/* prevent system power state changes */
+				PoSetSystemState(ES_SYSTEM_REQUIRED);
+
+				/* disable synchronous irp processing */
+				if (resl == ST_FINISHED) {
+					del_storage  = !(hook->flags & F_ENABLED) && 
+						            (hook->tmp_header.flags & VF_STORAGE_FILE);
+					hook->flags &= ~(F_SYNC | F_REENCRYPT);
+					dc_hooks_changed();
+				}
+
+				if (packet != &run_pk)
+				{
+					/* signal of packet completion */
+					packet->status = resl;
+					
+					KeSetEvent(
+						&packet->sync_event, IO_NO_INCREMENT, FALSE);
+				} else {
+					dc_sync_run_done(hook, &sctx, resl);
+				}
+
+				if ( (resl == ST_MEDIA_CHANGED) || (resl == ST_NO_MEDIA) ) {
+					if (hook->sync_run != RUN_NONE) {
+						dc_run_finish(hook, resl);
+					}
+					dc_process_unmount(hook, MF_NOFSCTL | MF_NOSYNC);
+					resl = ST_FINISHED; sctx.finish = 1;
+				}
+			}
+		} while (packet != NULL);
+	} while (hook->flags & F_SYNC);
+cleanup:;
+
+	/* stop autonomous conversion if sync mode leaved */
+	if (hook->sync_run != RUN_NONE) {
+		dc_run_finish(hook, sctx.done != 0 ? ST_FINISHED : ST_CANCEL);
+	}
+
+	/* pass all IRPs to default routine */
+	while (entry = ExInterlockedRemoveHeadList(&hook->sync_irp_queue, &hook->sync_req_lock))
+	{
+		dc_read_write_irp(
+			hook, CONTAINING_RECORD(entry, IRP, Tail.Overlay.ListEntry));
+	}
+
+	/* free resources */
+	if (sctx.winit != 0) {
+		dc_wipe_free(&hook->wp_ctx);
+	}
+	if (buff != NULL) {
+		mm_free(buff);
+	}
+	/* stop RW thread if needed */
+	if ( !(hook->flags & F_ENABLED) ) {
+		dc_stop_rw_thread(hook);
+	}
+	/* prevent leaks */
+	wait_object_infinity(&hook->key_lock);
+
+	if (hook->hdr_key != NULL) {
+		mm_free(hook->hdr_key); hook->hdr_key = NULL;
+	}
+	if (hook->tmp_key != NULL) {
+		mm_free(hook->tmp_key); hook->tmp_key = NULL;
+	}
+	zeroauto(&hook->tmp_header, sizeof(hook->tmp_header));
+	KeReleaseMutex(&hook->key_lock, FALSE);
+
+	/* report init finished if initialization fails */
+	if (resl != ST_FINISHED)
+	{
+		KeSetEvent(
+			&hook->sync_enter_event, IO_NO_INCREMENT, FALSE);	
+	}
+
+	if (del_storage != 0) {
+		dc_delete_storage(hook);
+	}
+
+	dc_deref_hook(hook);
+	lock_dec(&dc_dump_disable);
+
+	DbgMsg("exit from sync thread\n");
+
+	PsTerminateSystemThread(STATUS_SUCCESS);
+}
+
+int dc_enable_sync_mode(dev_hook *hook)
+{
+	int resl;
+
+	do
+	{
+		if (hook->flags & F_SYNC) {
+			resl = ST_ERROR; break;
+		}
+
+		KeInitializeEvent(
+			&hook->sync_enter_event, NotificationEvent, FALSE);		
+
+		resl = start_system_thread(dc_sync_op_routine, hook, NULL);
+
+		if (resl == ST_OK) {
+			wait_object_infinity(&hook->sync_enter_event);
+			resl = hook->sync_init_status;						
+		}
+	} while (0);
+
+	return resl;
+}
+
+int dc_send_sync_packet(wchar_t *dev_name, u32 type, void *param)
+{
+	dev_hook    *hook;
+	sync_packet *packet;
+	int          mutex = 0;
+	int          resl;	
+
+	do
+	{
+		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+			resl = ST_NF_DEVICE; break;
+		}
+
+		wait_object_infinity(&hook->busy_lock);
+
+		if ( !(hook->flags & F_SYNC) ) {			
+			resl = ST_ERROR; break;
+		}
+
+		if ( (hook->flags & F_PREVENT_ENC) && 
+			 ((type == S_OP_ENC_BLOCK) || (type == S_OP_DEC_BLOCK)) )
+		{
+			resl = ST_CANCEL; break;
+		}
+
+		if ( (packet = mm_alloc(sizeof(sync_packet), 0)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+
+		KeInitializeEvent(
+			&packet->sync_event, NotificationEvent, FALSE);
+
+		packet->type  = type;
+		packet->param = param;		
+
+		ExInterlockedInsertTailList(
+			&hook->sync_req_queue, &packet->entry_list, &hook->sync_req_lock);
+
+		KeSetEvent(
+			&hook->sync_req_event, IO_NO_INCREMENT, FALSE);
+
+		KeReleaseMutex(&hook->busy_lock, FALSE);
+
+		wait_object_infinity(&packet->sync_event);
+
+		resl = packet->status; mutex = 1;
+		mm_free(packet);
+	} while (0);
+
+	if (hook != NULL) 
+	{		
+		if (mutex == 0) {
+			KeReleaseMutex(&hook->busy_lock, FALSE);
+		}
+		dc_deref_hook(hook);
+	}
+	return resl;
+}
+
+void dc_sync_all_encs()
+{
+	dev_hook *hook;
+
+	if (hook = dc_first_hook())
+	{
+		do
+		{
+			dc_send_sync_packet(hook->dev_name, S_OP_SYNC, 0);
+		} while (hook = dc_next_hook(hook));
+	}
+}
+
+int dc_encrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt)
+{
+	dc_header *header;
+	dev_hook  *hook;
+	xts_key   *hdr_key;
+	int        resl;
+	u64        storage;
+				
+	DbgMsg("dc_encrypt_start\n");
+
+	header = NULL; hdr_key = NULL;
+	do
+	{
+		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+			resl = ST_NF_DEVICE; break;
+		}
+
+		wait_object_infinity(&hook->busy_lock);
+		
+		if (hook->flags & (F_ENABLED | F_UNSUPRT | F_DISABLE | F_CDROM)) {
+			resl = ST_ERROR; break;
+		}
+
+		/* verify encryption info */
+		if ( (crypt->cipher_id >= CF_CIPHERS_NUM) || (crypt->wp_mode >= WP_NUM) ||
+			 (IS_INVALID_UNIT_SIZE(CRYPT_UNIT_SIZE(crypt)) != 0) ) 
+		{
+			resl = ST_ERROR; break;
+		}
+
+		/* get device params */
+		if (dc_get_dev_params(hook) != ST_OK) {
+			resl = ST_RW_ERR; break;
+		}
+
+		/* sync device flags with FS filter */
+		dc_fsf_set_flags(hook->dev_name, hook->flags);
+
+		/* create redirection storage */
+		if ( (resl = dc_create_storage(hook, &storage)) != ST_OK ) {
+			break;
+		}
+		DbgMsg("storage created\n");
+
+		if ( (header = mm_alloc(sizeof(dc_header), MEM_SECURE | MEM_ZEROED)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		/* create volume header */
+		rnd_get_bytes(pv(header->salt),     PKCS5_SALT_SIZE);
+		rnd_get_bytes(pv(&header->disk_id), sizeof(u32));
+		rnd_get_bytes(pv(header->key_1),    DISKKEY_SIZE);
+
+		header->flags     = VF_TMP_MODE | VF_STORAGE_FILE;
+		header->alg_1     = crypt->cipher_id;
+		header->stor_off  = storage;
+		header->use_size  = hook->dsk_size;
+		header->unit_size = d16(CRYPT_UNIT_SIZE(crypt));
+		DC_SET_HDR_SIGN(header);
+
+		/* initialize volume key */
+		if ( (resl = dc_set_dsk_key(hook, header->key_1, crypt->cipher_id, header->unit_size)) != ST_OK ) {
+			break;
+		}
+		
+		/* initialize header key */
+		dc_init_hdr_key(
+			hdr_key, header, crypt->cipher_id, password);
+
+		hook->crypt          = crypt[0];
+		hook->crypt.unit_size = header->unit_size;
+		hook->use_size       = hook->dsk_size;
+		hook->tmp_size       = DC_AREA_SIZE;
+		hook->stor_off       = storage;
+		hook->vf_version     = header->version;
+		hook->sync_init_type = S_INIT_ENC;
+		hook->hdr_key        = hdr_key;
+		hook->disk_id        = header->disk_id;
+		hook->flags         |= F_PROTECT_DCSYS;
+
+		/* start syncronous RW helper thread */		
+		if ( (resl = dc_start_rw_thread(hook)) != ST_OK ) {
+			break;
+		}
+		/* copy header to temp buffer */
+		autocpy(&hook->tmp_header, header, sizeof(dc_header));	
+		
+		if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
+		{
+			DbgMsg("sync init error\n");
+			zeroauto(&hook->tmp_header, sizeof(dc_header));	
+			hdr_key = hook->hdr_key;
+		} else {
+			hdr_key = NULL;
+		}
+		/* syncronize with RW thread */
+		KeSetEvent(&hook->rw_init_event, IO_NO_INCREMENT, FALSE);
+		/* sync device flags with FS filter */
+		dc_fsf_set_flags(hook->dev_name, hook->flags);
+	} while (0);
+
+	if (hdr_key != NULL) { mm_free(hdr_key); }
+	if (header != NULL)  { mm_free(header); }
+
+	if (hook != NULL) {
+		KeReleaseMutex(&hook->busy_lock, FALSE);
+		dc_deref_hook(hook);
+	}
+	return resl;
+}
+
+int dc_reencrypt_start(wchar_t *dev_name, dc_pass *password, crypt_info *crypt)
+{
+	dc_header *header = NULL;
+	crypt_info o_crypt;
+	dev_hook  *hook;
+	xts_key   *hdr_key = NULL;
+	xts_key   *dsk_key = NULL;
+	int        resl;
+
+	DbgMsg("dc_reencrypt_start\n");
+
+	do
+	{
+		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+			resl = ST_NF_DEVICE; break;
+		}
+
+		wait_object_infinity(&hook->busy_lock);
+
+		if ( !(hook->flags & F_ENABLED) || 
+			  (hook->flags & (F_SYNC | F_FORMATTING | F_CDROM)) ) 
+		{
+			resl = ST_ERROR; break;
+		}
+
+		/* verify encryption info */
+		if ( (crypt->cipher_id >= CF_CIPHERS_NUM) || (crypt->wp_mode >= WP_NUM) ||
+			 (IS_INVALID_UNIT_SIZE(CRYPT_UNIT_SIZE(crypt)) != 0) ) 
+		{
+			resl = ST_ERROR; break;
+		}
+
+		/* allocate new volume key */
+		if ( (dsk_key = mm_alloc(xts_key_size(crypt->cipher_id), MEM_SECURE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		/* allocate new header key */
+		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( (header = mm_alloc(sizeof(dc_header), MEM_SECURE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+
+		/* read volume header */
+		resl = dc_device_rw(
+			hook, IRP_MJ_READ, header, sizeof(dc_header), 0);
+
+		if (resl != ST_OK) {
+			break;
+		}
+
+		if (dc_decrypt_header(hdr_key, header, password) == 0) {
+			resl = ST_PASS_ERR;	break;
+		}
+
+		/* copy current volume key to secondary key */
+		autocpy(header->key_2, header->key_1, DISKKEY_SIZE);
+		header->unit_size_2 = d16(DC_UNIT_SIZE(header, unit_size));
+
+		/* generate new salt and volume key */
+		rnd_get_bytes(header->salt,  PKCS5_SALT_SIZE);		
+		rnd_get_bytes(header->key_1, DISKKEY_SIZE);
+
+		/* change other fields */
+		header->alg_2     = header->alg_1;
+		header->alg_1     = crypt->cipher_id;
+		header->unit_size = d16(CRYPT_UNIT_SIZE(crypt));
+		header->flags    |= VF_REENCRYPT;
+		DC_SET_HDR_SIGN(header);
+
+		/* initialize new header key */
+		dc_init_hdr_key(
+			hdr_key, header, header->alg_1, password);
+
+		/* initialize new volume key */
+		xts_set_key(header->key_1, header->alg_1, dsk_key);
+		xts_set_unit(dsk_key, header->unit_size);
+
+		/* save old encryption info */
+		o_crypt = hook->crypt;
+		/* set new encryption info */		
+		hook->crypt          = *crypt;
+		hook->crypt.unit_size = header->unit_size;
+		hook->tmp_size       = 0;
+		hook->vf_version     = header->version;
+		hook->sync_init_type = S_INIT_RE_ENC;
+		hook->hdr_key        = hdr_key;
+		hook->tmp_key        = dsk_key;
+		
+		/* copy header to temp buffer */
+		autocpy(&hook->tmp_header, header, sizeof(dc_header));
+		
+		if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
+		{
+			zeroauto(&hook->tmp_header, sizeof(dc_header));	
+			hdr_key = hook->hdr_key;
+			dsk_key = hook->tmp_key;
+			/* restore encryption info */
+			hook->crypt = o_crypt;
+		} else {
+			hdr_key = NULL;
+			dsk_key = NULL;
+		}
+	} while (0);
+
+	if (dsk_key != NULL) { mm_free(dsk_key); }
+	if (hdr_key != NULL) { mm_free(hdr_key); }
+	if (header != NULL)  { mm_free(header); }
+
+	if (hook != NULL) {
+		KeReleaseMutex(&hook->busy_lock, FALSE);
+		dc_deref_hook(hook);
+	}
+	return resl;
+}
+
+int dc_decrypt_start(wchar_t *dev_name, dc_pass *password)
+{
+	dc_header *header = NULL;
+	dev_hook  *hook;
+	xts_key   *hdr_key = NULL;
+	int        resl;
+				
+	DbgMsg("dc_decrypt_start\n");
+
+	do
+	{
+		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+			resl = ST_NF_DEVICE; break;
+		}
+
+		wait_object_infinity(&hook->busy_lock);
+		
+		if ( !(hook->flags & F_ENABLED) || 
+			  (hook->flags & (F_SYNC | F_FORMATTING | F_CDROM)) ) 
+		{
+			resl = ST_ERROR; break;
+		}
+		if ( (header = mm_alloc(sizeof(dc_header), MEM_SECURE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+
+		/* read volume header */
+		resl = dc_device_rw(
+			hook, IRP_MJ_READ, header, sizeof(dc_header), 0);
+
+		if (resl != ST_OK) {
+			break;
+		}
+
+		/* decrypt volume header */
+		if (dc_decrypt_header(hdr_key, header, password) == 0) {
+			resl = ST_PASS_ERR;	break;
+		}
+
+		hook->crypt.cipher_id = d8(header->alg_1);
+		hook->crypt.wp_mode   = WP_NONE;
+		hook->crypt.unit_size = d16(DC_UNIT_SIZE(header, unit_size));
+		
+		/* copy header to temp buffer */
+		autocpy(&hook->tmp_header, header, sizeof(dc_header));
+
+		hook->tmp_size       = hook->dsk_size;
+		hook->sync_init_type = S_INIT_DEC;
+		hook->hdr_key        = hdr_key;
+		
+		if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
+		{
+			zeroauto(&hook->tmp_header, sizeof(dc_header));
+			hdr_key = hook->hdr_key;
+		} else {
+			hdr_key = NULL;
+		}
+	} while (0);
+
+	if (hdr_key != NULL) { mm_free(hdr_key); }
+	if (header != NULL)  { mm_free(header); }
+
+	if (hook != NULL) {
+		KeReleaseMutex(&hook->busy_lock, FALSE);
+		dc_deref_hook(hook);
+	}
+	return resl;
+}
@@ -85,7 +85,9 @@ static void dc_worker_thread(void *param)
 			offset = item->offset + part->offset;
 			length = part->length;
 
-			if (item->is_encrypt != 0) {
+			if (item->is_encrypt == F_OP_KEYSTREAM) {
+				xts_keystream(out, length, offset, item->key);
+			} else if (item->is_encrypt != 0) {
 				xts_encrypt(in, out, length, offset, item->key);
 			} else {
 				xts_decrypt(in, out, length, offset, item->key);
@@ -123,7 +125,8 @@ int dc_parallelized_crypt(
 	item->param2 = param2;
 	item->key    = key;
 
-	part_sz = _align(len / dc_cpu_count, F_MIN_REQ);
+	/* split at data unit borders, so tweak of each unit is computed only once */
+	part_sz = _align(len / dc_cpu_count, max(F_MIN_REQ, key->unit_size));
 	part_of = 0; part = &item->parts[0];
 	do
 	{
@@ -165,7 +168,9 @@ void dc_fast_crypt_op(
 			return;
 		}
 	}
-	if (is_encrypt != 0) {
+	if (is_encrypt == F_OP_KEYSTREAM) {
+		xts_keystream(out, len, offset, key);
+	} else if (is_encrypt != 0) {
 		xts_encrypt(in, out, len, offset, key);
 	} else {
 		xts_decrypt(in, out, len, offset, key);
@@ -1,494 +1,656 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2007-2009 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <ntifs.h>
-#include "defines.h"
-#include "devhook.h"
-#include "driver.h"
-#include "mount.h"
-#include "prng.h"
-#include "benchmark.h"
-#include "misc_irp.h"
-#include "enc_dec.h"
-#include "misc.h"
-#include "debug.h"
-#include "readwrite.h"
-#include "mem_lock.h"
-#include "misc_volume.h"
-#include "fsf_control.h"
-#include <ntddcdrm.h>
-
-#define IS_VERIFY_IOCTL(ioctl) ( \
-	(ioctl == IOCTL_DISK_CHECK_VERIFY) || \
-	(ioctl == IOCTL_CDROM_CHECK_VERIFY) || \
-	(ioctl == IOCTL_STORAGE_CHECK_VERIFY) )
-
-static int dc_ioctl_process(u32 code, dc_ioctl *data)
-{
-	int resl = ST_ERROR;
-
-	switch (code)
-	{
-		case DC_CTL_ADD_PASS:
-			{
-				dc_add_password(&data->passw1);
-				resl = ST_OK;
-			} 
-		break;
-		case DC_CTL_MOUNT:
-			{
-				resl = dc_mount_device(
-					data->device, &data->passw1, data->flags);
-
-				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
-					dc_add_password(&data->passw1);
-				}
-			}
-		break;
-		case DC_CTL_MOUNT_ALL:
-			{
-				data->n_mount = dc_mount_all(&data->passw1, data->flags);
-				resl          = ST_OK;
-
-				if ( (data->n_mount != 0) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
-					dc_add_password(&data->passw1);
-				}
-			}
-		break;
-		case DC_CTL_UNMOUNT:
-			{
-				resl = dc_unmount_device(
-					data->device, (data->flags & MF_FORCE));
-			}
-		break;
-		case DC_CTL_CHANGE_PASS:
-			{
-				resl = dc_change_pass(
-					data->device, &data->passw1, &data->passw2);
-
-				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
-					dc_add_password(&data->passw2);
-				}
-			}
-		break;
-		case DC_CTL_ENCRYPT_START:
-			{
-				resl = dc_encrypt_start(
-					data->device, &data->passw1, &data->crypt);
-
-				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
-					dc_add_password(&data->passw1);
-				}
-			}
-		break;
-		case DC_CTL_DECRYPT_START:
-			{
-				resl = dc_decrypt_start(data->device, &data->passw1);
-			}
-		break;
-		case DC_CTL_RE_ENC_START:
-			{
-				resl = dc_reencrypt_start(
-					data->device, &data->passw1, &data->crypt);
-			}
-		break;
-		case DC_CTL_ENCRYPT_STEP:
-			{
-				resl = dc_send_sync_packet(
-					data->device, S_OP_ENC_BLOCK, pv(data->crypt.wp_mode));
-			}
-		break;
-		case DC_CTL_DECRYPT_STEP:
-			{
-				resl = dc_send_sync_packet(data->device, S_OP_DEC_BLOCK, 0);
-			}
-		break; 
-		case DC_CTL_SYNC_STATE:
-			{
-				resl = dc_send_sync_packet(data->device, S_OP_SYNC, 0);
-			}
-		break;
-		case DC_CTL_RESOLVE:
-			{
-				while (dc_resolve_link(
-					data->device, data->device, sizeof(data->device)) == ST_OK)
-				{
-					resl = ST_OK;
-				}
-			}
-		break;
-		case DC_FORMAT_START:
-			{
-				resl = dc_format_start(
-					data->device, &data->passw1, &data->crypt);
-
-				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
-					dc_add_password(&data->passw1);
-				}
-			}
-		break;
-		case DC_FORMAT_STEP:
-			{
-				resl = dc_format_step(data->device, data->crypt.wp_mode);
-			}
-		break;
-		case DC_FORMAT_DONE:
-			{
-				resl = dc_format_done(data->device);
-			}
-		break;
-	}
-
-	return resl;
-}
-
-NTSTATUS
-  dc_drv_control_irp(
-     PDEVICE_OBJECT dev_obj, PIRP irp
-	 )
-{
-	PIO_STACK_LOCATION  irp_sp  = IoGetCurrentIrpStackLocation(irp);
-	NTSTATUS            status  = STATUS_INVALID_DEVICE_REQUEST;
-	void               *data    = irp->AssociatedIrp.SystemBuffer;
-	u32                 in_len  = irp_sp->Parameters.DeviceIoControl.InputBufferLength;
-	u32                 out_len = irp_sp->Parameters.DeviceIoControl.OutputBufferLength;
-	u32                 code    = irp_sp->Parameters.DeviceIoControl.IoControlCode;
-	u32                 bytes   = 0;
-	
-	switch (code)
-	{
-		case DC_GET_VERSION:
-			{
-				if (out_len == sizeof(u32)) 
-				{
-					p32(data)[0] = DC_DRIVER_VER;
-					bytes        = sizeof(u32);
-					status       = STATUS_SUCCESS;
-				}
-			}
-		break;
-		case DC_CTL_CLEAR_PASS:
-			{
-				dc_clean_pass_cache();
-				status = STATUS_SUCCESS;
-			}
-		break;		
-		case DC_CTL_STATUS:
-			{
-				dc_ioctl  *dctl = data;
-				dc_status *stat = data;
-				dev_hook  *hook;
-
-				if ( (in_len == sizeof(dc_ioctl)) && (out_len == sizeof(dc_status)) )
-				{
-					dctl->device[MAX_DEVICE] = 0;
-
-					if (hook = dc_find_hook(dctl->device))
-					{
-						if (hook->pdo_dev->Flags & DO_SYSTEM_BOOT_PARTITION) {
-							hook->flags |= F_SYSTEM;
-						}
-
-						dc_get_mount_point(
-							hook, stat->mnt_point, sizeof(stat->mnt_point));
-
-						stat->crypt        = hook->crypt;
-						stat->dsk_size     = hook->dsk_size;
-						stat->tmp_size     = hook->tmp_size;
-						stat->flags        = hook->flags;
-						stat->mnt_flags    = hook->mnt_flags;
-						stat->disk_id      = hook->disk_id;
-						stat->paging_count = hook->paging_count;
-						stat->vf_version   = hook->vf_version;
-						status             = STATUS_SUCCESS; 
-						bytes              = sizeof(dc_status);
-
-						dc_deref_hook(hook);
-					}
-				}
-			}
-		break;
-		case DC_CTL_ADD_SEED:
-			{
-				 if (in_len != 0) 
-				 {
-					 rnd_add_buff(data, in_len);
-					 status = STATUS_SUCCESS;
-					 /* prevent leaks */
-					 zeromem(data, in_len);
-				 }
-			}
-		break;
-		case DC_CTL_GET_RAND:
-			{
-				dc_rand_ctl *rctl = data;
-				
-				if (in_len == sizeof(dc_rand_ctl))
-				{
-					__try
-					{
-						ProbeForWrite(rctl->buff, rctl->size, sizeof(u8));
-
-						if (rnd_get_bytes(rctl->buff, rctl->size) != 0) {
-							status = STATUS_SUCCESS;
-						}
-					} 
-					__except(EXCEPTION_EXECUTE_HANDLER) {
-						status = GetExceptionCode();
-					}
-				}
-			}
-		break;
-		case DC_CTL_BENCHMARK:
-			{
-				 if ( (in_len == sizeof(crypt_info)) && (out_len == sizeof(dc_bench)) )
-				 {
-					 if (dc_k_benchmark(pv(data), pv(data)) == ST_OK) {
-						 status = STATUS_SUCCESS; 
-						 bytes  = sizeof(dc_bench);
-					 }
-				 }
-			}
-		break;
-		case DC_CTL_BSOD:
-			{
-				lock_inc(&dc_dump_disable);
-				dc_clean_pass_cache();
-				dc_clean_locked_mem(NULL);
-				dc_clean_keys();
-
-				KeBugCheck(IRQL_NOT_LESS_OR_EQUAL);
-			}
-		break;
-		case DC_CTL_GET_CONF:
-			{
-				dc_conf *conf = data;
-
-				if (out_len == sizeof(dc_conf)) {
-					conf->conf_flags = dc_conf_flags;
-					conf->load_flags = dc_load_flags;
-					status = STATUS_SUCCESS;
-					bytes  = sizeof(dc_conf);
-				}
-			}
-		break;
-		case DC_CTL_SET_CONF:
-			{
-				dc_conf *conf = data;
-				
-				if (in_len == sizeof(dc_conf))
-				{
-					dc_conf_flags = conf->conf_flags;
-					status        = STATUS_SUCCESS;
-
-					if ( !(dc_conf_flags & CONF_CACHE_PASSWORD) ) {
-						dc_clean_pass_cache();
-					}
-					dc_fsf_set_conf();
-					xts_init(dc_conf_flags & CONF_HW_CRYPTO);
-				}
-			}
-		break;
-		case DC_CTL_LOCK_MEM:
-			{
-				dc_lock_ctl *smem = data;
-
-				if ( (in_len == sizeof(dc_lock_ctl)) && (out_len == in_len) )
-				{
-					smem->resl = dc_lock_mem(smem->data, smem->size, irp_sp->FileObject);
-
-					status = STATUS_SUCCESS;
-					bytes  = sizeof(dc_lock_ctl);
-				}
-			}
-		break;
-		case DC_CTL_UNLOCK_MEM:
-			{
-				dc_lock_ctl *smem = data;
-
-				if ( (in_len == sizeof(dc_lock_ctl)) && (out_len == in_len) )
-				{
-					smem->resl = dc_unlock_mem(smem->data, irp_sp->FileObject);
-
-					status = STATUS_SUCCESS;
-					bytes  = sizeof(dc_lock_ctl);
-				}
-			}
-		break; 
-		case DC_BACKUP_HEADER:
-			{
-				dc_backup_ctl *back = data;
-				
-				if ( (in_len == sizeof(dc_backup_ctl)) && (out_len == in_len) )
-				{
-					back->device[MAX_DEVICE] = 0;
-
-					back->status = dc_backup_header(
-						back->device, &back->pass, back->backup);
-
-					/* prevent leaks */
-					zeroauto(&back->pass, sizeof(back->pass));
-
-					status = STATUS_SUCCESS;
-					bytes  = sizeof(dc_backup_ctl);
-				}
-			}
-		break;
-		case DC_RESTORE_HEADER:
-			{
-				dc_backup_ctl *back = data;
-				
-				if ( (in_len == sizeof(dc_backup_ctl)) && (out_len == in_len) )
-				{
-					back->device[MAX_DEVICE] = 0;
-
-					back->status = dc_restore_header(
-						back->device, &back->pass, back->backup);
-
-					/* prevent leaks */
-					zeroauto(&back->pass, sizeof(back->pass));
-
-					status = STATUS_SUCCESS;
-					bytes  = sizeof(dc_backup_ctl);
-				}
-			}
-		break;
-		default: 
-			{
-				dc_ioctl *dctl = data;
-
-				if ( (in_len == sizeof(dc_ioctl)) && (out_len == sizeof(dc_ioctl)) )
-				{					
-					/* limit null-terminated string length */
-					dctl->device[MAX_DEVICE] = 0;
-					
-					/* process IOCTL */
-					dctl->status = dc_ioctl_process(code, dctl);
-
-					/* prevent leaks  */
-					zeroauto(&dctl->passw1, sizeof(dctl->passw1));
-					zeroauto(&dctl->passw2, sizeof(dctl->passw2));
-
-					status = STATUS_SUCCESS;
-					bytes  = sizeof(dc_ioctl);
-				}
-			}
-		break;
-	}
-	return dc_complete_irp(irp, status, bytes);
-}
-
-static
-NTSTATUS
-  dc_ioctl_complete(
-    PDEVICE_OBJECT dev_obj, PIRP irp, void *param
-    )
-{
-	PIO_STACK_LOCATION irp_sp;
-	dev_hook          *hook;
-	u32                ioctl;
-	NTSTATUS           status;
-	u32               *chg_c;
-    int                change;
-
-	irp_sp = IoGetCurrentIrpStackLocation(irp);
-	hook   = dev_obj->DeviceExtension;
-	ioctl  = irp_sp->Parameters.DeviceIoControl.IoControlCode;
-	status = irp->IoStatus.Status;
-
-	if (irp->PendingReturned) {
-		IoMarkIrpPending(irp);
-	}
-	if ( NT_SUCCESS(status) && (hook->flags & F_ENABLED) )
-	{
-		switch (ioctl)
-		{
-			case IOCTL_DISK_GET_LENGTH_INFO:
-			  {
-				  PGET_LENGTH_INFORMATION gl = pv(irp->AssociatedIrp.SystemBuffer);
-				  gl->Length.QuadPart = hook->use_size;
-			  }
-		    break;
-			case IOCTL_DISK_GET_PARTITION_INFO:
-			  {
-				  PPARTITION_INFORMATION pi = pv(irp->AssociatedIrp.SystemBuffer);
-				  pi->PartitionLength.QuadPart = hook->use_size;				
-			  }
-		    break;
-			case IOCTL_DISK_GET_PARTITION_INFO_EX:
-			  {
-				  PPARTITION_INFORMATION_EX pi = pv(irp->AssociatedIrp.SystemBuffer);				  
-				  pi->PartitionLength.QuadPart = hook->use_size;
-			  }
-		    break;
-			case IOCTL_CDROM_GET_DRIVE_GEOMETRY_EX:
-				{
-					PDISK_GEOMETRY_EX dgx = pv(irp->AssociatedIrp.SystemBuffer);
-					dgx->DiskSize.QuadPart = hook->use_size;
-				}
-			break;
-		}
-	}
-	if ( (hook->flags & F_REMOVABLE) && (IS_VERIFY_IOCTL(ioctl) != 0) )
-	{
-		chg_c  = pv(irp->AssociatedIrp.SystemBuffer);
-		change = NT_SUCCESS(status) == FALSE;
-		
-		if (irp->IoStatus.Information == sizeof(u32)) {
-			change |= lock_xchg(&hook->chg_last_v, *chg_c) != *chg_c;
-			*chg_c += hook->chg_mount;
-		}
-
-		if ( (change != 0) && (hook->dsk_size != 0) ) {
-			DbgMsg("media removed\n");
-			dc_unmount_async(hook);
-		}	
-	}
-	IoReleaseRemoveLock(&hook->remv_lock, irp);
-
-	return STATUS_SUCCESS;
-}
-
-
-
-NTSTATUS dc_io_control_irp(dev_hook *hook, PIRP irp)
-{	
-	PIO_STACK_LOCATION irp_sp;
-	u32                ioctl;
-	
-	irp_sp = IoGetCurrentIrpStackLocation(irp);
-	ioctl  = irp_sp->Parameters.DeviceIoControl.IoControlCode;
-
-	if ( (ioctl == IOCTL_DISK_GET_LENGTH_INFO) || 
-		 (ioctl == IOCTL_DISK_GET_PARTITION_INFO) ||
-		 (ioctl == IOCTL_DISK_GET_PARTITION_INFO_EX) || 
-		 (ioctl == IOCTL_CDROM_GET_DRIVE_GEOMETRY_EX) ||
-		 (IS_VERIFY_IOCTL(ioctl) != 0) )
-	{
-		IoCopyCurrentIrpStackLocationToNext(irp);
-
-		IoSetCompletionRoutine(
-			irp, dc_ioctl_complete,	NULL, TRUE, TRUE, TRUE);
-
-		return IoCallDriver(hook->orig_dev, irp);
-	} else {
-		return dc_forward_irp(hook, irp);
-	}	
-}
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2007-2009 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ntifs.h>
+#include "defines.h"
+#include "devhook.h"
+#include "driver.h"
+#include "mount.h"
+#include "prng.h"
+#include "benchmark.h"
+#include "misc_irp.h"
+#include "enc_dec.h"
+#include "misc.h"
+#include "debug.h"
+#include "readwrite.h"
+#include "mem_lock.h"
+#include "misc_volume.h"
+#include "fsf_control.h"
+#include "misc_mem.h"
+#include <ntddcdrm.h>
+
+#define IS_VERIFY_IOCTL(ioctl) ( \
+	(ioctl == IOCTL_DISK_CHECK_VERIFY) || \
+	(ioctl == IOCTL_CDROM_CHECK_VERIFY) || \
+	(ioctl == IOCTL_STORAGE_CHECK_VERIFY) )
+
+static int dc_ioctl_process(u32 code, dc_ioctl *data)
+{
+	int resl = ST_ERROR;
+
+	switch (code)
+	{
+		case DC_CTL_ADD_PASS:
+			{
+				dc_add_password(&data->passw1);
+				resl = ST_OK;
+			} 
+		break;
+		case DC_CTL_MOUNT:
+			{
+				resl = dc_mount_device(
+					data->device, &data->passw1, data->flags);
+
+				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
+					dc_add_password(&data->passw1);
+				}
+			}
+		break;
+		case DC_CTL_MOUNT_ALL:
+			{
+				data->n_mount = dc_mount_all(&data->passw1, data->flags);
+				resl          = ST_OK;
+
+				if ( (data->n_mount != 0) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
+					dc_add_password(&data->passw1);
+				}
+			}
+		break;
+		case DC_CTL_UNMOUNT:
+			{
+				resl = dc_unmount_device(
+					data->device, (data->flags & MF_FORCE));
+			}
+		break;
+		case DC_CTL_CHANGE_PASS:
+			{
+				resl = dc_change_pass(
+					data->device, &data->passw1, &data->passw2);
+
+				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
+					dc_add_password(&data->passw2);
+				}
+			}
+		break;
+		case DC_CTL_ENCRYPT_START:
+			{
+				resl = dc_encrypt_start(
+					data->device, &data->passw1, &data->crypt);
+
+				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
+					dc_add_password(&data->passw1);
+				}
+			}
+		break;
+		case DC_CTL_DECRYPT_START:
+			{
+				resl = dc_decrypt_start(data->device, &data->passw1);
+			}
+		break;
+		case DC_CTL_RE_ENC_START:
+			{
+				resl = dc_reencrypt_start(
+					data->device, &data->passw1, &data->crypt);
+			}
+		break;
+		case DC_CTL_ENCRYPT_STEP:
+			{
+				resl = dc_send_sync_packet(
+					data->device, S_OP_ENC_BLOCK, pv(data->crypt.wp_mode));
+			}
+		break;
+		case DC_CTL_DECRYPT_STEP:
+			{
+				resl = dc_send_sync_packet(data->device, S_OP_DEC_BLOCK, 0);
+			}
+		break; 
+		case DC_CTL_SYNC_STATE:
+			{
+				resl = dc_send_sync_packet(data->device, S_OP_SYNC, 0);
+			}
+		break;
+		case DC_CTL_RESOLVE:
+			{
+				while (dc_resolve_link(
+					data->device, data->device, sizeof(data->device)) == ST_OK)
+				{
+					resl = ST_OK;
+				}
+			}
+		break;
+		case DC_FORMAT_START:
+			{
+				resl = dc_format_start(
+					data->device, &data->passw1, &data->crypt);
+
+				if ( (resl == ST_OK) && (dc_conf_flags & CONF_CACHE_PASSWORD) ) {
+					dc_add_password(&data->passw1);
+				}
+			}
+		break;
+		case DC_FORMAT_STEP:
+			{
+				resl = dc_format_step(data->device, data->crypt.wp_mode);
+			}
+		break;
+		case DC_FORMAT_DONE:
+			{
+				resl = dc_format_done(data->device);
+			}
+		break;
+	}
+
+	return resl;
+}
+
+static void dc_get_hook_status(dev_hook *hook, dc_status *stat)
+{
+	if (hook->pdo_dev->Flags & DO_SYSTEM_BOOT_PARTITION) {
+		hook->flags |= F_SYSTEM;
+	}
+
+	dc_get_mount_point(
+		hook, stat->mnt_point, sizeof(stat->mnt_point));
+
+	stat->crypt        = hook->crypt;
+	stat->dsk_size     = hook->dsk_size;
+	stat->tmp_size     = hook->tmp_size;
+	stat->flags        = hook->flags;
+	stat->mnt_flags    = hook->mnt_flags;
+	stat->disk_id      = hook->disk_id;
+	stat->paging_count = hook->paging_count;
+	stat->vf_version   = hook->vf_version;
+	stat->run_mode     = hook->sync_run;
+	stat->run_status   = hook->sync_run_status;
+	stat->mnt_time     = hook->mnt_time;
+}
+
+/* status of all hooked devices in one request, [max_items] may be 0 to get counter only */
+static int dc_enum_devices(dc_enum_ctl *ectl, u32 max_items)
+{
+	dc_enum_item *item = pv(ectl + 1);
+	dev_hook    **hooks;
+	dev_hook     *hook;
+	u32           count, n_hook, i;
+
+	/* changes made after this point are reported by next request */
+	ectl->seq   = dc_hooks_seq();
+	ectl->items = 0;
+
+	for (count = 0, hook = dc_first_hook(); hook != NULL; hook = dc_next_hook(hook)) {
+		count++;
+	}
+	ectl->count = count;
+
+	if ( (count = min(count, max_items)) == 0 ) {
+		return ST_OK;
+	}
+	if ( (hooks = mm_alloc(count * sizeof(dev_hook*), 0)) == NULL ) {
+		return ST_NOMEM;
+	}
+	/* reference hooks to release list lock while mount points queried */
+	for (n_hook = 0, hook = dc_first_hook(); hook != NULL; hook = dc_next_hook(hook))
+	{
+		if (n_hook < count) {
+			dc_reference_hook(hook); hooks[n_hook++] = hook;
+		}
+	}
+	for (i = 0; i < n_hook; i++)
+	{
+		wcscpy(item[i].device, hooks[i]->dev_name);
+		dc_get_hook_status(hooks[i], &item[i].status);
+		dc_deref_hook(hooks[i]);
+	}
+	ectl->items = n_hook;
+	mm_free(hooks);
+
+	return ST_OK;
+}
+
+#define RAND_CTL_CHUNK (64 * 1024)
+
+/*
+   random data is generated to kernel buffer and copied to user buffer by chunks,
+   so exception on user buffer never unwinds crypto code with saved FPU state
+*/
+static NTSTATUS dc_get_rand_user(u8 *buff, u32 size)
+{
+	NTSTATUS status = STATUS_SUCCESS;
+	u8      *kbuf;
+	u32      blen;
+
+	if ( (kbuf = mm_alloc(RAND_CTL_CHUNK, MEM_SECURE)) == NULL ) {
+		return STATUS_INSUFFICIENT_RESOURCES;
+	}
+	for (; size != 0; buff += blen, size -= blen)
+	{
+		blen = min(size, RAND_CTL_CHUNK);
+
+		if (rnd_get_bytes(kbuf, blen) == 0) {
+			status = STATUS_UNSUCCESSFUL; break;
+		}
+		__try {
+			memcpy(buff, kbuf, blen);
+		}
+		__except(EXCEPTION_EXECUTE_HANDLER) {
+			status = GetExceptionCode();
+		}
+		if (NT_SUCCESS(status) == FALSE) {
+			break;
+		}
+	}
+	/* secure memory is zeroed on free */
+	mm_free(kbuf);
+
+	return status;
+}
+
+NTSTATUS
+  dc_drv_control_irp(
+     PDEVICE_OBJECT dev_obj, PIRP irp
+	 )
+{
+	PIO_STACK_LOCATION  irp_sp  = IoGetCurrentIrpStackLocation(irp);
+	NTSTATUS            status  = STATUS_INVALID_DEVICE_REQUEST;
+	void               *data    = irp->AssociatedIrp.SystemBuffer;
+	u32                 in_len  = irp_sp->Parameters.DeviceIoControl.InputBufferLength;
+	u32                 out_len = irp_sp->Parameters.DeviceIoControl.OutputBufferLength;
+	u32                 code    = irp_sp->Parameters.DeviceIoControl.IoControlCode;
+	u32                 bytes   = 0;
+	
+	switch (code)
+	{
+		case DC_GET_VERSION:
+			{
+				if (out_len == sizeof(u32)) 
+				{
+					p32(data)[0] = DC_DRIVER_VER;
+					bytes        = sizeof(u32);
+					status       = STATUS_SUCCESS;
+				}
+			}
+		break;
+		case DC_CTL_CLEAR_PASS:
+			{
+				dc_clean_pass_cache();
+				status = STATUS_SUCCESS;
+			}
+		break;		
+		case DC_CTL_STATUS:
+			{
+				dc_ioctl  *dctl = data;
+				dc_status *stat = data;
+				dev_hook  *hook;
+
+				if ( (in_len == sizeof(dc_ioctl)) && (out_len == sizeof(dc_status)) )
+				{
+					dctl->device[MAX_DEVICE] = 0;
+
+					if (hook = dc_find_hook(dctl->device))
+					{
+						dc_get_hook_status(hook, stat);
+
+						status = STATUS_SUCCESS; 
+						bytes  = sizeof(dc_status);
+
+						dc_deref_hook(hook);
+					}
+				}
+			}
+		break;
+		case DC_CTL_ENUM:
+			{
+				dc_enum_ctl *ectl = data;
+
+				if ( (out_len >= sizeof(dc_enum_ctl)) && 
+					 (dc_enum_devices(ectl, (out_len - sizeof(dc_enum_ctl)) / sizeof(dc_enum_item)) == ST_OK) )
+				{
+					status = STATUS_SUCCESS;
+					bytes  = DC_ENUM_SIZE(ectl->items);
+				}
+			}
+		break;
+		case DC_CTL_ADD_SEED:
+			{
+				 if (in_len != 0) 
+				 {
+					 rnd_add_buff(data, in_len);
+					 status = STATUS_SUCCESS;
+					 /* prevent leaks */
+					 zeromem(data, in_len);
+				 }
+			}
+		break;
+		case DC_CTL_GET_RAND:
+			{
+				dc_rand_ctl *rctl = data;
+				
+				if (in_len == sizeof(dc_rand_ctl))
+				{
+					__try
+					{
+						ProbeForWrite(rctl->buff, rctl->size, sizeof(u8));
+						status = STATUS_SUCCESS;
+					} 
+					__except(EXCEPTION_EXECUTE_HANDLER) {
+						status = GetExceptionCode();
+					}
+					if (NT_SUCCESS(status) != FALSE) {
+						status = dc_get_rand_user(rctl->buff, rctl->size);
+					}
+				}
+			}
+		break;
+		case DC_CTL_BENCHMARK:
+			{
+				 if ( (in_len == sizeof(crypt_info)) && (out_len == sizeof(dc_bench)) )
+				 {
+					 if (dc_k_benchmark(pv(data), pv(data)) == ST_OK) {
+						 status = STATUS_SUCCESS; 
+						 bytes  = sizeof(dc_bench);
+					 }
+				 }
+			}
+		break;
+		case DC_CTL_BENCH_EX:
+			{
+				dc_bench_ctl *bctl = data;
+
+				if ( (in_len == sizeof(dc_bench_ctl)) && (out_len == in_len) )
+				{
+					bctl->status = dc_k_benchmark_ex(bctl);
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_bench_ctl);
+				}
+			}
+		break;
+		case DC_CTL_BSOD:
+			{
+				lock_inc(&dc_dump_disable);
+				dc_clean_pass_cache();
+				dc_clean_locked_mem(NULL);
+				dc_clean_keys();
+
+				KeBugCheck(IRQL_NOT_LESS_OR_EQUAL);
+			}
+		break;
+		case DC_CTL_GET_CONF:
+			{
+				dc_conf *conf = data;
+
+				if (out_len == sizeof(dc_conf)) {
+					conf->conf_flags = dc_conf_flags;
+					conf->load_flags = dc_load_flags;
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_conf);
+				}
+			}
+		break;
+		case DC_CTL_SET_CONF:
+			{
+				dc_conf *conf = data;
+				
+				if (in_len == sizeof(dc_conf))
+				{
+					dc_conf_flags = conf->conf_flags;
+					status        = STATUS_SUCCESS;
+
+					if ( !(dc_conf_flags & CONF_CACHE_PASSWORD) ) {
+						dc_clean_pass_cache();
+					}
+					dc_fsf_set_conf();
+					xts_init(dc_conf_flags & CONF_HW_CRYPTO);
+				}
+			}
+		break;
+		case DC_CTL_LOCK_MEM:
+			{
+				dc_lock_ctl *smem = data;
+
+				if ( (in_len == sizeof(dc_lock_ctl)) && (out_len == in_len) )
+				{
+					smem->resl = dc_lock_mem(smem->data, smem->size, irp_sp->FileObject);
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_lock_ctl);
+				}
+			}
+		break;
+		case DC_CTL_UNLOCK_MEM:
+			{
+				dc_lock_ctl *smem = data;
+
+				if ( (in_len == sizeof(dc_lock_ctl)) && (out_len == in_len) )
+				{
+					smem->resl = dc_unlock_mem(smem->data, irp_sp->FileObject);
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_lock_ctl);
+				}
+			}
+		break; 
+		case DC_BACKUP_HEADER:
+			{
+				dc_backup_ctl *back = data;
+				
+				if ( (in_len == sizeof(dc_backup_ctl)) && (out_len == in_len) )
+				{
+					back->device[MAX_DEVICE] = 0;
+
+					back->status = dc_backup_header(
+						back->device, &back->pass, back->backup);
+
+					/* prevent leaks */
+					zeroauto(&back->pass, sizeof(back->pass));
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_backup_ctl);
+				}
+			}
+		break;
+		case DC_RESTORE_HEADER:
+			{
+				dc_backup_ctl *back = data;
+				
+				if ( (in_len == sizeof(dc_backup_ctl)) && (out_len == in_len) )
+				{
+					back->device[MAX_DEVICE] = 0;
+
+					back->status = dc_restore_header(
+						back->device, &back->pass, back->backup);
+
+					/* prevent leaks */
+					zeroauto(&back->pass, sizeof(back->pass));
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_backup_ctl);
+				}
+			}
+		break;
+		case DC_CTL_BAD_BLOCKS:
+			{
+				dc_bad_ctl *bctl = data;
+
+				if ( (in_len == sizeof(dc_bad_ctl)) && (out_len == in_len) )
+				{
+					bctl->device[MAX_DEVICE] = 0;
+					bctl->status = dc_get_bad_blocks(bctl->device, bctl);
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_bad_ctl);
+				}
+			}
+		break;
+		case DC_CTL_RUN:
+			{
+				dc_run_ctl *rctl = data;
+
+				if ( (in_len == sizeof(dc_run_ctl)) && (out_len == in_len) )
+				{
+					rctl->device[MAX_DEVICE] = 0;
+					rctl->status = dc_conversion_run(rctl->device, rctl->mode, rctl->wp_mode, rctl->h_event);
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_run_ctl);
+				}
+			}
+		break;
+		case DC_CTL_SET_THROTTLE:
+			{
+				dc_throttle_ctl *tctl = data;
+
+				if ( (in_len == sizeof(dc_throttle_ctl)) && (out_len == in_len) )
+				{
+					tctl->device[MAX_DEVICE] = 0;
+
+					if (tctl->max_latency > MAX_THR_LATENCY) {
+						tctl->status = ST_ERROR;
+					} else {
+						tctl->status = dc_set_throttle(tctl->device, tctl->max_latency, tctl->max_speed);
+					}
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_throttle_ctl);
+				}
+			}
+		break;
+		default: 
+			{
+				dc_ioctl *dctl = data;
+
+				if ( (in_len == sizeof(dc_ioctl)) && (out_len == sizeof(dc_ioctl)) )
+				{					
+					/* limit null-terminated string length */
+					dctl->device[MAX_DEVICE] = 0;
+					
+					/* process IOCTL */
+					dctl->status = dc_ioctl_process(code, dctl);
+
+					/* prevent leaks  */
+					zeroauto(&dctl->passw1, sizeof(dctl->passw1));
+					zeroauto(&dctl->passw2, sizeof(dctl->passw2));
+
+					status = STATUS_SUCCESS;
+					bytes  = sizeof(dc_ioctl);
+				}
+			}
+		break;
+	}
+	return dc_complete_irp(irp, status, bytes);
+}
+
+static
+NTSTATUS
+  dc_ioctl_complete(
+    PDEVICE_OBJECT dev_obj, PIRP irp, void *param
+    )
+{
+	PIO_STACK_LOCATION irp_sp;
+	dev_hook          *hook;
+	u32                ioctl;
+	NTSTATUS           status;
+	u32               *chg_c;
+    int                change;
+
+	irp_sp = IoGetCurrentIrpStackLocation(irp);
+	hook   = dev_obj->DeviceExtension;
+	ioctl  = irp_sp->Parameters.DeviceIoControl.IoControlCode;
+	status = irp->IoStatus.Status;
+
+	if (irp->PendingReturned) {
+		IoMarkIrpPending(irp);
+	}
+	if ( NT_SUCCESS(status) && (hook->flags & F_ENABLED) )
+	{
+		switch (ioctl)
+		{
+			case IOCTL_DISK_GET_LENGTH_INFO:
+			  {
+				  PGET_LENGTH_INFORMATION gl = pv(irp->AssociatedIrp.SystemBuffer);
+				  gl->Length.QuadPart = hook->use_size;
+			  }
+		    break;
+			case IOCTL_DISK_GET_PARTITION_INFO:
+			  {
+				  PPARTITION_INFORMATION pi = pv(irp->AssociatedIrp.SystemBuffer);
+				  pi->PartitionLength.QuadPart = hook->use_size;				
+			  }
+		    break;
+			case IOCTL_DISK_GET_PARTITION_INFO_EX:
+			  {
+				  PPARTITION_INFORMATION_EX pi = pv(irp->AssociatedIrp.SystemBuffer);				  
+				  pi->PartitionLength.QuadPart = hook->use_size;
+			  }
+		    break;
+			case IOCTL_CDROM_GET_DRIVE_GEOMETRY_EX:
+				{
+					PDISK_GEOMETRY_EX dgx = pv(irp->AssociatedIrp.SystemBuffer);
+					dgx->DiskSize.QuadPart = hook->use_size;
+				}
+			break;
+		}
+	}
+	if ( (hook->flags & F_REMOVABLE) && (IS_VERIFY_IOCTL(ioctl) != 0) )
+	{
+		chg_c  = pv(irp->AssociatedIrp.SystemBuffer);
+		change = NT_SUCCESS(status) == FALSE;
+		
+		if (irp->IoStatus.Information == sizeof(u32)) {
+			change |= lock_xchg(&hook->chg_last_v, *chg_c) != *chg_c;
+			*chg_c += hook->chg_mount;
+		}
+
+		if ( (change != 0) && (hook->dsk_size != 0) ) {
+			DbgMsg("media removed\n");
+			dc_unmount_async(hook);
+		}	
+	}
+	IoReleaseRemoveLock(&hook->remv_lock, irp);
+
+	return STATUS_SUCCESS;
+}
+
+
+
+NTSTATUS dc_io_control_irp(dev_hook *hook, PIRP irp)
+{	
+	PIO_STACK_LOCATION irp_sp;
+	u32                ioctl;
+	
+	irp_sp = IoGetCurrentIrpStackLocation(irp);
+	ioctl  = irp_sp->Parameters.DeviceIoControl.IoControlCode;
+
+	if ( (ioctl == IOCTL_DISK_GET_LENGTH_INFO) || 
+		 (ioctl == IOCTL_DISK_GET_PARTITION_INFO) ||
+		 (ioctl == IOCTL_DISK_GET_PARTITION_INFO_EX) || 
+		 (ioctl == IOCTL_CDROM_GET_DRIVE_GEOMETRY_EX) ||
+		 (IS_VERIFY_IOCTL(ioctl) != 0) )
+	{
+		IoCopyCurrentIrpStackLocationToNext(irp);
+
+		IoSetCompletionRoutine(
+			irp, dc_ioctl_complete,	NULL, TRUE, TRUE, TRUE);
+
+		return IoCallDriver(hook->orig_dev, irp);
+	} else {
+		return dc_forward_irp(hook, irp);
+	}	
+}
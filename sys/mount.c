@@ -1,608 +1,983 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2007-2008 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <ntifs.h>
-#include "defines.h"
-#include "devhook.h"
-#include "driver.h"
-#include "misc.h"
-#include "pkcs5.h"
-#include "crc32.h"
-#include "enc_dec.h"
-#include "misc_irp.h"
-#include "readwrite.h"
-#include "mount.h"
-#include "fast_crypt.h"
-#include "misc_volume.h"
-#include "debug.h"
-#include "fsf_control.h"
-#include "misc_mem.h"
-#include "crypto_head.h"
-
-typedef struct _dsk_pass {
-	struct _dsk_pass *next;
-	dc_pass           pass;
-	
-} dsk_pass;
-
-typedef struct _mount_ctx {
-	WORK_QUEUE_ITEM  wrk_item;
-	PIRP             irp;
-	dev_hook        *hook;
-	
-} mount_ctx;
-
-static dsk_pass *f_pass;
-static ERESOURCE p_resource;
-
-
-void dc_add_password(dc_pass *pass)
-{
-	dsk_pass *d_pass;
-
-	if (pass->size != 0)
-	{
-		KeEnterCriticalRegion();
-		ExAcquireResourceExclusiveLite(&p_resource, TRUE);
-
-		for (d_pass = f_pass; d_pass; d_pass = d_pass->next)
-		{
-			if (IS_EQUAL_PASS(pass, &d_pass->pass)) {
-				break;
-			}
-		}
-
-		if ( (d_pass == NULL) && (d_pass = mm_alloc(sizeof(dsk_pass), MEM_SECURE)) )
-		{
-			autocpy(&d_pass->pass, pass, sizeof(dc_pass));
-
-			d_pass->next = f_pass;
-			f_pass       = d_pass;
-		}
-
-		ExReleaseResourceLite(&p_resource);
-		KeLeaveCriticalRegion();
-	}
-}
-
-void dc_clean_pass_cache()
-{
-	dsk_pass *d_pass;
-	dsk_pass *c_pass;
-	int       loirql;
-
-	if (loirql = (KeGetCurrentIrql() == PASSIVE_LEVEL)) {
-		KeEnterCriticalRegion();
-		ExAcquireResourceExclusiveLite(&p_resource, TRUE);
-	}
-
-	for (d_pass = f_pass; d_pass;)
-	{
-		c_pass = d_pass;
-		d_pass = d_pass->next;
-
-		zeroauto(c_pass, sizeof(dsk_pass));
-
-		if (loirql != 0) { 
-			mm_free(c_pass); 
-		}
-	}
-	f_pass = NULL;
-
-	if (loirql != 0) {
-		ExReleaseResourceLite(&p_resource);
-		KeLeaveCriticalRegion();
-	}
-}
-
-void dc_clean_keys() 
-{
-	dev_hook *hook;
-	dev_hook *next;
-
-	if (next = dc_first_hook()) 
-	{
-		do 
-		{
-			hook = next;
-			next = dc_next_hook(hook);
-
-			zeroauto(&hook->dsk_key,    sizeof(xts_key));
-			zeroauto(&hook->tmp_header, sizeof(dc_header));
-			
-			if (hook->hdr_key != NULL) {
-				zeroauto(hook->hdr_key, sizeof(xts_key));
-			}
-			if (hook->tmp_key != NULL) {
-				zeroauto(hook->tmp_key, sizeof(xts_key));
-			}
-		} while (next != NULL);
-	} 
-}
-
-void dc_init_hdr_key(xts_key *hdr_key, dc_header *header, int cipher, dc_pass *password)
-{
-	u8 dk[DISKKEY_SIZE];
-	
-	sha512_pkcs5_2(
-		1000, password->pass, password->size, 
-		header->salt, PKCS5_SALT_SIZE, dk, PKCS_DERIVE_MAX);
-
-	xts_set_key(dk, cipher, hdr_key);
-
-	/* prevent leaks */
-	zeroauto(dk, sizeof(dk));
-}
-
-static
-int dc_probe_decrypt(
-	  dev_hook *hook, dc_header *header, xts_key **res_key, dc_pass *password
-	  )
-{
-	xts_key  *hdr_key;
-	dsk_pass *d_pass;	
-	int       resl, succs;
-
-	hdr_key = NULL; succs = 0;
-	do
-	{
-		/* read volume header */
-		resl = dc_device_rw(
-			hook, IRP_MJ_READ, header, sizeof(dc_header), 0);
-		
-		if (resl != ST_OK) {
-			break;
-		}
-		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE | MEM_SUCCESS)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-
-		/* derive header key and decrypt header */
-		do
-		{
-			if (password != NULL)
-			{
-				/* probe mount with entered password */
-				if (succs = dc_decrypt_header(hdr_key, header, password)) {
-					break;
-				}
-			}
-
-			KeEnterCriticalRegion();
-			ExAcquireResourceSharedLite(&p_resource, TRUE);
-
-			/* probe mount with cached passwords */
-			for (d_pass = f_pass; d_pass; d_pass = d_pass->next)
-			{
-				if (succs = dc_decrypt_header(hdr_key, header, &d_pass->pass)) {
-					break;
-				}
-			}
-
-			ExReleaseResourceLite(&p_resource);
-			KeLeaveCriticalRegion();
-		} while (0);
-
-		if (succs != 0) {
-			*res_key = hdr_key; hdr_key = NULL; resl = ST_OK; 
-		} else {
-			resl = ST_PASS_ERR;
-		}
-	} while (0);
-
-	if (hdr_key != NULL) {
-		mm_free(hdr_key);
-	}
-	return resl;
-}
-
-int dc_mount_device(wchar_t *dev_name, dc_pass *password, u32 mnt_flags)
-{
-	dc_header *hcopy = NULL;
-	dev_hook  *hook  = NULL;
-	xts_key   *hdr_key = NULL;
-	int        resl;
-	
-	DbgMsg("dc_mount_device %ws\n", dev_name);
-
-	do 
-	{
-		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
-			resl = ST_NF_DEVICE; break;
-		}
-
-		wait_object_infinity(&hook->busy_lock);
-
-		if (hook->flags & F_ENABLED) {
-			resl = ST_ALR_MOUNT; break;
-		}
-		if (hook->flags & (F_UNSUPRT | F_DISABLE | F_FORMATTING)) {
-			resl = ST_ERROR; break;
-		}
-
-		if (dc_get_dev_params(hook) != ST_OK) {
-			resl = ST_RW_ERR; break;
-		}
-
-		if ( (dc_no_usb_mount != 0) && (hook->flags & F_REMOVABLE) ) {
-			resl = ST_NO_MEDIA; break;
-		}
-
-		if ( ( (hook->flags & F_CDROM) && (hook->bps != CD_SECTOR_SIZE) ) ||
-			 (!(hook->flags & F_CDROM) && IS_INVALID_SECTOR_SIZE(hook->bps) ) )
-		{
-			hook->flags |= F_UNSUPRT; resl = ST_ERROR; break;
-		}
-
-		if ( (hcopy = mm_alloc(sizeof(dc_header), MEM_SECURE | MEM_SUCCESS)) == NULL ) {
-			resl = ST_NOMEM; break;
-		}
-
-		resl = dc_probe_decrypt(hook, hcopy, &hdr_key, password);
-
-		if (resl != ST_OK) {
-			break;
-		}
-
-		/* check volume header */		
-		if ( (IS_INVALID_VOL_FLAGS(hcopy->flags) != 0) ||
-			 (hcopy->stor_off == 0) || (hcopy->alg_1 >= CF_CIPHERS_NUM) ||
-			 (hcopy->alg_2 >= CF_CIPHERS_NUM) || (hcopy->tmp_wp_mode >= WP_NUM) ||
-//			 (hcopy->stor_off + DC_AREA_SIZE > min(hcopy->use_size, hook->dsk_size)) ||
-			 ( (hook->flags & F_CDROM) && (hcopy->flags & (VF_TMP_MODE | VF_STORAGE_FILE)) ) )
-		{
-			resl = ST_INV_VOLUME; break;
-		}
-		
-		
-		DbgMsg("hdr_key %x\n", hdr_key);
-
-		/* initialize volume key */
-		xts_set_key(hcopy->key_1, hcopy->alg_1, &hook->dsk_key);
-
-		DbgMsg("device mounted\n");
-
-		hook->crypt.cipher_id = d8(hcopy->alg_1);
-		hook->disk_id         = hcopy->disk_id;
-		hook->vf_version      = hcopy->version;
-		hook->stor_off        = hcopy->stor_off;
-		hook->tmp_size        = 0;
-		hook->use_size        = min(hcopy->use_size, hook->dsk_size);
-		hook->mnt_flags       = mnt_flags;
-
-		DbgMsg("hook->vf_version %d\n", hook->vf_version);
-		DbgMsg("flags %x\n", hcopy->flags);
-
-		if (hcopy->flags & VF_STORAGE_FILE) {
-			hook->flags |= F_PROTECT_DCSYS;
-		}
-
-		if (hcopy->flags & VF_NO_REDIR) 
-		{
-			hook->flags |= F_NO_REDIRECT;
-
-			if (hook->stor_off + hook->use_size > hook->dsk_size) {
-				hook->use_size -= hook->stor_off;
-			}
-		}
-
-		/* start syncronous RW helper thread */		
-		if ( (resl = dc_start_rw_thread(hook)) != ST_OK ) {
-			break;
-		}
-
-		if (hcopy->flags & VF_TMP_MODE)
-		{
-			hook->tmp_size      = hcopy->tmp_size;
-			hook->hdr_key       = hdr_key;
-			hook->crypt.wp_mode = hcopy->tmp_wp_mode;			
-
-			if (hcopy->flags & VF_REENCRYPT) {
-				hook->sync_init_type = S_CONTINUE_RE_ENC;
-			} else {
-				hook->sync_init_type = S_CONTINUE_ENC;
-			}
-				
-			/* copy decrypted header to device data */
-			autocpy(&hook->tmp_header, hcopy, sizeof(dc_header));
-				
-			if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
-			{
-				zeroauto(&hook->tmp_header, sizeof(dc_header));
-				hdr_key = hook->hdr_key;
-			} else  {				
-				hdr_key = NULL; /* prevent key wiping */
-			}
-		} else {			
-			hook->flags |= F_ENABLED; resl = ST_OK;
-		}
-		/* syncronize with RW thread */
-		KeSetEvent(&hook->rw_init_event, IO_NO_INCREMENT, FALSE);
-		/* sync device flags with FS filter */
-		dc_fsf_set_flags(hook->dev_name, hook->flags);
-
-		if (resl == ST_OK) {
-			/* increment mount changes counter */
-			lock_inc(&hook->chg_mount);
-		}
-	} while (0);
-
-	if (hdr_key != NULL) { mm_free(hdr_key); }
-	if (hcopy != NULL)   { mm_free(hcopy); }
-
-	if (hook != NULL) {
-		KeReleaseMutex(&hook->busy_lock, FALSE);
-		dc_deref_hook(hook);
-	}
-	return resl;
-}
-
-/*
-   this routine process unmounting the device
-   unmount options:
-    UM_NOFSCTL - unmount without reporting to FS
-	UM_FORCE   - force unmounting
-*/
-int dc_process_unmount(dev_hook *hook, int opt)
-{
-	IO_STATUS_BLOCK iosb;
-	NTSTATUS        status;
-	HANDLE          h_dev  = NULL;
-	int             locked = 0;
-	int             resl;	
-
-	DbgMsg("dc_process_unmount\n");
-	
-	if ( !(hook->flags & F_ENABLED) ) {
-		return ST_NO_MOUNT;
-	}
-
-	wait_object_infinity(&hook->busy_lock);
-
-	do
-	{
-		if (hook->flags & F_FORMATTING) {
-			dc_format_done(hook->dev_name);
-		}
-
-		if ( !(hook->flags & F_SYSTEM) && !(opt & MF_NOFSCTL) )
-		{
-			h_dev = io_open_device(hook->dev_name);
-
-			if ( (h_dev == NULL) && !(opt & MF_FORCE) )	{
-				resl = ST_LOCK_ERR; break;
-			}
-
-			if (h_dev != NULL)
-			{
-				status = ZwFsControlFile(
-					h_dev, NULL, NULL, NULL, &iosb, FSCTL_LOCK_VOLUME, NULL, 0, NULL, 0);
-
-				if ( (NT_SUCCESS(status) == FALSE) && !(opt & MF_FORCE) ) {
-					resl = ST_LOCK_ERR; break;
-				}
-				locked = (NT_SUCCESS(status) != FALSE);
-
-				ZwFsControlFile(
-					h_dev, NULL, NULL, NULL, &iosb, FSCTL_DISMOUNT_VOLUME, NULL, 0, NULL, 0);				
-			}
-		}
-
-		if ( !(opt & MF_NOSYNC) )
-		{
-			/* temporary disable IRP processing */
-			hook->flags |= F_DISABLE;
-
-			/* wait for pending IRPs completion */
-			while (hook->remv_lock.Common.IoCount > 1) {
-				dc_delay(20);
-			}
-			if (hook->flags & F_SYNC) {
-				/* send signal to syncronous mode thread */
-				dc_send_sync_packet(hook->dev_name, S_OP_FINALIZE, 0);
-			}			
-		}
-
-		hook->flags    &= ~(F_ENABLED | F_SYNC | F_REENCRYPT | F_PROTECT_DCSYS);
-		hook->use_size  = hook->dsk_size;
-		hook->tmp_size  = 0;
-		hook->mnt_flags = 0;
-		resl            = ST_OK;
-
-		/* increment mount changes counter */
-		lock_inc(&hook->chg_mount);
-		/* stop RW thread if needed */
-		dc_stop_rw_thread(hook);
-		/* sync device flags with FS filter */
-		dc_fsf_set_flags(hook->dev_name, hook->flags);
-		/* prevent leaks */
-		zeroauto(&hook->dsk_key, sizeof(xts_key));
-
-		if ( !(opt & MF_NOSYNC) ) {
-			/* enable IRP processing */
-			hook->flags &= ~F_DISABLE;
-		}
-	} while (0);
-
-	if (h_dev != NULL) 
-	{
-		if (locked != 0) 
-		{
-			ZwFsControlFile(
-				h_dev, NULL, NULL, NULL, &iosb, FSCTL_UNLOCK_VOLUME, NULL, 0, NULL, 0);
-		}
-		ZwClose(h_dev);
-	}
-	KeReleaseMutex(&hook->busy_lock, FALSE);
-	
-	return resl;
-}
-
-static void unmount_thread_proc(mount_ctx *mnt) 
-{
-	dev_hook *hook = mnt->hook;
-	
-	dc_process_unmount(hook, MF_NOFSCTL);	
-
-	hook->dsk_size      = 0;
-	hook->use_size      = 0;
-	hook->mnt_probed    = 0;
-	hook->mnt_probe_cnt = 0;
-
-	dc_deref_hook(hook);
-	mm_free(mnt);
-	PsTerminateSystemThread(STATUS_SUCCESS);
-}
-
-static void unmount_item_proc(mount_ctx *mnt)
-{
-	if (start_system_thread(unmount_thread_proc, mnt, NULL) != ST_OK) {
-		dc_deref_hook(mnt->hook);
-		mm_free(mnt);
-	}
-}
-
-void dc_unmount_async(dev_hook *hook)
-{
-	mount_ctx *mnt;
-
-	DbgMsg("dc_unmount_async at IRQL %d\n", KeGetCurrentIrql());
-
-	if (mnt = mm_alloc(sizeof(mount_ctx), 0))
-	{
-		mnt->hook = hook; dc_reference_hook(hook);
-
-		if (KeGetCurrentIrql() != PASSIVE_LEVEL) 
-		{
-			ExInitializeWorkItem(&mnt->wrk_item, unmount_item_proc, mnt);
-			ExQueueWorkItem(&mnt->wrk_item, DelayedWorkQueue);
-		} else {
-			unmount_item_proc(mnt);
-		}
-	}
-}
-
-
-int dc_unmount_device(wchar_t *dev_name, int force)
-{
-	dev_hook *hook;
-	int       resl;
-
-	DbgMsg("dc_unmount_device %ws\n", dev_name);
-
-	if (hook = dc_find_hook(dev_name)) 
-	{
-		if (IS_UNMOUNTABLE(hook)) {
-			resl = dc_process_unmount(hook, force);
-		} else {
-			resl = ST_UNMOUNTABLE;
-		}
-		dc_deref_hook(hook);
-	} else {
-		resl = ST_NF_DEVICE;
-	}
-
-	return resl;
-}
-
-int dc_mount_all(dc_pass *password, u32 flags)
-{
-	dev_hook *hook;
-	int       num = 0;
-
-	if (hook = dc_first_hook()) 
-	{
-		do 
-		{
-			if (dc_mount_device(hook->dev_name, password, flags) == ST_OK) {
-				num++;
-			}
-		} while (hook = dc_next_hook(hook));
-	}
-
-	return num;
-}
-
-int dc_num_mount()
-{
-	dev_hook *hook;
-	int       num = 0;
-
-	if (hook = dc_first_hook()) 
-	{
-		do 
-		{
-			num += (hook->flags & F_ENABLED);		
-		} while (hook = dc_next_hook(hook));
-	}
-
-	return num;
-}
-
-static void mount_item_proc(mount_ctx *mnt)
-{
-	dev_hook *hook;
-	int       resl;
-		
-	hook = mnt->hook;
-	resl = dc_mount_device(hook->dev_name, NULL, 0);
-
-	if ( (resl != ST_RW_ERR) && (resl != ST_MEDIA_CHANGED) && (resl != ST_NO_MEDIA) ) {
-		hook->mnt_probed = 1;
-	}
-
-	if (resl != ST_OK)
-	{
-		if (lock_inc(&hook->mnt_probe_cnt) > MAX_MNT_PROBES) {
-			hook->mnt_probed = 1;
-		}
-	}
-
-	if (hook->flags & F_ENABLED) {
-		dc_read_write_irp(hook, mnt->irp);
-	} else {
-		dc_forward_irp(hook, mnt->irp);
-	}
-	mm_free(mnt);
-}
-
-NTSTATUS dc_probe_mount(dev_hook *hook, PIRP irp)
-{
-	mount_ctx *mnt;
-
-	if ( (mnt = mm_alloc(sizeof(mount_ctx), MEM_SUCCESS)) == NULL ) {
-		return dc_release_irp(hook, irp, STATUS_INSUFFICIENT_RESOURCES);
-	}
-	IoMarkIrpPending(irp);
-
-	mnt->irp  = irp;
-	mnt->hook = hook;
-		
-	ExInitializeWorkItem(&mnt->wrk_item, mount_item_proc, mnt);
-	ExQueueWorkItem(&mnt->wrk_item, DelayedWorkQueue);
-
-	return STATUS_PENDING;
-}
-
-void dc_init_mount()
-{
-	ExInitializeResourceLite(&p_resource);
-	f_pass = NULL;
-}
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2007-2008 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ntifs.h>
+#include "defines.h"
+#include "devhook.h"
+#include "driver.h"
+#include "misc.h"
+#include "pkcs5.h"
+#include "crc32.h"
+#include "enc_dec.h"
+#include "misc_irp.h"
+#include "readwrite.h"
+#include "mount.h"
+#include "fast_crypt.h"
+#include "misc_volume.h"
+#include "debug.h"
+#include "fsf_control.h"
+#include "misc_mem.h"
+#include "crypto_head.h"
+
+typedef struct _dsk_pass {
+	struct _dsk_pass *next;
+	dc_pass           pass;
+	
+} dsk_pass;
+
+#define DK_CACHE_MAX 64 /* maximum number of cached derived keys */
+
+typedef struct _dsk_key {
+	struct _dsk_key *next;
+	dsk_pass        *pass;                  /* source password            */
+	u8               salt[PKCS5_SALT_SIZE]; /* volume header salt         */
+	u8               dk[PKCS_DERIVE_MAX];   /* PBKDF2 output              */
+	int              valid;                 /* header decrypted with dk   */
+
+} dsk_key;
+
+typedef struct _mount_ctx {
+	WORK_QUEUE_ITEM  wrk_item;
+	PIRP             irp;
+	dev_hook        *hook;
+	
+} mount_ctx;
+
+typedef struct _probe_ctx {
+	dc_header *header;  /* encrypted volume header      */
+	dc_header *result;  /* decrypted header output      */
+	xts_key   *hdr_key; /* header key output            */
+	dsk_pass **pass;    /* candidate passwords          */
+	int        count;   /* number of candidates         */
+	int        next;    /* next candidate index         */
+	int        found;   /* set by successful candidate  */
+
+} probe_ctx;
+
+#define MAX_PROBE_THREADS 16
+#define MAX_MOUNT_THREADS 16
+
+typedef struct _mount_all_ctx {
+	dev_hook **hooks;    /* referenced hooks to mount */
+	int        count;    /* number of hooks           */
+	int        next;     /* next hook index           */
+	int        num;      /* mounted devices count     */
+	dc_pass   *password;
+	u32        flags;
+
+} mount_all_ctx;
+
+static dsk_pass  *f_pass;
+static ERESOURCE  p_resource;
+static dsk_key   *f_keys;
+static int        n_keys;
+static KSPIN_LOCK k_lock;
+static KSEMAPHORE probe_sem; /* limits concurrent probes of all mount threads */
+
+
+void dc_add_password(dc_pass *pass)
+{
+	dsk_pass *d_pass;
+
+	if (pass->size != 0)
+	{
+		KeEnterCriticalRegion();
+		ExAcquireResourceExclusiveLite(&p_resource, TRUE);
+
+		for (d_pass = f_pass; d_pass; d_pass = d_pass->next)
+		{
+			if (IS_EQUAL_PASS(pass, &d_pass->pass)) {
+				break;
+			}
+		}
+
+		if ( (d_pass == NULL) && (d_pass = mm_alloc(sizeof(dsk_pass), MEM_SECURE)) )
+		{
+			autocpy(&d_pass->pass, pass, sizeof(dc_pass));
+
+			d_pass->next = f_pass;
+			f_pass       = d_pass;
+		}
+
+		ExReleaseResourceLite(&p_resource);
+		KeLeaveCriticalRegion();
+	}
+}
+
+static void dc_clean_derived_keys(int loirql)
+{
+	dsk_key *d_key;
+	dsk_key *c_key;
+	KIRQL    irql;
+
+	if (loirql != 0) {
+		KeAcquireSpinLock(&k_lock, &irql);
+	}
+	d_key = f_keys; f_keys = NULL; n_keys = 0;
+
+	if (loirql != 0) {
+		KeReleaseSpinLock(&k_lock, irql);
+	}
+	for (; d_key;)
+	{
+		c_key = d_key;
+		d_key = d_key->next;
+
+		zeroauto(c_key, sizeof(dsk_key));
+
+		if (loirql != 0) { 
+			mm_free(c_key); 
+		}
+	}
+}
+
+/* lookup derived key for password and salt, returns 0 if not cached, -1 if known bad */
+static int dc_find_derived_key(dsk_pass *pass, const u8 *salt, u8 *dk)
+{
+	dsk_key *d_key;
+	KIRQL    irql;
+	int      resl = 0;
+
+	KeAcquireSpinLock(&k_lock, &irql);
+
+	for (d_key = f_keys; d_key; d_key = d_key->next)
+	{
+		if ( (d_key->pass == pass) && (memcmp(d_key->salt, salt, PKCS5_SALT_SIZE) == 0) ) 
+		{
+			if (d_key->valid != 0) {
+				autocpy(dk, d_key->dk, PKCS_DERIVE_MAX); resl = 1;
+			} else {
+				resl = -1;
+			}
+			break;
+		}
+	}
+	KeReleaseSpinLock(&k_lock, irql);
+
+	return resl;
+}
+
+static void dc_add_derived_key(dsk_pass *pass, const u8 *salt, const u8 *dk, int valid)
+{
+	dsk_key *d_key;
+	dsk_key *c_key = NULL;
+	KIRQL    irql;
+
+	if ( (d_key = mm_alloc(sizeof(dsk_key), MEM_SECURE)) == NULL ) {
+		return;
+	}
+	d_key->pass  = pass;
+	d_key->valid = valid;
+	autocpy(d_key->salt, salt, PKCS5_SALT_SIZE);
+	
+	if (valid != 0) {
+		autocpy(d_key->dk, dk, PKCS_DERIVE_MAX);
+	} else {
+		zeroauto(d_key->dk, PKCS_DERIVE_MAX);
+	}
+	KeAcquireSpinLock(&k_lock, &irql);
+
+	d_key->next = f_keys; f_keys = d_key;
+
+	/* drop oldest entry if cache is full */
+	if (++n_keys > DK_CACHE_MAX)
+	{
+		for (d_key = f_keys; d_key->next->next; d_key = d_key->next);
+		c_key = d_key->next; d_key->next = NULL; n_keys--;
+	}
+	KeReleaseSpinLock(&k_lock, irql);
+
+	if (c_key != NULL) {
+		mm_free(c_key);
+	}
+}
+
+static void dc_probe_enter()
+{
+	KeWaitForSingleObject(&probe_sem, Executive, KernelMode, FALSE, NULL);
+}
+
+static void dc_probe_leave()
+{
+	KeReleaseSemaphore(&probe_sem, IO_NO_INCREMENT, 1, FALSE);
+}
+
+/* probe entered password, concurrent probes are bounded by probe_sem */
+static int dc_probe_entered(xts_key *hdr_key, dc_header *header, dc_pass *password)
+{
+	int succs;
+
+	dc_probe_enter();
+	succs = dc_decrypt_header(hdr_key, header, password);
+	dc_probe_leave();
+
+	return succs;
+}
+
+/* probe cached password, PBKDF2 is skipped for already seen volume headers */
+static int dc_probe_password(xts_key *hdr_key, dc_header *header, dsk_pass *pass)
+{
+	u8  dk[PKCS_DERIVE_MAX];
+	int succs;
+
+	if ( !(dc_conf_flags & CONF_CACHE_KEYS) ) {
+		return dc_probe_entered(hdr_key, header, &pass->pass);
+	}
+	switch (dc_find_derived_key(pass, header->salt, dk))
+	{
+		case 1: 
+			succs = dc_decrypt_header_dk(hdr_key, header, dk);
+		break;
+		case -1: 
+			succs = 0; 
+		break;
+		default:
+			{
+				dc_probe_enter();
+
+				sha512_pkcs5_2(
+					1000, pass->pass.pass, pass->pass.size, 
+					header->salt, PKCS5_SALT_SIZE, dk, PKCS_DERIVE_MAX);
+
+				succs = dc_decrypt_header_dk(hdr_key, header, dk);
+				dc_probe_leave();
+
+				dc_add_derived_key(pass, header->salt, dk, succs);
+			}
+		break;
+	}
+	/* prevent leaks */
+	zeroauto(dk, sizeof(dk));
+
+	return succs;
+}
+
+void dc_clean_pass_cache()
+{
+	dsk_pass *d_pass;
+	dsk_pass *c_pass;
+	int       loirql;
+
+	if (loirql = (KeGetCurrentIrql() == PASSIVE_LEVEL)) {
+		KeEnterCriticalRegion();
+		ExAcquireResourceExclusiveLite(&p_resource, TRUE);
+	}
+
+	for (d_pass = f_pass; d_pass;)
+	{
+		c_pass = d_pass;
+		d_pass = d_pass->next;
+
+		zeroauto(c_pass, sizeof(dsk_pass));
+
+		if (loirql != 0) { 
+			mm_free(c_pass); 
+		}
+	}
+	f_pass = NULL;
+
+	/* derived keys are bound to cached passwords */
+	dc_clean_derived_keys(loirql);
+
+	if (loirql != 0) {
+		ExReleaseResourceLite(&p_resource);
+		KeLeaveCriticalRegion();
+	}
+}
+
+void dc_clean_keys() 
+{
+	dev_hook *hook;
+	dev_hook *next;
+
+	if (next = dc_first_hook()) 
+	{
+		do 
+		{
+			hook = next;
+			next = dc_next_hook(hook);
+
+			zeroauto(&hook->tmp_header, sizeof(dc_header));
+
+			if (hook->dsk_key != NULL) {
+				zeroauto(hook->dsk_key, hook->dsk_key->size);
+			}
+			
+			if (hook->hdr_key != NULL) {
+				zeroauto(hook->hdr_key, sizeof(xts_key));
+			}
+			if (hook->tmp_key != NULL) {
+				zeroauto(hook->tmp_key, hook->tmp_key->size);
+			}
+		} while (next != NULL);
+	} 
+}
+
+/*
+   set volume key of device which is not enabled, key block of previous mount
+   is released here because requests may use it until unmount completes
+*/
+int dc_set_dsk_key(dev_hook *hook, const u8 *key, int alg, u32 unit_size)
+{
+	xts_key *d_key, *o_key;
+
+	if ( (d_key = mm_alloc(xts_key_size(alg), MEM_SECURE)) == NULL ) {
+		return ST_NOMEM;
+	}
+	xts_set_key(key, alg, d_key);
+	xts_set_unit(d_key, unit_size);
+
+	o_key = hook->dsk_key; hook->dsk_key = d_key;
+
+	if (o_key != NULL) { mm_free(o_key); }
+	return ST_OK;
+}
+
+void dc_init_hdr_key(xts_key *hdr_key, dc_header *header, int cipher, dc_pass *password)
+{
+	u8 dk[DISKKEY_SIZE];
+	
+	sha512_pkcs5_2(
+		1000, password->pass, password->size, 
+		header->salt, PKCS5_SALT_SIZE, dk, PKCS_DERIVE_MAX);
+
+	xts_set_key(dk, cipher, hdr_key);
+
+	/* prevent leaks */
+	zeroauto(dk, sizeof(dk));
+}
+
+static void dc_probe_worker(probe_ctx *ctx)
+{
+	dc_header *header  = mm_alloc(sizeof(dc_header), MEM_SECURE);
+	xts_key   *hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE);
+	int        i;
+
+	if ( (header != NULL) && (hdr_key != NULL) )
+	{
+		/* take next candidate until all probed or one of them succeeds */
+		while ( (ctx->found == 0) && ((i = lock_inc(&ctx->next) - 1) < ctx->count) )
+		{
+			autocpy(header, ctx->header, sizeof(dc_header));
+
+			if (dc_probe_password(hdr_key, header, ctx->pass[i]) == 0) {
+				continue;
+			}
+			if (lock_xchg(&ctx->found, 1) == 0) {
+				autocpy(ctx->result, header, sizeof(dc_header));
+				autocpy(ctx->hdr_key, hdr_key, sizeof(xts_key));
+			}
+		}
+	}
+	if (header != NULL) {
+		zeroauto(header, sizeof(dc_header)); mm_free(header);
+	}
+	if (hdr_key != NULL) {
+		zeroauto(hdr_key, sizeof(xts_key)); mm_free(hdr_key);
+	}
+}
+
+static void dc_probe_thread(probe_ctx *ctx)
+{
+	dc_probe_worker(ctx);
+	PsTerminateSystemThread(STATUS_SUCCESS);
+}
+
+/* must be called with p_resource acquired */
+static int dc_probe_cached(dc_header *header, xts_key *hdr_key)
+{
+	HANDLE    threads[MAX_PROBE_THREADS];
+	probe_ctx ctx;
+	dsk_pass *d_pass;
+	int       n_thread, i;
+
+	zeroauto(&ctx, sizeof(ctx));
+
+	for (d_pass = f_pass; d_pass; d_pass = d_pass->next) ctx.count++;
+
+	do
+	{
+		/* fan out cached passwords across dedicated threads, crypt worker pool
+		   and one CPU are left free for encrypted I/O on mounted volumes */
+		if ( (ctx.count < 2) || (dc_cpu_count < 2) ) {
+			break;
+		}
+		if ( (ctx.pass = mm_alloc(ctx.count * sizeof(dsk_pass*), 0)) == NULL ) {
+			break;
+		}
+		if ( (ctx.header = mm_alloc(sizeof(dc_header), 0)) == NULL ) {
+			break;
+		}
+		for (i = 0, d_pass = f_pass; d_pass; d_pass = d_pass->next) {
+			ctx.pass[i++] = d_pass;
+		}
+		autocpy(ctx.header, header, sizeof(dc_header));
+		ctx.result  = header;
+		ctx.hdr_key = hdr_key;
+
+		for (n_thread = 0; n_thread < min(min(ctx.count, dc_cpu_count - 1), MAX_PROBE_THREADS) - 1; n_thread++)
+		{
+			if (start_system_thread(dc_probe_thread, &ctx, &threads[n_thread]) != ST_OK) {
+				break;
+			}
+		}
+		dc_probe_worker(&ctx);
+
+		for (i = 0; i < n_thread; i++) {
+			ZwWaitForSingleObject(threads[i], FALSE, NULL);
+			ZwClose(threads[i]);
+		}
+	} while (0);
+
+	if (ctx.found == 0)
+	{
+		/* probe sequentially candidates not taken by the workers */
+		for (i = 0, d_pass = f_pass; d_pass; d_pass = d_pass->next, i++)
+		{
+			if (i < ctx.next) continue;
+
+			if (ctx.found = dc_probe_password(hdr_key, header, d_pass)) {
+				break;
+			}
+		}
+	}
+	if (ctx.pass != NULL) {
+		mm_free(ctx.pass);
+	}
+	if (ctx.header != NULL) {
+		mm_free(ctx.header);
+	}
+
+	return ctx.found;
+}
+
+static
+int dc_probe_decrypt(
+	  dev_hook *hook, dc_header *header, xts_key **res_key, dc_pass *password
+	  )
+{
+	xts_key  *hdr_key;
+	int       resl, succs;
+
+	hdr_key = NULL; succs = 0;
+	do
+	{
+		/* read volume header */
+		resl = dc_device_rw(
+			hook, IRP_MJ_READ, header, sizeof(dc_header), 0);
+		
+		if (resl != ST_OK) {
+			break;
+		}
+		if ( (hdr_key = mm_alloc(sizeof(xts_key), MEM_SECURE | MEM_SUCCESS)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+
+		/* derive header key and decrypt header */
+		do
+		{
+			if (password != NULL)
+			{
+				/* probe mount with entered password */
+				if (succs = dc_probe_entered(hdr_key, header, password)) {
+					break;
+				}
+			}
+
+			KeEnterCriticalRegion();
+			ExAcquireResourceSharedLite(&p_resource, TRUE);
+
+			/* probe mount with cached passwords */
+			succs = dc_probe_cached(header, hdr_key);
+
+			ExReleaseResourceLite(&p_resource);
+			KeLeaveCriticalRegion();
+		} while (0);
+
+		if (succs != 0) {
+			*res_key = hdr_key; hdr_key = NULL; resl = ST_OK; 
+		} else {
+			resl = ST_PASS_ERR;
+		}
+	} while (0);
+
+	if (hdr_key != NULL) {
+		mm_free(hdr_key);
+	}
+	return resl;
+}
+
+int dc_mount_device(wchar_t *dev_name, dc_pass *password, u32 mnt_flags)
+{
+	dc_header *hcopy = NULL;
+	dev_hook  *hook  = NULL;
+	xts_key   *hdr_key = NULL;
+	u32        time    = dc_get_time_us();
+	int        resl;
+	
+	DbgMsg("dc_mount_device %ws\n", dev_name);
+
+	do 
+	{
+		if ( (hook = dc_find_hook(dev_name)) == NULL ) {
+			resl = ST_NF_DEVICE; break;
+		}
+
+		wait_object_infinity(&hook->busy_lock);
+
+		if (hook->flags & F_ENABLED) {
+			resl = ST_ALR_MOUNT; break;
+		}
+		if (hook->flags & (F_UNSUPRT | F_DISABLE | F_FORMATTING)) {
+			resl = ST_ERROR; break;
+		}
+
+		if (dc_get_dev_params(hook) != ST_OK) {
+			resl = ST_RW_ERR; break;
+		}
+
+		if ( (dc_no_usb_mount != 0) && (hook->flags & F_REMOVABLE) ) {
+			resl = ST_NO_MEDIA; break;
+		}
+
+		if ( ( (hook->flags & F_CDROM) && (hook->bps != CD_SECTOR_SIZE) ) ||
+			 (!(hook->flags & F_CDROM) && IS_INVALID_SECTOR_SIZE(hook->bps) ) )
+		{
+			hook->flags |= F_UNSUPRT; resl = ST_ERROR; break;
+		}
+
+		if ( (hcopy = mm_alloc(sizeof(dc_header), MEM_SECURE | MEM_SUCCESS)) == NULL ) {
+			resl = ST_NOMEM; break;
+		}
+
+		resl = dc_probe_decrypt(hook, hcopy, &hdr_key, password);
+
+		if (resl != ST_OK) {
+			break;
+		}
+
+		/* check volume header */		
+		if ( (IS_INVALID_VOL_FLAGS(hcopy->flags) != 0) ||
+			 (hcopy->stor_off == 0) || (hcopy->alg_1 >= CF_CIPHERS_NUM) ||
+			 (hcopy->alg_2 >= CF_CIPHERS_NUM) || (hcopy->tmp_wp_mode >= WP_NUM) ||
+			 (hcopy->version > DC_HDR_VERSION) ||
+			 (IS_INVALID_UNIT_SIZE(DC_UNIT_SIZE(hcopy, unit_size)) != 0) ||
+			 ( (hcopy->flags & VF_REENCRYPT) && (IS_INVALID_UNIT_SIZE(DC_UNIT_SIZE(hcopy, unit_size_2)) != 0) ) ||
+//			 (hcopy->stor_off + DC_AREA_SIZE > min(hcopy->use_size, hook->dsk_size)) ||
+			 ( (hook->flags & F_CDROM) && (hcopy->flags & (VF_TMP_MODE | VF_STORAGE_FILE)) ) )
+		{
+			resl = ST_INV_VOLUME; break;
+		}
+		
+		
+		DbgMsg("hdr_key %x\n", hdr_key);
+
+		/* initialize volume key */
+		if ( (resl = dc_set_dsk_key(hook, hcopy->key_1, hcopy->alg_1, DC_UNIT_SIZE(hcopy, unit_size))) != ST_OK ) {
+			break;
+		}
+
+		DbgMsg("device mounted\n");
+
+		hook->crypt.cipher_id = d8(hcopy->alg_1);
+		hook->crypt.unit_size = DC_UNIT_SIZE(hcopy, unit_size);
+		hook->disk_id         = hcopy->disk_id;
+		hook->vf_version      = hcopy->version;
+		hook->stor_off        = hcopy->stor_off;
+		hook->tmp_size        = 0;
+		hook->use_size        = min(hcopy->use_size, hook->dsk_size);
+		hook->mnt_flags       = mnt_flags;
+
+		DbgMsg("hook->vf_version %d\n", hook->vf_version);
+		DbgMsg("flags %x\n", hcopy->flags);
+
+		if (hcopy->flags & VF_STORAGE_FILE) {
+			hook->flags |= F_PROTECT_DCSYS;
+		}
+
+		if (hcopy->flags & VF_NO_REDIR) 
+		{
+			hook->flags |= F_NO_REDIRECT;
+
+			if (hook->stor_off + hook->use_size > hook->dsk_size) {
+				hook->use_size -= hook->stor_off;
+			}
+		}
+
+		/* start syncronous RW helper thread */		
+		if ( (resl = dc_start_rw_thread(hook)) != ST_OK ) {
+			break;
+		}
+
+		if (hcopy->flags & VF_TMP_MODE)
+		{
+			hook->tmp_size      = hcopy->tmp_size;
+			hook->hdr_key       = hdr_key;
+			hook->crypt.wp_mode = hcopy->tmp_wp_mode;			
+
+			if (hcopy->flags & VF_REENCRYPT) {
+				hook->sync_init_type = S_CONTINUE_RE_ENC;
+			} else {
+				hook->sync_init_type = S_CONTINUE_ENC;
+			}
+				
+			/* copy decrypted header to device data */
+			autocpy(&hook->tmp_header, hcopy, sizeof(dc_header));
+				
+			if ( (resl = dc_enable_sync_mode(hook)) != ST_OK ) 
+			{
+				zeroauto(&hook->tmp_header, sizeof(dc_header));
+				hdr_key = hook->hdr_key;
+			} else  {				
+				hdr_key = NULL; /* prevent key wiping */
+			}
+		} else {			
+			hook->flags |= F_ENABLED; resl = ST_OK;
+		}
+		/* syncronize with RW thread */
+		KeSetEvent(&hook->rw_init_event, IO_NO_INCREMENT, FALSE);
+		/* sync device flags with FS filter */
+		dc_fsf_set_flags(hook->dev_name, hook->flags);
+
+		if (resl == ST_OK) {
+			/* increment mount changes counter */
+			lock_inc(&hook->chg_mount);
+		}
+	} while (0);
+
+	if (hdr_key != NULL) { mm_free(hdr_key); }
+	if (hcopy != NULL)   { mm_free(hcopy); }
+
+	if (hook != NULL) {
+		hook->mnt_time = (dc_get_time_us() - time) / 1000;
+		DbgMsg("mount %ws status %d, %d ms\n", dev_name, resl, hook->mnt_time);
+		dc_hooks_changed();
+
+		KeReleaseMutex(&hook->busy_lock, FALSE);
+		dc_deref_hook(hook);
+	}
+	return resl;
+}
+
+/*
+   this routine process unmounting the device
+   unmount options:
+    UM_NOFSCTL - unmount without reporting to FS
+	UM_FORCE   - force unmounting
+*/
+int dc_process_unmount(dev_hook *hook, int opt)
+{
+	IO_STATUS_BLOCK iosb;
+	NTSTATUS        status;
+	HANDLE          h_dev  = NULL;
+	int             locked = 0;
+	int             resl;	
+
+	DbgMsg("dc_process_unmount\n");
+	
+	if ( !(hook->flags & F_ENABLED) ) {
+		return ST_NO_MOUNT;
+	}
+
+	wait_object_infinity(&hook->busy_lock);
+
+	do
+	{
+		if (hook->flags & F_FORMATTING) {
+			dc_format_done(hook->dev_name);
+		}
+
+		if ( !(hook->flags & F_SYSTEM) && !(opt & MF_NOFSCTL) )
+		{
+			h_dev = io_open_device(hook->dev_name);
+
+			if ( (h_dev == NULL) && !(opt & MF_FORCE) )	{
+				resl = ST_LOCK_ERR; break;
+			}
+
+			if (h_dev != NULL)
+			{
+				status = ZwFsControlFile(
+					h_dev, NULL, NULL, NULL, &iosb, FSCTL_LOCK_VOLUME, NULL, 0, NULL, 0);
+
+				if ( (NT_SUCCESS(status) == FALSE) && !(opt & MF_FORCE) ) {
+					resl = ST_LOCK_ERR; break;
+				}
+				locked = (NT_SUCCESS(status) != FALSE);
+
+				ZwFsControlFile(
+					h_dev, NULL, NULL, NULL, &iosb, FSCTL_DISMOUNT_VOLUME, NULL, 0, NULL, 0);				
+			}
+		}
+
+		if ( !(opt & MF_NOSYNC) )
+		{
+			/* temporary disable IRP processing */
+			hook->flags |= F_DISABLE;
+
+			/* wait for pending IRPs completion */
+			while (hook->remv_lock.Common.IoCount > 1) {
+				dc_delay(20);
+			}
+			if (hook->flags & F_SYNC) {
+				/* send signal to syncronous mode thread */
+				dc_send_sync_packet(hook->dev_name, S_OP_FINALIZE, 0);
+			}			
+		}
+
+		hook->flags    &= ~(F_ENABLED | F_SYNC | F_REENCRYPT | F_PROTECT_DCSYS);
+		hook->use_size  = hook->dsk_size;
+		hook->tmp_size  = 0;
+		hook->mnt_flags = 0;
+		resl            = ST_OK;
+
+		/* increment mount changes counter */
+		lock_inc(&hook->chg_mount);
+		dc_hooks_changed();
+		/* stop RW thread if needed */
+		dc_stop_rw_thread(hook);
+		/* sync device flags with FS filter */
+		dc_fsf_set_flags(hook->dev_name, hook->flags);
+		/* prevent leaks, key block is released on next mount */
+		zeroauto(hook->dsk_key, hook->dsk_key->size);
+
+		if ( !(opt & MF_NOSYNC) ) {
+			/* enable IRP processing */
+			hook->flags &= ~F_DISABLE;
+		}
+	} while (0);
+
+	if (h_dev != NULL) 
+	{
+		if (locked != 0) 
+		{
+			ZwFsControlFile(
+				h_dev, NULL, NULL, NULL, &iosb, FSCTL_UNLOCK_VOLUME, NULL, 0, NULL, 0);
+		}
+		ZwClose(h_dev);
+	}
+	KeReleaseMutex(&hook->busy_lock, FALSE);
+	
+	return resl;
+}
+
+static void unmount_thread_proc(mount_ctx *mnt) 
+{
+	dev_hook *hook = mnt->hook;
+	
+	dc_process_unmount(hook, MF_NOFSCTL);	
+
+	hook->dsk_size      = 0;
+	hook->use_size      = 0;
+	hook->mnt_probed    = 0;
+	hook->mnt_probe_cnt = 0;
+
+	/* bad regions is invalid for new media */
+	dc_reset_bad_blocks(hook);
+
+	dc_deref_hook(hook);
+	mm_free(mnt);
+	PsTerminateSystemThread(STATUS_SUCCESS);
+}
+
+static void unmount_item_proc(mount_ctx *mnt)
+{
+	if (start_system_thread(unmount_thread_proc, mnt, NULL) != ST_OK) {
+		dc_deref_hook(mnt->hook);
+		mm_free(mnt);
+	}
+}
+
+void dc_unmount_async(dev_hook *hook)
+{
+	mount_ctx *mnt;
+
+	DbgMsg("dc_unmount_async at IRQL %d\n", KeGetCurrentIrql());
+
+	if (mnt = mm_alloc(sizeof(mount_ctx), 0))
+	{
+		mnt->hook = hook; dc_reference_hook(hook);
+
+		if (KeGetCurrentIrql() != PASSIVE_LEVEL) 
+		{
+			ExInitializeWorkItem(&mnt->wrk_item, unmount_item_proc, mnt);
+			ExQueueWorkItem(&mnt->wrk_item, DelayedWorkQueue);
+		} else {
+			unmount_item_proc(mnt);
+		}
+	}
+}
+
+
+int dc_unmount_device(wchar_t *dev_name, int force)
+{
+	dev_hook *hook;
+	int       resl;
+
+	DbgMsg("dc_unmount_device %ws\n", dev_name);
+
+	if (hook = dc_find_hook(dev_name)) 
+	{
+		if (IS_UNMOUNTABLE(hook)) {
+			resl = dc_process_unmount(hook, force);
+		} else {
+			resl = ST_UNMOUNTABLE;
+		}
+		dc_deref_hook(hook);
+	} else {
+		resl = ST_NF_DEVICE;
+	}
+
+	return resl;
+}
+
+static void dc_mount_all_worker(mount_all_ctx *ctx)
+{
+	int i;
+
+	while ( (i = lock_inc(&ctx->next) - 1) < ctx->count )
+	{
+		if (dc_mount_device(ctx->hooks[i]->dev_name, ctx->password, ctx->flags) == ST_OK) {
+			lock_inc(&ctx->num);
+		}
+	}
+}
+
+static void dc_mount_all_thread(mount_all_ctx *ctx)
+{
+	dc_mount_all_worker(ctx);
+	PsTerminateSystemThread(STATUS_SUCCESS);
+}
+
+int dc_mount_all(dc_pass *password, u32 flags)
+{
+	HANDLE        threads[MAX_MOUNT_THREADS];
+	mount_all_ctx ctx;
+	dev_hook     *hook;
+	int           n_hook, n_thread, i;
+
+	zeroauto(&ctx, sizeof(ctx));
+	ctx.password = password;
+	ctx.flags    = flags;
+
+	for (n_hook = 0, hook = dc_first_hook(); hook != NULL; hook = dc_next_hook(hook)) {
+		n_hook++;
+	}
+	if ( (n_hook == 0) || (ctx.hooks = mm_alloc(n_hook * sizeof(dev_hook*), 0)) == NULL ) {
+		return 0;
+	}
+	/* reference hooks to release list lock while mounting */
+	for (hook = dc_first_hook(); hook != NULL; hook = dc_next_hook(hook))
+	{
+		if (ctx.count < n_hook) {
+			dc_reference_hook(hook); ctx.hooks[ctx.count++] = hook;
+		}
+	}
+	/* header reads and key derivation of each device run concurrently,
+	   key install is serialized by per-hook busy_lock in dc_mount_device */
+	for (n_thread = 0; n_thread < min(ctx.count - 1, MAX_MOUNT_THREADS); n_thread++)
+	{
+		if (start_system_thread(dc_mount_all_thread, &ctx, &threads[n_thread]) != ST_OK) {
+			break;
+		}
+	}
+	dc_mount_all_worker(&ctx);
+
+	for (i = 0; i < n_thread; i++) {
+		ZwWaitForSingleObject(threads[i], FALSE, NULL);
+		ZwClose(threads[i]);
+	}
+	for (i = 0; i < ctx.count; i++) {
+		dc_deref_hook(ctx.hooks[i]);
+	}
+	mm_free(ctx.hooks);
+
+	return ctx.num;
+}
+
+int dc_num_mount()
+{
+	dev_hook *hook;
+	int       num = 0;
+
+	if (hook = dc_first_hook()) 
+	{
+		do 
+		{
+			num += (hook->flags & F_ENABLED);		
+		} while (hook = dc_next_hook(hook));
+	}
+
+	return num;
+}
+
+static void mount_item_proc(mount_ctx *mnt)
+{
+	dev_hook *hook;
+	int       resl;
+		
+	hook = mnt->hook;
+	resl = dc_mount_device(hook->dev_name, NULL, 0);
+
+	if ( (resl != ST_RW_ERR) && (resl != ST_MEDIA_CHANGED) && (resl != ST_NO_MEDIA) ) {
+		hook->mnt_probed = 1;
+	}
+
+	if (resl != ST_OK)
+	{
+		if (lock_inc(&hook->mnt_probe_cnt) > MAX_MNT_PROBES) {
+			hook->mnt_probed = 1;
+		}
+	}
+
+	if (hook->flags & F_ENABLED) {
+		dc_read_write_irp(hook, mnt->irp);
+	} else {
+		dc_forward_irp(hook, mnt->irp);
+	}
+	mm_free(mnt);
+}
+
+NTSTATUS dc_probe_mount(dev_hook *hook, PIRP irp)
+{
+	mount_ctx *mnt;
+
+	if ( (mnt = mm_alloc(sizeof(mount_ctx), MEM_SUCCESS)) == NULL ) {
+		return dc_release_irp(hook, irp, STATUS_INSUFFICIENT_RESOURCES);
+	}
+	IoMarkIrpPending(irp);
+
+	mnt->irp  = irp;
+	mnt->hook = hook;
+		
+	ExInitializeWorkItem(&mnt->wrk_item, mount_item_proc, mnt);
+	ExQueueWorkItem(&mnt->wrk_item, DelayedWorkQueue);
+
+	return STATUS_PENDING;
+}
+
+void dc_init_mount()
+{
+	ExInitializeResourceLite(&p_resource);
+	KeInitializeSpinLock(&k_lock);
+	/* header probes of all mount threads leave one CPU for encrypted I/O */
+	KeInitializeSemaphore(&probe_sem, max(dc_cpu_count - 1, 1), max(dc_cpu_count - 1, 1));
+	f_pass = NULL;
+}
@@ -1,269 +1,460 @@
-/*
-    *
-    * DiskCryptor - open source partition encryption tool
-    * Copyright (c) 2007-2009 
-    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
-    *
-
-    This program is free software: you can redistribute it and/or modify
-    it under the terms of the GNU General Public License version 3 as
-    published by the Free Software Foundation.
-
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
-
-    You should have received a copy of the GNU General Public License
-    along with this program.  If not, see <http://www.gnu.org/licenses/>.
-*/
-
-#include <ntifs.h>
-#include "defines.h"
-#include "prng.h"
-#include "sha512.h"
-#include "misc.h"
-#include "aes_key.h"
-#include "aes_asm.h"
-#include "debug.h"
-#include "misc_mem.h"
-
-typedef struct _seed_data {
-	PEPROCESS       seed1;
-	HANDLE          seed2;
-	PKTHREAD        seed3;
-	HANDLE          seed4;
-	ULONG           seed5;
-	ULONGLONG       seed6;
-	KPRIORITY       seed7;
-	ULONG           seed8;
-	ULONG           seed9;
-	LARGE_INTEGER   seed10;
-	ULONGLONG       seed11;
-	KPROCESSOR_MODE seed12;
-	PVOID           seed13;
-	PIRP            seed14;
-	MM_SYSTEMSIZE   seed15;
-	LARGE_INTEGER   seed16;
-	NTSTATUS        seed17;
-	UUID            seed18;	
-	ULONG           seed19;	
-	LARGE_INTEGER   seed20;
-	LARGE_INTEGER   seed21;
-	ULONG_PTR       seed22;
-	ULONG_PTR       seed23;
-	KIRQL           seed24;
-		  
-} seed_data;
-
-typedef struct _ext_seed {
-	u64 seed1;
-	u64 seed2;
-
-} ext_seed;
-
-#define RNG_POOL_SIZE 640
-
-static u8          key_pool[AES_KEY_SIZE];  /* key for encrypt output data */
-static u8          rnd_pool[RNG_POOL_SIZE]; /* random data pool            */
-static int         rnd_pos;     /* position for add new data to pool */
-static u64         reseed_cnt;  /* reseed counter  */
-static u64         getrnd_cnt;  /* getrand counter */
-static KMUTEX      rnd_mutex;
-static aes256_key *rnd_key;
-
-static void rnd_pool_mix()
-{
-	sha512_ctx sha_ctx;
-	int        i, n;
-	u8         hval[SHA512_DIGEST_SIZE];
-
-	for (i = 0; i < RNG_POOL_SIZE; i += SHA512_DIGEST_SIZE)
-	{
-		sha512_init(&sha_ctx);
-		sha512_hash(&sha_ctx, rnd_pool, sizeof(rnd_pool));
-		sha512_done(&sha_ctx, hval);
-
-		for (n = 0; n < SHA512_DIGEST_SIZE; n++) {
-			rnd_pool[i + n] += hval[n];
-		}
-	}
-
-	/* Prevent leaks */
-	zeroauto(hval, sizeof(hval));
-	zeroauto(&sha_ctx, sizeof(sha_ctx));
-}
-
-
-
-void rnd_add_buff(void *data, int size)
-{
-	sha512_ctx sha_ctx;
-	ext_seed   seed;
-	u8         hval[SHA512_DIGEST_SIZE];
-	int        pos, i;
-
-	/* add counter and timestamp to seed data to prevent hash recurrence */
-	seed.seed1 = __rdtsc();
-	seed.seed2 = reseed_cnt++;
-
-	/* hash input data */
-	sha512_init(&sha_ctx);
-	sha512_hash(&sha_ctx, data, size);
-	sha512_hash(&sha_ctx, pv(&seed), sizeof(seed));
-	sha512_done(&sha_ctx, hval);
-
-	/* add hash value to seed buffer */
-	for (i = 0; i < SHA512_DIGEST_SIZE; i++)
-	{
-		if ( (pos = rnd_pos) >= RNG_POOL_SIZE) {
-			pos = 0; 
-		}
-
-		rnd_pool[pos] += hval[i];
-		rnd_pos        = pos + 1;
-	}
-
-	/* add hash value to key buffer */
-	for (i = 0; i < SHA512_DIGEST_SIZE; i++) {
-		key_pool[i % AES_KEY_SIZE] += hval[i];
-	}
-	
-	/* prevent leaks */
-	zeroauto(&sha_ctx, sizeof(sha_ctx));
-	zeroauto(&hval, sizeof(hval));
-	zeroauto(&seed, sizeof(seed));
-}
-
-
-
-void rnd_reseed_now()
-{
-	seed_data seed;
-
-	KeQuerySystemTime(&seed.seed20);
-	
-	seed.seed1  = PsGetCurrentProcess();
-	seed.seed2  = PsGetCurrentProcessId();
-	seed.seed3  = KeGetCurrentThread();
-	seed.seed4  = PsGetCurrentThreadId();
-	seed.seed5  = KeGetCurrentProcessorNumber();
-	seed.seed6  = KeQueryInterruptTime();
-	seed.seed10 = KeQueryPerformanceCounter(NULL);
-	seed.seed11 = __rdtsc();
-	seed.seed12 = ExGetPreviousMode();	
-	seed.seed14 = IoGetTopLevelIrp();
-	seed.seed15 = MmQuerySystemSize();
-	seed.seed24 = KeGetCurrentIrql();
-	
-	if (KeGetCurrentIrql() == PASSIVE_LEVEL) {
-		seed.seed7  = KeQueryPriorityThread(seed.seed3);
-		seed.seed17 = ExUuidCreate(&seed.seed18);
-		seed.seed19 = RtlRandom(&seed.seed8);
-	}
-	if (KeGetCurrentIrql() <= APC_LEVEL) {
-		seed.seed13 = IoGetInitialStack();
-		seed.seed16 = PsGetProcessExitTime();
-		IoGetStackLimits(&seed.seed22, &seed.seed23);
-	}	
-	KeQueryTickCount(&seed.seed21);
-	
-	rnd_add_buff(&seed, sizeof(seed));
-	
-	/* Prevent leaks */	
-	zeroauto(&seed, sizeof(seed));
-}
-
-int rnd_get_bytes(u8 *buf, int len)
-{
-	sha512_ctx sha_ctx;
-	u8         hval[SHA512_DIGEST_SIZE];
-	int        c_len, idx, i;
-	ext_seed   seed;
-	int        fail;
-
-	if (reseed_cnt < 256) {
-		DbgMsg("RNG not have sufficient entropy (%d reseeds), collect it now\n", reseed_cnt);
-	}
-	/* in RNG not have sufficient entropy, then collect it now */
-	while (reseed_cnt < 256) 
-	{
-		dc_delay(1); /* wait 1 millisecond */
-		rnd_reseed_now();
-	}
-
-	wait_object_infinity(&rnd_mutex);
-
-	/* derive AES key from key pool */
-	aes256_asm_set_key(key_pool, rnd_key);
-
-	/* mix pool state before get data from it */
-	rnd_pool_mix();
-
-	/* idx - position for extraction pool data */
-	idx = 0; fail = 0;
-	do
-	{
-		c_len      = min(len, SHA512_DIGEST_SIZE);
-		seed.seed1 = getrnd_cnt++;
-		seed.seed2 = len;
-
-		/* collect additional entropy before extract data block */
-		rnd_reseed_now();
-
-		sha512_init(&sha_ctx);
-		sha512_hash(&sha_ctx, rnd_pool + idx, SHA512_DIGEST_SIZE);
-		sha512_hash(&sha_ctx, pv(&seed), sizeof(seed));
-		sha512_done(&sha_ctx, hval);
-
-		/* encrypt hash value with AES in ECB mode */		
-		for (i = 0; i < SHA512_DIGEST_SIZE; i += AES_BLOCK_SIZE) {
-			aes256_asm_encrypt(hval + i, hval + i, rnd_key);
-		}
-
-		/* copy data to output */
-		__try {
-			memcpy(buf, hval, c_len);
-		}
-		__except(EXCEPTION_EXECUTE_HANDLER) {
-			fail = 1;
-		}
-
-		/* increment extraction pointer */
-		if ( (idx += SHA512_DIGEST_SIZE) == RNG_POOL_SIZE ) {
-			/* if all data from pool extracted then 
-			  mix pool for use new entropy added with reseeds */
-			rnd_pool_mix(); idx = 0; 
-		}
-
-		/* collect additional entropy after extract data block */		
-		rnd_reseed_now();
-
-		/* update buffer pointer and remaining length */
-		buf += c_len; len -= c_len;
-	} while ( (len != 0) && (fail == 0) );
-
-	/* mix pool after get data to prevent "could boot" attacks to generated keys */
-	rnd_pool_mix();
-
-	/* Prevent leaks */
-	zeroauto(rnd_key, sizeof(aes256_key));
-	zeroauto(&sha_ctx, sizeof(sha_ctx));
-	zeroauto(hval, sizeof(hval));
-	zeroauto(&seed, sizeof(seed));
-
-	KeReleaseMutex(&rnd_mutex, FALSE);
-
-	return fail == 0;
-}
-
-int rnd_init_prng()
-{
-	if ( (rnd_key = mm_alloc(sizeof(aes256_key), MEM_SECURE)) == NULL ) {
-		return ST_NOMEM;
-	}
-	KeInitializeMutex(&rnd_mutex, 0);
-	rnd_reseed_now();
-
-	return ST_OK;
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2007-2009 
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ntifs.h>
+#include "defines.h"
+#include "prng.h"
+#include "sha512.h"
+#include "misc.h"
+#include "aes_key.h"
+#include "aes_asm.h"
+#include "xts_fast.h"
+#include "driver.h"
+#include "debug.h"
+#include "misc_mem.h"
+
+typedef struct _seed_data {
+	PEPROCESS       seed1;
+	HANDLE          seed2;
+	PKTHREAD        seed3;
+	HANDLE          seed4;
+	ULONG           seed5;
+	ULONGLONG       seed6;
+	KPRIORITY       seed7;
+	ULONG           seed8;
+	ULONG           seed9;
+	LARGE_INTEGER   seed10;
+	ULONGLONG       seed11;
+	KPROCESSOR_MODE seed12;
+	PVOID           seed13;
+	PIRP            seed14;
+	MM_SYSTEMSIZE   seed15;
+	LARGE_INTEGER   seed16;
+	NTSTATUS        seed17;
+	UUID            seed18;	
+	ULONG           seed19;	
+	LARGE_INTEGER   seed20;
+	LARGE_INTEGER   seed21;
+	ULONG_PTR       seed22;
+	ULONG_PTR       seed23;
+	KIRQL           seed24;
+		  
+} seed_data;
+
+typedef struct _ext_seed {
+	u64 seed1;
+	u64 seed2;
+
+} ext_seed;
+
+typedef struct _rnd_sample {
+	u64   tsc;
+	void *irp;
+	u64   offset;
+
+} rnd_sample;
+
+typedef struct _rnd_cpu_buf {
+	rnd_sample samples[RND_SAMPLES];
+	int        count; /* number of stored samples */
+	KSPIN_LOCK lock;
+
+} rnd_cpu_buf;
+
+typedef struct _rnd_drbg {
+	xts_key key;  /* AES key for counter mode generation */
+	u64     left; /* bytes left before reseed from entropy pool */
+	int     busy;
+
+} rnd_drbg;
+
+#define RNG_POOL_SIZE 640
+
+static u8          key_pool[AES_KEY_SIZE];  /* key for encrypt output data */
+static u8          rnd_pool[RNG_POOL_SIZE]; /* random data pool            */
+static int         rnd_pos;     /* position for add new data to pool */
+static u64         reseed_cnt;  /* reseed counter  */
+static u64         getrnd_cnt;  /* getrand counter */
+static KMUTEX      rnd_mutex;
+static aes256_key *rnd_key;
+static rnd_drbg   *rnd_drbgs;   /* per-CPU DRBG instances */
+static int         rnd_drbg_num;
+
+static rnd_cpu_buf    *rnd_cpu_bufs; /* per-CPU raw I/O samples */
+static int             rnd_cpu_num;
+static WORK_QUEUE_ITEM rnd_wrk_item;
+static int             rnd_wrk_queued;
+
+static void rnd_pool_mix()
+{
+	sha512_ctx sha_ctx;
+	int        i, n;
+	u8         hval[SHA512_DIGEST_SIZE];
+
+	for (i = 0; i < RNG_POOL_SIZE; i += SHA512_DIGEST_SIZE)
+	{
+		sha512_init(&sha_ctx);
+		sha512_hash(&sha_ctx, rnd_pool, sizeof(rnd_pool));
+		sha512_done(&sha_ctx, hval);
+
+		for (n = 0; n < SHA512_DIGEST_SIZE; n++) {
+			rnd_pool[i + n] += hval[n];
+		}
+	}
+
+	/* Prevent leaks */
+	zeroauto(hval, sizeof(hval));
+	zeroauto(&sha_ctx, sizeof(sha_ctx));
+}
+
+
+
+static void rnd_mix_in(void *data, int size, int credit)
+{
+	sha512_ctx sha_ctx;
+	ext_seed   seed;
+	u8         hval[SHA512_DIGEST_SIZE];
+	int        pos, i;
+
+	wait_object_infinity(&rnd_mutex);
+
+	/* add counter and timestamp to seed data to prevent hash recurrence */
+	seed.seed1 = __rdtsc();
+	seed.seed2 = reseed_cnt; reseed_cnt += credit;
+
+	/* hash input data */
+	sha512_init(&sha_ctx);
+	sha512_hash(&sha_ctx, data, size);
+	sha512_hash(&sha_ctx, pv(&seed), sizeof(seed));
+	sha512_done(&sha_ctx, hval);
+
+	/* add hash value to seed buffer */
+	for (i = 0; i < SHA512_DIGEST_SIZE; i++)
+	{
+		if ( (pos = rnd_pos) >= RNG_POOL_SIZE) {
+			pos = 0; 
+		}
+
+		rnd_pool[pos] += hval[i];
+		rnd_pos        = pos + 1;
+	}
+
+	/* add hash value to key buffer */
+	for (i = 0; i < SHA512_DIGEST_SIZE; i++) {
+		key_pool[i % AES_KEY_SIZE] += hval[i];
+	}
+	
+	/* prevent leaks */
+	zeroauto(&sha_ctx, sizeof(sha_ctx));
+	zeroauto(&hval, sizeof(hval));
+	zeroauto(&seed, sizeof(seed));
+
+	KeReleaseMutex(&rnd_mutex, FALSE);
+}
+
+void rnd_add_buff(void *data, int size)
+{
+	rnd_mix_in(data, size, 1);
+}
+
+/* hash stored I/O samples of all CPU buffers to pool, including partially filled buffers */
+static void rnd_flush_samples()
+{
+	rnd_sample   samples[RND_SAMPLES];
+	rnd_cpu_buf *cbuf;
+	KIRQL        irql;
+	int          i, count;
+
+	if (rnd_cpu_bufs == NULL) {
+		return;
+	}
+	for (i = 0; i < rnd_cpu_num; i++)
+	{
+		cbuf = &rnd_cpu_bufs[i];
+
+		KeAcquireSpinLock(&cbuf->lock, &irql);
+
+		if ( (count = cbuf->count) != 0 ) {
+			memcpy(samples, cbuf->samples, count * sizeof(rnd_sample));
+			zeroauto(cbuf->samples, count * sizeof(rnd_sample));
+			cbuf->count = 0;
+		}
+		KeReleaseSpinLock(&cbuf->lock, irql);
+
+		if (count != 0) {
+			/* each I/O sample counted as one reseed */
+			rnd_mix_in(samples, count * sizeof(rnd_sample), count);
+		}
+	}
+	/* prevent leaks */
+	zeroauto(samples, sizeof(samples));
+}
+
+static void rnd_sample_worker(void *param)
+{
+	lock_xchg(&rnd_wrk_queued, 0);
+	rnd_flush_samples();
+}
+
+void rnd_add_sample(void *irp, u64 offset, int last)
+{
+	rnd_cpu_buf *cbuf;
+	KIRQL        irql;
+	int          pos;
+
+	if (rnd_cpu_bufs == NULL) {
+		return;
+	}
+	cbuf = &rnd_cpu_bufs[KeGetCurrentProcessorNumber() % rnd_cpu_num];
+
+	/* sample is published to worker only after it fully stored */
+	KeAcquireSpinLock(&cbuf->lock, &irql);
+
+	if ( (pos = cbuf->count) < RND_SAMPLES )
+	{
+		cbuf->samples[pos].tsc    = __rdtsc();
+		cbuf->samples[pos].irp    = irp;
+		cbuf->samples[pos].offset = offset;
+		cbuf->count               = pos + 1;
+	}
+	KeReleaseSpinLock(&cbuf->lock, irql);
+
+	/* buffer filled or last sample taken, hash samples to pool at PASSIVE_LEVEL */
+	if ( ((pos == RND_SAMPLES - 1) || (last != 0)) && (lock_xchg(&rnd_wrk_queued, 1) == 0) ) {
+		ExQueueWorkItem(&rnd_wrk_item, DelayedWorkQueue);
+	}
+}
+
+
+
+void rnd_reseed_now()
+{
+	seed_data seed;
+
+	KeQuerySystemTime(&seed.seed20);
+	
+	seed.seed1  = PsGetCurrentProcess();
+	seed.seed2  = PsGetCurrentProcessId();
+	seed.seed3  = KeGetCurrentThread();
+	seed.seed4  = PsGetCurrentThreadId();
+	seed.seed5  = KeGetCurrentProcessorNumber();
+	seed.seed6  = KeQueryInterruptTime();
+	seed.seed10 = KeQueryPerformanceCounter(NULL);
+	seed.seed11 = __rdtsc();
+	seed.seed12 = ExGetPreviousMode();	
+	seed.seed14 = IoGetTopLevelIrp();
+	seed.seed15 = MmQuerySystemSize();
+	seed.seed24 = KeGetCurrentIrql();
+	
+	if (KeGetCurrentIrql() == PASSIVE_LEVEL) {
+		seed.seed7  = KeQueryPriorityThread(seed.seed3);
+		seed.seed17 = ExUuidCreate(&seed.seed18);
+		seed.seed19 = RtlRandom(&seed.seed8);
+	}
+	if (KeGetCurrentIrql() <= APC_LEVEL) {
+		seed.seed13 = IoGetInitialStack();
+		seed.seed16 = PsGetProcessExitTime();
+		IoGetStackLimits(&seed.seed22, &seed.seed23);
+	}	
+	KeQueryTickCount(&seed.seed21);
+	
+	rnd_add_buff(&seed, sizeof(seed));
+
+	/* add I/O samples not hashed yet */
+	rnd_flush_samples();
+	
+	/* Prevent leaks */	
+	zeroauto(&seed, sizeof(seed));
+}
+
+int rnd_get_pool_bytes(u8 *buf, int len)
+{
+	sha512_ctx sha_ctx;
+	u8         hval[SHA512_DIGEST_SIZE];
+	int        c_len, idx, i;
+	ext_seed   seed;
+	int        fail;
+
+	if (reseed_cnt < 256) {
+		DbgMsg("RNG not have sufficient entropy (%d reseeds), collect it now\n", reseed_cnt);
+	}
+	/* in RNG not have sufficient entropy, then collect it now */
+	while (reseed_cnt < 256) 
+	{
+		dc_delay(1); /* wait 1 millisecond */
+		rnd_reseed_now();
+	}
+
+	wait_object_infinity(&rnd_mutex);
+
+	/* derive AES key from key pool */
+	aes256_asm_set_key(key_pool, rnd_key);
+
+	/* mix pool state before get data from it */
+	rnd_pool_mix();
+
+	/* idx - position for extraction pool data */
+	idx = 0; fail = 0;
+	do
+	{
+		c_len      = min(len, SHA512_DIGEST_SIZE);
+		seed.seed1 = getrnd_cnt++;
+		seed.seed2 = len;
+
+		/* collect additional entropy before extract data block */
+		rnd_reseed_now();
+
+		sha512_init(&sha_ctx);
+		sha512_hash(&sha_ctx, rnd_pool + idx, SHA512_DIGEST_SIZE);
+		sha512_hash(&sha_ctx, pv(&seed), sizeof(seed));
+		sha512_done(&sha_ctx, hval);
+
+		/* encrypt hash value with AES in ECB mode */		
+		for (i = 0; i < SHA512_DIGEST_SIZE; i += AES_BLOCK_SIZE) {
+			aes256_asm_encrypt(hval + i, hval + i, rnd_key);
+		}
+
+		/* copy data to output */
+		__try {
+			memcpy(buf, hval, c_len);
+		}
+		__except(EXCEPTION_EXECUTE_HANDLER) {
+			fail = 1;
+		}
+
+		/* increment extraction pointer */
+		if ( (idx += SHA512_DIGEST_SIZE) == RNG_POOL_SIZE ) {
+			/* if all data from pool extracted then 
+			  mix pool for use new entropy added with reseeds */
+			rnd_pool_mix(); idx = 0; 
+		}
+
+		/* collect additional entropy after extract data block */		
+		rnd_reseed_now();
+
+		/* update buffer pointer and remaining length */
+		buf += c_len; len -= c_len;
+	} while ( (len != 0) && (fail == 0) );
+
+	/* mix pool after get data to prevent "could boot" attacks to generated keys */
+	rnd_pool_mix();
+
+	/* Prevent leaks */
+	zeroauto(rnd_key, sizeof(aes256_key));
+	zeroauto(&sha_ctx, sizeof(sha_ctx));
+	zeroauto(hval, sizeof(hval));
+	zeroauto(&seed, sizeof(seed));
+
+	KeReleaseMutex(&rnd_mutex, FALSE);
+
+	return fail == 0;
+}
+
+static int rnd_drbg_get_bytes(u8 *buf, int len)
+{
+	rnd_drbg *drbg = NULL;
+	u8        tmp[XTS_KEY_SIZE*2];
+	int       blen = len & ~(XTS_BLOCK_SIZE - 1);
+	int       i;
+
+	/* take DRBG instance of current CPU, or any other free instance */
+	for (i = 0; i < rnd_drbg_num; i++)
+	{
+		drbg = &rnd_drbgs[(KeGetCurrentProcessorNumber() + i) % rnd_drbg_num];
+
+		if (lock_xchg(&drbg->busy, 1) == 0) {
+			break;
+		}
+		drbg = NULL;
+	}
+	if (drbg == NULL) {
+		return rnd_get_pool_bytes(buf, len);
+	}
+	if (drbg->left < (u64)len)
+	{
+		/* reseed instance from entropy pool */
+		if (rnd_get_pool_bytes(tmp, sizeof(tmp)) == 0) {
+			zeroauto(tmp, sizeof(tmp));
+			lock_xchg(&drbg->busy, 0);
+			return 0;
+		}
+		xts_set_key(tmp, CF_AES, &drbg->key);
+		drbg->left = RND_DRBG_RESEED;
+	}
+	if (blen != 0) {
+		xts_keystream(buf, blen, 0, &drbg->key);
+	}
+	if (blen != len) {
+		xts_keystream(tmp, XTS_BLOCK_SIZE, blen, &drbg->key);
+		memcpy(buf + blen, tmp, len - blen);
+	}
+	/* replace key with next keystream blocks, this prevent recovery of previous output */
+	xts_keystream(tmp, sizeof(tmp), _align(len, XTS_BLOCK_SIZE), &drbg->key);
+	xts_set_key(tmp, CF_AES, &drbg->key);
+	drbg->left -= len;
+
+	/* prevent leaks */
+	zeroauto(tmp, sizeof(tmp));
+
+	lock_xchg(&drbg->busy, 0);
+	return 1;
+}
+
+int rnd_get_bytes(u8 *buf, int len)
+{
+	/* requests larger than reseed interval are served from pool */
+	if ( (len >= RND_BULK_MIN) && (len <= RND_DRBG_RESEED) && (rnd_drbgs != NULL) ) {
+		return rnd_drbg_get_bytes(buf, len);
+	}
+	return rnd_get_pool_bytes(buf, len);
+}
+
+int rnd_init_prng()
+{
+	int i;
+
+	if ( (rnd_key = mm_alloc(sizeof(aes256_key), MEM_SECURE)) == NULL ) {
+		return ST_NOMEM;
+	}
+	KeInitializeMutex(&rnd_mutex, 0);
+	rnd_reseed_now();
+
+	/* I/O samples buffers is optional too */
+	rnd_cpu_num = max(dc_cpu_count, 1);
+
+	if ( (rnd_cpu_bufs = mm_alloc(sizeof(rnd_cpu_buf) * rnd_cpu_num, 0)) != NULL ) 
+	{
+		zeroauto(rnd_cpu_bufs, sizeof(rnd_cpu_buf) * rnd_cpu_num);
+
+		for (i = 0; i < rnd_cpu_num; i++) {
+			KeInitializeSpinLock(&rnd_cpu_bufs[i].lock);
+		}
+	}
+	ExInitializeWorkItem(&rnd_wrk_item, rnd_sample_worker, NULL);
+
+	/* DRBG instances is optional, bulk requests served from pool if allocation fails */
+	rnd_drbg_num = max(dc_cpu_count, 1);
+	rnd_drbgs    = mm_alloc(sizeof(rnd_drbg) * rnd_drbg_num, MEM_SECURE);
+
+	if (rnd_drbgs != NULL) {
+		zeroauto(rnd_drbgs, sizeof(rnd_drbg) * rnd_drbg_num);
+	}
+	return ST_OK;
 }
\ No newline at end of file
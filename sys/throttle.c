@@ -0,0 +1,87 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "defines.h"
+#include "throttle.h"
+
+/* this code is platform independent for testing in user mode */
+
+void throttle_set(io_throttle *thr, u32 target_lat, u32 max_bw)
+{
+	thr->target_lat = target_lat;
+	thr->max_bw     = max_bw;
+}
+
+void throttle_reset(io_throttle *thr, u32 min_chunk, u32 max_chunk)
+{
+	thr->min_chunk = min_chunk;
+	thr->max_chunk = max_chunk;
+	thr->chunk     = max_chunk;
+	thr->delay     = 0;
+	thr->avg_lat   = 0;
+	thr->avg_depth = 0;
+}
+
+void throttle_update(io_throttle *thr, u32 fg_count, u32 fg_lat, u32 fg_depth, u32 elapsed)
+{
+	u32 last = thr->chunk;
+	u64 b_time, b_size;
+
+	if (thr->target_lat == 0) {
+		thr->chunk = thr->max_chunk;
+		thr->delay = 0;
+	} else
+	{
+		/* exponential smoothing of foreground statistic */
+		if (fg_count != 0) {
+			thr->avg_lat = (thr->avg_lat * 3 + fg_lat / fg_count) / 4;
+		} else {
+			thr->avg_lat = thr->avg_lat * 3 / 4;
+		}
+		thr->avg_depth = (thr->avg_depth * 3 + min(fg_depth, 1024) * 16) / 4;
+
+		if (thr->avg_lat > thr->target_lat)
+		{
+			/* foreground I/O suffers, back off quickly */
+			thr->chunk = max(thr->chunk / 2, thr->min_chunk);
+			thr->delay = min(max(thr->delay * 2, THR_MIN_DELAY), THR_MAX_DELAY);
+		} else if ( (thr->avg_lat < thr->target_lat / 2) && (thr->avg_depth < 2 * 16) )
+		{
+			/* volume is near idle, speed up slowly */
+			thr->chunk = min(thr->chunk + thr->min_chunk, thr->max_chunk);
+			thr->delay = thr->delay / 2;
+		}
+	}
+
+	/* limit conversion bandwidth */
+	if (thr->max_bw != 0)
+	{
+		b_time = (u64)last * 1000000 / ((u64)thr->max_bw * 1024);
+
+		if (b_time > elapsed) {
+			thr->delay = max(thr->delay, d32(b_time - elapsed));
+		}
+		/* keep delays short by reducing chunk size */
+		b_size = (u64)thr->max_bw * 1024 * (THR_MAX_DELAY / 1000) / 1000;
+		b_size = max(b_size - b_size % thr->min_chunk, thr->min_chunk);
+		
+		thr->chunk = d32(min(thr->chunk, b_size));
+	}
+}
@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 int test_aes256();
\ No newline at end of file
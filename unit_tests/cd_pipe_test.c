@@ -0,0 +1,196 @@
+#ifdef CRYPTO_PORTABLE
+ #include <unistd.h>
+#else
+ #include <windows.h>
+#endif
+#include "defines.h"
+#include "dcconst.h"
+#include "volume.h"
+#include "cd_pipe_test.h"
+#include "cd_pipe.h"
+
+typedef struct _mem_file {
+	u8  *data;
+	u64  size;
+	u64  fail_at; /* read at this offset fails */
+	int  fd;      /* use regular file instead of memory, -1 if not */
+
+} mem_file;
+
+static int mem_read(void *ctx, void *buff, u32 size, u64 offset, u32 *bytes)
+{
+	mem_file *f = ctx;
+
+	if (offset == f->fail_at) {
+		return ST_IO_ERROR;
+	}
+#ifdef CRYPTO_PORTABLE
+	if (f->fd != -1) {
+		ssize_t n = pread(f->fd, buff, size, offset);
+		if (n < 0) return ST_IO_ERROR;
+		bytes[0] = d32(n); return ST_OK;
+	}
+#endif
+	bytes[0] = offset < f->size ? d32(min(size, f->size - offset)) : 0;
+	memcpy(buff, f->data + offset, bytes[0]);
+	return ST_OK;
+}
+
+static int mem_write(void *ctx, const void *buff, u32 size, u64 offset)
+{
+	mem_file *f = ctx;
+
+#ifdef CRYPTO_PORTABLE
+	if (f->fd != -1) {
+		return pwrite(f->fd, buff, size, offset) == size ? ST_OK : ST_IO_ERROR;
+	}
+#endif
+	if (offset + size > f->size) {
+		return ST_IO_ERROR;
+	}
+	memcpy(f->data + offset, buff, size);
+	return ST_OK;
+}
+
+static int cancel_cb(u64 iso_sz, u64 enc_sz, void *param)
+{
+	return enc_sz >= *(u64*)param ? ST_CANCEL : ST_OK;
+}
+
+/* reference output of single threaded loop used before pipeline */
+static void make_reference(u8 *data, u64 iso_sz, u8 *out, xts_key *key)
+{
+	u64 offset;
+	u32 block, w_len;
+
+	for (offset = 0; offset < iso_sz; offset += w_len)
+	{
+		block = d32(min(iso_sz - offset, CD_PIPE_BUFSZ));
+		w_len = _align(block, CD_SECTOR_SIZE);
+
+		memset(out + offset, 0, w_len);
+		memcpy(out + offset, data + offset, block);
+		xts_encrypt(out + offset, out + offset, w_len, offset, key);
+	}
+}
+
+static int test_pipe_size(u64 iso_sz, xts_key *key, int to_file)
+{
+	static const cd_pipe_conf confs[] = {
+		{ 0, 0, 0 }, { CD_PIPE_ALIGN, 1, 1 }, { 64*1024, 3, 4 }, { 1024*1024, 2, 8 }
+	};
+	u64      out_sz = CD_SECTOR_SIZE + _align(iso_sz, CD_SECTOR_SIZE);
+	u8      *data   = malloc(d32(iso_sz) + 1);
+	u8      *ref    = malloc(d32(out_sz));
+	u8      *out    = malloc(d32(out_sz));
+	mem_file src, dst;
+	int      i, succs = 0;
+#ifdef CRYPTO_PORTABLE
+	FILE    *fs = NULL, *fd = NULL;
+#endif
+
+	for (i = 0; (data != NULL) && (i < iso_sz); i++) {
+		data[i] = d8(i * 13 + (i >> 9));
+	}
+	if ( (data != NULL) && (ref != NULL) && (out != NULL) ) {
+		make_reference(data, iso_sz, ref, key);
+	}
+	for (i = 0; (data != NULL) && (ref != NULL) && (out != NULL) && (i < array_num(confs)); i++)
+	{
+		src.data = data; src.size = iso_sz; src.fail_at = ~0ull; src.fd = -1;
+		dst.data = out;  dst.size = out_sz; dst.fail_at = ~0ull; dst.fd = -1;
+#ifdef CRYPTO_PORTABLE
+		if (to_file != 0) {
+			if ( (fs = tmpfile()) == NULL || (fd = tmpfile()) == NULL ) break;
+			fwrite(data, 1, d32(iso_sz), fs); fflush(fs);
+			src.fd = fileno(fs); dst.fd = fileno(fd);
+		}
+#endif
+		memset(out, 0xAA, d32(out_sz));
+
+		if (cd_pipe_encrypt(mem_read, &src, mem_write, &dst,
+			 CD_SECTOR_SIZE, iso_sz, key, pv(&confs[i]), NULL, NULL) != ST_OK) break;
+#ifdef CRYPTO_PORTABLE
+		if (to_file != 0) {
+			if (pread(dst.fd, out + CD_SECTOR_SIZE, d32(out_sz) - CD_SECTOR_SIZE, CD_SECTOR_SIZE) != out_sz - CD_SECTOR_SIZE) break;
+			fclose(fs); fclose(fd); fs = fd = NULL;
+		}
+#endif
+		if (memcmp(out + CD_SECTOR_SIZE, ref, d32(out_sz) - CD_SECTOR_SIZE) != 0) break;
+		succs++;
+	}
+#ifdef CRYPTO_PORTABLE
+	if (fs != NULL) fclose(fs);
+	if (fd != NULL) fclose(fd);
+#endif
+	free(data); free(ref); free(out);
+
+	return succs == array_num(confs);
+}
+
+static int test_pipe_errors(xts_key *key)
+{
+	cd_pipe_conf conf = { 64*1024, 4, 4 };
+	u64          iso_sz = 4*1024*1024, stop = 1024*1024;
+	u8          *data = malloc(d32(iso_sz));
+	u8          *out  = malloc(d32(iso_sz) + CD_SECTOR_SIZE);
+	mem_file     src, dst;
+	int          resl = 0;
+
+	if ( (data != NULL) && (out != NULL) )
+	{
+		memset(data, 0x55, d32(iso_sz));
+		src.data = data; src.size = iso_sz; src.fail_at = 2*1024*1024; src.fd = -1;
+		dst.data = out;  dst.size = iso_sz + CD_SECTOR_SIZE; dst.fail_at = ~0ull; dst.fd = -1;
+
+		/* read error must be reported and stop all threads */
+		resl = cd_pipe_encrypt(mem_read, &src, mem_write, &dst, CD_SECTOR_SIZE, iso_sz, key, &conf, NULL, NULL) == ST_IO_ERROR;
+
+		/* callback can cancel operation */
+		src.fail_at = ~0ull;
+		resl = resl && cd_pipe_encrypt(mem_read, &src, mem_write, &dst,
+			CD_SECTOR_SIZE, iso_sz, key, &conf, cancel_cb, &stop) == ST_CANCEL;
+
+		/* write error */
+		dst.size = iso_sz / 2;
+		resl = resl && cd_pipe_encrypt(mem_read, &src, mem_write, &dst,
+			CD_SECTOR_SIZE, iso_sz, key, &conf, NULL, NULL) == ST_IO_ERROR;
+	}
+	free(data); free(out);
+
+	return resl;
+}
+
+int test_cd_pipe()
+{
+	static const u64 sizes[] = { 0, 2048, 3*2048 + 100, 1024*1024, 5*1024*1024 + 4096 + 7 };
+	xts_key *key;
+	u8       dk[XTS_FULL_KEY];
+	int      i, resl = 1;
+
+#ifdef CRYPTO_PORTABLE
+	if (posix_memalign(pv(&key), 16, sizeof(xts_key)) != 0) return 0;
+#else
+	if ( (key = VirtualAlloc(NULL, sizeof(xts_key), MEM_COMMIT+MEM_RESERVE, PAGE_EXECUTE_READWRITE)) == NULL ) return 0;
+#endif
+	for (i = 0; i < sizeof(dk); i++) {
+		dk[i] = d8(i);
+	}
+	xts_init(1);
+	xts_set_key(dk, CF_AES_TWOFISH, key);
+
+	for (i = 0; i < array_num(sizes); i++) {
+		resl = resl && test_pipe_size(sizes[i], key, 0);
+#ifdef CRYPTO_PORTABLE
+		resl = resl && test_pipe_size(sizes[i], key, 1);
+#endif
+	}
+	resl = resl && test_pipe_errors(key);
+
+#ifdef CRYPTO_PORTABLE
+	free(key);
+#else
+	VirtualFree(key, 0, MEM_RELEASE);
+#endif
+	return resl;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int test_cd_pipe();
\ No newline at end of file
@@ -0,0 +1,376 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+   Portable cycles/byte benchmark for the crypto library,
+   built on Linux with GCC/Clang by crypto/Makefile
+*/
+
+#include <time.h>
+#include <x86intrin.h>
+#include "defines.h"
+#include "crc32.h"
+#ifdef SMALL_CODE
+ #include "xts_small.h"
+ #include "sha512_small.h"
+ #include "pkcs5_small.h"
+ #define aes256_block_encrypt aes256_encrypt
+ #define aes256_block_decrypt aes256_decrypt
+ #define xts_key_size(_alg)   sizeof(xts_key)
+#else
+ #include "xts_fast.h"
+ #include "aes_asm.h"
+ #include "xts_aes_ni.h"
+ #include "sha512.h"
+ #include "pkcs5.h"
+ #define aes256_block_encrypt aes256_asm_encrypt
+ #define aes256_block_decrypt aes256_asm_decrypt
+#endif
+
+#define BENCH_MAX_SIZE  (16*1024*1024)
+#define BENCH_MIN_TIME  0.2 /* seconds per measurement */
+#define BENCH_PKCS5_ITR 1000
+#define BENCH_MIX_KEYS  64 /* volumes in mixed load */
+
+#define OUT_TABLE 0
+#define OUT_CSV   1
+
+typedef void (*bench_proc)(u8 *buf, size_t size, int alg);
+
+typedef struct _bench_kernel {
+	const char *name;
+	bench_proc  proc;
+	int         alg;
+	int         crypt; /* kernel has encrypt and decrypt modes */
+} bench_kernel;
+
+static aes256_key     aes_k;
+#ifndef AES_ONLY
+static twofish256_key twofish_k;
+static serpent256_key serpent_k;
+#endif
+static xts_key       *xts_k[CF_CIPHERS_NUM]; /* allocated to keep 16 byte alignment */
+static xts_key       *mix_k[BENCH_MIX_KEYS];
+static u32            mix_size;
+static int            decrypt;
+static u32            unit_size = XTS_SECTOR_SIZE;
+
+static void bench_aes(u8 *buf, size_t size, int alg)
+{
+	for (; size != 0; size -= AES_BLOCK_SIZE, buf += AES_BLOCK_SIZE) {
+		if (decrypt == 0) {
+			aes256_block_encrypt(buf, buf, &aes_k);
+		} else {
+			aes256_block_decrypt(buf, buf, &aes_k);
+		}
+	}
+}
+
+#ifndef AES_ONLY
+static void bench_twofish(u8 *buf, size_t size, int alg)
+{
+	for (; size != 0; size -= TWOFISH_BLOCK_SIZE, buf += TWOFISH_BLOCK_SIZE) {
+		if (decrypt == 0) {
+			twofish256_encrypt(buf, buf, &twofish_k);
+		} else {
+			twofish256_decrypt(buf, buf, &twofish_k);
+		}
+	}
+}
+
+static void bench_serpent(u8 *buf, size_t size, int alg)
+{
+	for (; size != 0; size -= SERPENT_BLOCK_SIZE, buf += SERPENT_BLOCK_SIZE) {
+		if (decrypt == 0) {
+			serpent256_encrypt(buf, buf, &serpent_k);
+		} else {
+			serpent256_decrypt(buf, buf, &serpent_k);
+		}
+	}
+}
+#endif
+
+static void bench_xts(u8 *buf, size_t size, int alg)
+{
+	if (decrypt == 0) {
+		xts_encrypt(buf, buf, size, 0x10000, xts_k[alg]);
+	} else {
+		xts_decrypt(buf, buf, size, 0x10000, xts_k[alg]);
+	}
+}
+
+/* requests of many volumes with different ciphers are interleaved, as on server with many mounted volumes */
+static void bench_xts_mixed(u8 *buf, size_t size, int alg)
+{
+	static u32 n;
+	xts_key   *key = mix_k[n++ % BENCH_MIX_KEYS];
+
+	if (decrypt == 0) {
+		xts_encrypt(buf, buf, size, 0x10000, key);
+	} else {
+		xts_decrypt(buf, buf, size, 0x10000, key);
+	}
+}
+
+static void bench_sha512(u8 *buf, size_t size, int alg)
+{
+	sha512_ctx ctx;
+
+	sha512_init(&ctx);
+	sha512_hash(&ctx, buf, size);
+	sha512_done(&ctx, buf);
+}
+
+static void bench_crc32(u8 *buf, size_t size, int alg)
+{
+	p32(buf)[0] ^= crc32(buf, d32(size));
+}
+
+static bench_kernel kernels[] = {
+	{ "aes",                     bench_aes,     0,                      1 },
+#ifndef AES_ONLY
+	{ "twofish",                 bench_twofish, 0,                      1 },
+	{ "serpent",                 bench_serpent, 0,                      1 },
+#endif
+	{ "xts-aes",                 bench_xts,     CF_AES,                 1 },
+#ifndef AES_ONLY
+	{ "xts-twofish",             bench_xts,     CF_TWOFISH,             1 },
+	{ "xts-serpent",             bench_xts,     CF_SERPENT,             1 },
+	{ "xts-aes-twofish",         bench_xts,     CF_AES_TWOFISH,         1 },
+	{ "xts-twofish-serpent",     bench_xts,     CF_TWOFISH_SERPENT,     1 },
+	{ "xts-serpent-aes",         bench_xts,     CF_SERPENT_AES,         1 },
+	{ "xts-aes-twofish-serpent", bench_xts,     CF_AES_TWOFISH_SERPENT, 1 },
+#endif
+	{ "xts-mixed",               bench_xts_mixed, 0,                    1 },
+	{ "sha512",                  bench_sha512,  0,                      0 },
+	{ "crc32",                   bench_crc32,   0,                      0 }
+};
+
+static const size_t def_sizes[] = { 512, 4096, 65536, 1024*1024 };
+
+static double bench_time()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int bench_init_keys(int hw_crypt)
+{
+	u8  key[XTS_FULL_KEY];
+	int i;
+
+	for (i = 0; i < sizeof(key); i++) {
+		key[i] = d8(i * 7 + 1);
+	}
+	xts_init(hw_crypt);
+
+#ifdef SMALL_CODE
+	aes256_set_key(key, &aes_k);
+#else
+	aes256_asm_set_key(key, &aes_k);
+#endif
+#ifndef AES_ONLY
+	twofish256_set_key(key, &twofish_k);
+	serpent256_set_key(key, &serpent_k);
+#endif
+	for (i = 0; i < CF_CIPHERS_NUM; i++) {
+		if (posix_memalign(pv(&xts_k[i]), PAGE_SIZE, xts_key_size(i)) != 0) return 0;
+		xts_set_key(key, i, xts_k[i]);
+		xts_set_unit(xts_k[i], unit_size);
+	}
+	for (i = 0; i < BENCH_MIX_KEYS; i++)
+	{
+#ifdef AES_ONLY
+		int alg = CF_AES;
+#else
+		int alg = i % CF_CIPHERS_NUM;
+#endif
+		if (posix_memalign(pv(&mix_k[i]), 16, xts_key_size(alg)) != 0) return 0;
+		key[0] = d8(i);
+		xts_set_key(key, alg, mix_k[i]);
+		xts_set_unit(mix_k[i], unit_size);
+		mix_size += xts_key_size(alg);
+	}
+	return 1;
+}
+
+/*
+   run kernel on [size] bytes until [min_time] seconds elapsed,
+   the clock is read once per batch to keep the hot loop clean for profilers
+*/
+static void bench_run(bench_kernel *k, u8 *buf, size_t size, double min_time, int out)
+{
+	u64    calls = 0, batch = 1, cycles;
+	double start, time;
+
+	/* warm up caches and branch predictors */
+	k->proc(buf, size, k->alg);
+
+	start  = bench_time();
+	cycles = __rdtsc();
+	do
+	{
+		u64 i;
+
+		for (i = 0; i < batch; i++) {
+			k->proc(buf, size, k->alg);
+		}
+		calls += batch;
+		time   = bench_time() - start;
+
+		if (batch < (1 << 20) && time < min_time / 16) batch *= 2;
+	} while (time < min_time);
+
+	cycles = __rdtsc() - cycles;
+
+	if (out == OUT_CSV) {
+		printf("%s,%s,%u,%.2f,%.3f\n", k->name, k->crypt == 0 ? "-" : decrypt ? "dec" : "enc", d32(size),
+			(double)(calls * size) / time / (1024*1024), (double)cycles / (double)(calls * size));
+	} else {
+		printf("%-24s %-4s %8u %10.2f %10.3f\n", k->name, k->crypt == 0 ? "-" : decrypt ? "dec" : "enc", d32(size),
+			(double)(calls * size) / time / (1024*1024), (double)cycles / (double)(calls * size));
+	}
+	fflush(stdout);
+}
+
+static void bench_pkcs5(double min_time, int out)
+{
+	u8     dk[XTS_FULL_KEY];
+	u64    calls = 0, cycles;
+	double start, time;
+
+	start  = bench_time();
+	cycles = __rdtsc();
+	do
+	{
+		sha512_pkcs5_2(BENCH_PKCS5_ITR, "password", 8, "salt", 4, dk, sizeof(dk));
+		calls++; time = bench_time() - start;
+	} while (time < min_time);
+
+	cycles = __rdtsc() - cycles;
+
+	if (out == OUT_CSV) {
+		printf("pkcs5-sha512,derive,%u,%.2f,%.0f\n", BENCH_PKCS5_ITR,
+			(double)calls / time, (double)cycles / (double)(calls * BENCH_PKCS5_ITR));
+	} else {
+		printf("\npkcs5-sha512: %.2f derivations/s (%u iterations), %.0f cycles/iteration\n",
+			(double)calls / time, BENCH_PKCS5_ITR, (double)cycles / (double)(calls * BENCH_PKCS5_ITR));
+	}
+}
+
+static void bench_usage()
+{
+	printf(
+		"usage: crypto_bench [options]\n"
+		"  -k <name>   run only kernels whose name starts with <name> (aes, xts, xts-serpent...)\n"
+		"  -s <bytes>  run only one request size (multiple of 512)\n"
+		"  -t <sec>    time per measurement, use large values for perf/VTune sessions\n"
+		"  -dec        benchmark decryption instead of encryption\n"
+		"  -u <bytes>  XTS data unit size, 512 or 4096\n"
+		"  -nohw       disable AES-NI and Padlock\n"
+		"  -csv        print results as CSV\n"
+		"  -list       list kernel names\n"
+		"cycles are TSC reference cycles, use 'perf stat -e cycles' for core cycles\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *filter   = NULL;
+	size_t      size     = 0;
+	double      min_time = BENCH_MIN_TIME;
+	int         hw_crypt = 1, out = OUT_TABLE;
+	u8         *buf;
+	int         i, j;
+
+	for (i = 1; i < argc; i++)
+	{
+		if ( (strcmp(argv[i], "-k") == 0) && (i + 1 < argc) ) {
+			filter = argv[++i];
+		} else if ( (strcmp(argv[i], "-s") == 0) && (i + 1 < argc) ) {
+			size = strtoul(argv[++i], NULL, 0);
+		} else if ( (strcmp(argv[i], "-t") == 0) && (i + 1 < argc) ) {
+			min_time = atof(argv[++i]);
+		} else if ( (strcmp(argv[i], "-u") == 0) && (i + 1 < argc) ) {
+			unit_size = strtoul(argv[++i], NULL, 0);
+		} else if (strcmp(argv[i], "-dec") == 0) {
+			decrypt = 1;
+		} else if (strcmp(argv[i], "-nohw") == 0) {
+			hw_crypt = 0;
+		} else if (strcmp(argv[i], "-csv") == 0) {
+			out = OUT_CSV;
+		} else if (strcmp(argv[i], "-list") == 0) {
+			for (j = 0; j < array_num(kernels); j++) printf("%s\n", kernels[j].name);
+			printf("pkcs5\n");
+			return 0;
+		} else {
+			bench_usage(); return 1;
+		}
+	}
+	if ( (size != 0) && ((size % XTS_SECTOR_SIZE) != 0 || size > BENCH_MAX_SIZE) ) {
+		printf("request size must be a multiple of %d and not above %d\n", XTS_SECTOR_SIZE, BENCH_MAX_SIZE);
+		return 1;
+	}
+	if ( (unit_size != XTS_SECTOR_SIZE) && (unit_size != XTS_MAX_UNIT_SIZE) ) {
+		printf("data unit size must be %d or %d\n", XTS_SECTOR_SIZE, XTS_MAX_UNIT_SIZE);
+		return 1;
+	}
+	if ( (min_time <= 0) || (posix_memalign(pv(&buf), PAGE_SIZE, BENCH_MAX_SIZE) != 0) ) {
+		bench_usage(); return 1;
+	}
+	for (i = 0; i < BENCH_MAX_SIZE; i++) {
+		buf[i] = d8(i);
+	}
+	if (bench_init_keys(hw_crypt) == 0) {
+		printf("not enough memory\n"); return 1;
+	}
+
+#ifdef SMALL_CODE
+	printf(out == OUT_CSV ? "# small crypto, data unit: %u\n" : "small crypto library, data unit: %u\n", unit_size);
+#else
+	printf(out == OUT_CSV ? "# fast crypto, AES-NI: %d, data unit: %u\n" : "fast crypto library, AES-NI: %d, data unit: %u\n",
+		hw_crypt != 0 && xts_aes_ni_available() != 0, unit_size);
+#endif
+	printf(out == OUT_CSV ? "# mixed load: %d keys, %u KB\n" : "mixed load: %d keys, %u KB of keys\n", BENCH_MIX_KEYS, mix_size / 1024);
+
+	if (out == OUT_CSV) {
+		printf("kernel,op,size,mb_s,cycles_per_byte\n");
+	} else {
+		printf("%-24s %-4s %8s %10s %10s\n", "kernel", "op", "size", "MB/s", "cycles/B");
+	}
+	for (i = 0; i < array_num(kernels); i++)
+	{
+		if ( (filter != NULL) && (strncmp(kernels[i].name, filter, strlen(filter)) != 0) ) {
+			continue;
+		}
+		if (size != 0) {
+			bench_run(&kernels[i], buf, size, min_time, out);
+			continue;
+		}
+		for (j = 0; j < array_num(def_sizes); j++) {
+			bench_run(&kernels[i], buf, def_sizes[j], min_time, out);
+		}
+	}
+	if ( (filter == NULL) || (strncmp("pkcs5", filter, strlen(filter)) == 0) ) {
+		bench_pkcs5(min_time, out);
+	}
+	free(buf); return 0;
+}
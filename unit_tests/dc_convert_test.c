@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "defines.h"
+#include "dcconst.h"
+#include "volume.h"
+#include "dc_image.h"
+#include "dc_convert.h"
+#include "dc_convert_test.h"
+
+#define TEST_DSK_SIZE (2 * 1024 * 1024 + 7 * SECTOR_SIZE)
+
+static const u8 test_pass[] = { 't',0, 'e',0, 's',0, 't',0 };
+
+/* cancel conversion when [param] bytes processed */
+static int cancel_callback(u64 total, u64 done, void *param)
+{
+	return done >= *(u64*)param ? ST_CANCEL : ST_OK;
+}
+
+/* compare volume with plaintext, redirection area inside volume is skipped */
+static int check_volume(const char *path, const u8 *plain, u64 stor_off, u32 n_threads, u32 flags)
+{
+	dc_image *img;
+	u8       *buff = malloc(TEST_DSK_SIZE);
+	int       succs = 0;
+
+	if (dc_img_open(&img, path, 0, n_threads) != ST_OK) {
+		free(buff); return 0;
+	}
+	do
+	{
+		if (dc_img_mount(img, test_pass, sizeof(test_pass)) != ST_OK) break;
+		if ( (img->flags & (VF_TMP_MODE | VF_REENCRYPT)) != flags ) break;
+		if (dc_img_read(img, buff, d32(img->use_size), 0) != ST_OK) break;
+
+		if (img->use_size > stor_off) {
+			memcpy(buff + stor_off, plain + stor_off, DC_AREA_SIZE);
+		}
+		succs = memcmp(buff, plain, d32(img->use_size)) == 0;
+	} while (0);
+
+	dc_img_close(img); free(buff);
+	return succs;
+}
+
+/* run conversion, interrupt it after [limit] bytes and continue in new session */
+static int convert_step(const char *path, int op, int cipher, u64 limit, u32 n_threads, dc_conv_conf *conf)
+{
+	dc_image *img;
+	int       resl;
+
+	if (dc_img_open(&img, path, IMG_WRITE, n_threads) != ST_OK) {
+		return ST_ERROR;
+	}
+	resl = dc_img_convert(img, op, test_pass, sizeof(test_pass), cipher, conf, limit != 0 ? cancel_callback : NULL, &limit);
+	dc_img_close(img);
+
+	return resl;
+}
+
+static int test_convert(u64 stor_off, u32 n_threads)
+{
+	char         path[] = "/tmp/dc_conv_XXXXXX";
+	u8          *plain  = malloc(TEST_DSK_SIZE);
+	u8          *disk   = malloc(TEST_DSK_SIZE);
+	dc_conv_conf conf   = { 64 * 1024, 3, 256 * 1024 };
+	dc_image    *img;
+	u64          use_size;
+	u32          i;
+	int          succs = 0;
+	FILE        *f;
+
+	close(mkstemp(path));
+
+	for (i = 0; i < TEST_DSK_SIZE; i++) {
+		plain[i] = d8(i ^ (i >> 8) ^ (i >> 16));
+	}
+	do
+	{
+		if ( (f = fopen(path, "wb")) == NULL ) break;
+		fwrite(plain, 1, TEST_DSK_SIZE, f); fclose(f);
+
+		/* create volume header */
+		if (dc_img_open(&img, path, IMG_WRITE, n_threads) != ST_OK) break;
+		if (dc_img_encrypt_init(img, test_pass, 2, CF_SERPENT, 0, DC_AREA_SIZE - SECTOR_SIZE) != ST_INV_DATA_SIZE) break;
+		if (dc_img_encrypt_init(img, test_pass, sizeof(test_pass), CF_SERPENT, 0, stor_off) != ST_OK) break;
+		use_size = img->use_size;
+		stor_off = img->stor_off;
+		dc_img_close(img);
+
+		if (check_volume(path, plain, stor_off, n_threads, VF_TMP_MODE) == 0) break;
+
+		/* encrypt */
+		if (convert_step(path, CONV_ENCRYPT, 0, 700 * 1024, n_threads, &conf) != ST_CANCEL) break;
+		if (check_volume(path, plain, stor_off, n_threads, VF_TMP_MODE) == 0) break;
+		if (convert_step(path, CONV_ENCRYPT, 0, 0, n_threads, &conf) != ST_OK) break;
+		if (check_volume(path, plain, stor_off, n_threads, VF_NONE) == 0) break;
+		if (convert_step(path, CONV_ENCRYPT, 0, 0, n_threads, &conf) != ST_ENCRYPTED) break;
+
+		/* re-encrypt with other cipher and 4 KB data unit */
+		conf.unit_size = DC_MAX_UNIT_SIZE;
+
+		if (convert_step(path, CONV_REENCRYPT, CF_AES_TWOFISH, 1024 * 1024, n_threads, &conf) != ST_CANCEL) break;
+		if (check_volume(path, plain, stor_off, n_threads, VF_TMP_MODE | VF_REENCRYPT) == 0) break;
+		if (convert_step(path, CONV_DECRYPT, 0, 0, n_threads, &conf) != ST_ERROR) break;
+		if (convert_step(path, CONV_REENCRYPT, CF_AES, 0, n_threads, &conf) != ST_OK) break;
+		if (check_volume(path, plain, stor_off, n_threads, VF_NONE) == 0) break;
+
+		if (dc_img_open(&img, path, 0, n_threads) != ST_OK) break;
+		i = (dc_img_mount(img, test_pass, sizeof(test_pass)) == ST_OK) && (img->unit_1 == DC_MAX_UNIT_SIZE);
+		dc_img_close(img);
+		if (i == 0) break;
+
+		/* decrypt */
+		if (convert_step(path, CONV_DECRYPT, 0, 512 * 1024, n_threads, &conf) != ST_CANCEL) break;
+		if (check_volume(path, plain, stor_off, n_threads, VF_TMP_MODE) == 0) break;
+		if (convert_step(path, CONV_DECRYPT, 0, 0, n_threads, &conf) != ST_OK) break;
+
+		/* image must contain plaintext, except redirection area */
+		if ( (f = fopen(path, "rb")) == NULL ) break;
+		fread(disk, 1, TEST_DSK_SIZE, f); fclose(f);
+
+		memcpy(disk + stor_off, plain + stor_off, DC_AREA_SIZE);
+		succs = memcmp(disk, plain, TEST_DSK_SIZE) == 0 && (use_size == stor_off || use_size == TEST_DSK_SIZE);
+	} while (0);
+
+	unlink(path);
+	free(plain); free(disk);
+
+	return succs;
+}
+
+int test_dc_convert()
+{
+	int resl = 1;
+
+	xts_init(1);
+
+	/* redirection area at end of image and inside of image */
+	resl = resl && test_convert(0, 1);
+	resl = resl && test_convert(0, 4);
+	resl = resl && test_convert(1024 * 1024 + 3 * SECTOR_SIZE, 1);
+	resl = resl && test_convert(1024 * 1024 + 3 * SECTOR_SIZE, 4);
+
+	return resl;
+}
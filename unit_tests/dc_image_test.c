@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "defines.h"
+#include "dcconst.h"
+#include "volume.h"
+#include "pkcs5.h"
+#include "crc32.h"
+#include "dc_image.h"
+#include "dc_image_test.h"
+
+#define TEST_DSK_SIZE (3 * 1024 * 1024 + 5 * SECTOR_SIZE)
+
+static const u8 test_pass[] = { 't',0, 'e',0, 's',0, 't',0 };
+
+typedef struct _test_vol {
+	u32 flags;
+	u64 stor_off;
+	u64 tmp_size;
+	int alg_1;
+	int alg_2;
+	u16 unit_1; /* 0 - SECTOR_SIZE */
+	u16 unit_2;
+
+} test_vol;
+
+static xts_key *test_key(const u8 *dk, int alg, u32 unit_size)
+{
+	xts_key *key = NULL;
+
+	if (posix_memalign(pv(&key), 16, xts_key_size(alg)) == 0) {
+		xts_set_key(dk, alg, key);
+		xts_set_unit(key, unit_size);
+	}
+	return key;
+}
+
+/* build volume image from plaintext the same way as driver stores it */
+static int make_volume(const char *path, const u8 *plain, u64 use_size, const test_vol *v)
+{
+	dc_header head;
+	u8        dk[DISKKEY_SIZE];
+	u8       *disk = calloc(1, TEST_DSK_SIZE);
+	xts_key  *k_1, *k_2, *h_key;
+	u64       i;
+	FILE     *f;
+	int       succs = 0;
+
+	memset(&head, 0, sizeof(head));
+	for (i = 0; i < sizeof(head.key_1); i++) {
+		head.salt[i % PKCS5_SALT_SIZE] = d8(i * 3); head.key_1[i] = d8(i * 7); head.key_2[i] = d8(i * 11);
+	}
+	head.flags    = v->flags;
+	head.disk_id  = 0x12345678;
+	head.alg_1    = v->alg_1;
+	head.alg_2    = v->alg_2;
+	head.stor_off = v->stor_off;
+	head.use_size = use_size;
+	head.tmp_size = v->tmp_size;
+	head.unit_size   = v->unit_1;
+	head.unit_size_2 = v->unit_2;
+	DC_SET_HDR_SIGN(&head);
+	head.hdr_crc  = crc32(pv(&head.version), DC_CRC_AREA_SIZE);
+
+	sha512_pkcs5_2(1000, pv(test_pass), sizeof(test_pass), pv(head.salt), PKCS5_SALT_SIZE, pv(dk), PKCS_DERIVE_MAX);
+
+	k_1   = test_key(head.key_1, v->alg_1, DC_UNIT_SIZE(&head, unit_size));
+	k_2   = test_key(head.key_2, v->alg_2, DC_UNIT_SIZE(&head, unit_size_2));
+	h_key = test_key(dk, CF_SERPENT_AES, SECTOR_SIZE);
+
+	if ( (disk == NULL) || (k_1 == NULL) || (k_2 == NULL) || (h_key == NULL) ) {
+		free(disk); free(k_1); free(k_2); free(h_key);
+		return 0;
+	}
+	if (v->flags & VF_NO_REDIR)
+	{
+		memcpy(disk + v->stor_off, plain, d32(use_size));
+		xts_encrypt(disk + v->stor_off, disk + v->stor_off, d32(use_size), 0, k_1);
+	} else
+	{
+		memcpy(disk, plain, d32(use_size));
+		memcpy(disk + v->stor_off, plain, DC_AREA_SIZE);
+
+		for (i = DC_AREA_SIZE; i < TEST_DSK_SIZE; i += SECTOR_SIZE)
+		{
+			if ( !(v->flags & VF_TMP_MODE) || (i < v->tmp_size) ) {
+				xts_encrypt(disk + i, disk + i, SECTOR_SIZE, i, k_1);
+			} else if (v->flags & VF_REENCRYPT) {
+				xts_encrypt(disk + i, disk + i, SECTOR_SIZE, i, k_2);
+			}
+		}
+	}
+	xts_encrypt(pv(&head), disk, sizeof(head), 0, h_key);
+	memcpy(disk, head.salt, PKCS5_SALT_SIZE);
+
+	if ( (f = fopen(path, "wb")) != NULL ) {
+		succs = fwrite(disk, 1, TEST_DSK_SIZE, f) == TEST_DSK_SIZE;
+		fclose(f);
+	}
+	free(disk); free(k_1); free(k_2); free(h_key);
+	return succs;
+}
+
+static int file_equal(const char *path, const u8 *data, u64 size)
+{
+	u8   *buff = malloc(d32(size) + 1);
+	FILE *f    = fopen(path, "rb");
+	int   succs;
+
+	succs = (buff != NULL) && (f != NULL) &&
+		(fread(buff, 1, d32(size) + 1, f) == size) && (memcmp(buff, data, d32(size)) == 0);
+
+	if (f != NULL) fclose(f);
+	free(buff);
+	return succs;
+}
+
+static int test_volume(const test_vol *v, u32 n_threads)
+{
+	char      path[] = "/tmp/dc_img_XXXXXX", ref[] = "/tmp/dc_ref_XXXXXX", exp[] = "/tmp/dc_exp_XXXXXX";
+	u64       use_size = (v->flags & VF_NO_REDIR) ? TEST_DSK_SIZE - v->stor_off : v->stor_off;
+	u8       *plain = malloc(d32(use_size));
+	u8       *buff  = malloc(d32(use_size));
+	u8       *disk  = malloc(TEST_DSK_SIZE);
+	dc_image *img   = NULL;
+	u32       i, w_off = 1024, w_size = 512 * 1024;
+	int       succs = 0;
+	FILE     *f;
+
+	close(mkstemp(path)); close(mkstemp(ref)); close(mkstemp(exp)); unlink(exp);
+
+	for (i = 0; i < use_size; i++) {
+		plain[i] = d8(i ^ (i >> 8) ^ (i >> 16));
+	}
+	do
+	{
+		if (make_volume(path, plain, use_size, v) == 0) break;
+		if (dc_img_open(&img, path, IMG_WRITE, n_threads) != ST_OK) break;
+		if (dc_img_mount(img, test_pass, 2) != ST_PASS_ERR) break;
+		if (dc_img_mount(img, test_pass, sizeof(test_pass)) != ST_OK) break;
+		if (img->use_size != use_size) break;
+
+		/* whole volume and unaligned requests */
+		if (dc_img_read(img, buff, d32(use_size), 0) != ST_OK) break;
+		if (memcmp(buff, plain, d32(use_size)) != 0) break;
+		if (dc_img_read(img, buff, 100, 0) != ST_INV_DATA_SIZE) break;
+		if (dc_img_read(img, buff, SECTOR_SIZE, use_size) != ST_INV_DATA_SIZE) break;
+
+		/* export */
+		if (dc_img_export(img, exp, NULL, NULL) != ST_OK) break;
+		if (file_equal(exp, plain, use_size) == 0) break;
+
+		/* write over redirected area or encrypted part border, result must match freshly built volume */
+		if (v->flags & VF_TMP_MODE) {
+			w_off = d32(v->tmp_size - w_size / 2);
+		}
+		for (i = 0; i < w_size; i++) {
+			buff[i] = d8(~i); plain[w_off + i] = d8(~i);
+		}
+		if (dc_img_write(img, buff, w_size, w_off) != ST_OK) break;
+		dc_img_close(img); img = NULL;
+
+		if (make_volume(ref, plain, use_size, v) == 0) break;
+		if ( (f = fopen(ref, "rb")) == NULL ) break;
+		fread(disk, 1, TEST_DSK_SIZE, f); fclose(f);
+		/* header area is not changed by writes */
+		succs = file_equal(path, disk, TEST_DSK_SIZE);
+	} while (0);
+
+	if (img != NULL) dc_img_close(img);
+	unlink(path); unlink(ref); unlink(exp);
+	free(plain); free(buff); free(disk);
+
+	return succs;
+}
+
+int test_dc_image()
+{
+	static const test_vol vols[] = {
+		/* redirected, storage at end of volume */
+		{ VF_NONE, TEST_DSK_SIZE - DC_AREA_SIZE, 0, CF_AES, 0 },
+		/* data after header as in encrypted ISO */
+		{ VF_NO_REDIR, DC_AREA_SIZE, 0, CF_AES_TWOFISH, 0 },
+		/* partially encrypted */
+		{ VF_TMP_MODE, TEST_DSK_SIZE - DC_AREA_SIZE, 1024 * 1024 + 4096, CF_SERPENT, 0 },
+		/* re-encryption in progress */
+		{ VF_TMP_MODE | VF_REENCRYPT, TEST_DSK_SIZE - DC_AREA_SIZE, 2 * 1024 * 1024, CF_TWOFISH, CF_AES_TWOFISH_SERPENT },
+		/* 4 KB data unit */
+		{ VF_NONE, TEST_DSK_SIZE - DC_AREA_SIZE, 0, CF_AES, 0, DC_MAX_UNIT_SIZE },
+		/* re-encryption to 4 KB data unit, border inside unit */
+		{ VF_TMP_MODE | VF_REENCRYPT, TEST_DSK_SIZE - DC_AREA_SIZE, 1024 * 1024 + 1536, CF_AES, CF_SERPENT, DC_MAX_UNIT_SIZE, 0 },
+	};
+	int i, resl = 1;
+
+	xts_init(1);
+
+	for (i = 0; i < array_num(vols); i++) {
+		resl = resl && test_volume(&vols[i], 1);
+		resl = resl && test_volume(&vols[i], 4);
+	}
+	return resl;
+}
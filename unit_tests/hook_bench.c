@@ -0,0 +1,166 @@
+/*
+    *
+    * DiskCryptor - open source partition encryption tool
+    * Copyright (c) 2010
+    * ntldr <ntldr@diskcryptor.net> PGP key ID - 0xC48251EB4F8E4E6E
+    *
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3 as
+    published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+   Multi-threaded model of dev_hook access on the request path,
+   built on Linux with GCC/Clang by crypto/Makefile.
+   Every thread acts as CPU dispatching requests to one volume:
+   acquire remove lock, read device fields while request is processed,
+   release remove lock. Old layout keeps remove lock in the same cache
+   line as pointers read by every request, split layout matches dev_hook.
+*/
+
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "defines.h"
+
+#define BENCH_ITERATIONS 2000000
+#define BENCH_READS      8  /* field reads per request */
+#define BENCH_EXT_ALIGN  16 /* device extension alignment */
+
+/* IO_REMOVE_LOCK_COMMON_BLOCK */
+typedef struct _remv_lock {
+	u8  removed;
+	u8  reserved[3];
+	int io_count;
+	u8  remove_event[24];
+} remv_lock;
+
+/* dev_hook field order before hot/cold split */
+typedef struct _hook_old {
+	u32        ext_type;
+	void      *orig_dev;
+	void      *hook_dev;
+	void      *pdo_dev;
+	void      *hooks_list[2];
+	remv_lock  remv_lock;
+	wchar_t    dev_name[128];
+	u32        flags;
+	u64        use_size;
+} hook_old;
+
+/* dev_hook field order after split */
+typedef struct _hook_split {
+	u32        ext_type;
+	u32        flags;
+	void      *orig_dev;
+	void      *hook_dev;
+	void      *pdo_dev;
+	u64        use_size;
+	u8         pad_0[CACHE_LINE];
+	remv_lock  remv_lock;
+	u8         pad_1[CACHE_LINE];
+	void      *hooks_list[2];
+	wchar_t    dev_name[128];
+} hook_split;
+
+typedef struct _bench_ctx {
+	pthread_t  thread;
+	int        layout;
+	void      *hook;
+	u64        result;
+} bench_ctx;
+
+#define DEF_BENCH_PROC(_name, _type) \
+	static void *_name(void *param) \
+	{ \
+		bench_ctx *ctx = param; \
+		volatile _type *hook = ctx->hook; \
+		u64 acc = 0; \
+		int i, j; \
+		for (i = 0; i < BENCH_ITERATIONS; i++) \
+		{ \
+			lock_inc(&hook->remv_lock.io_count); \
+			for (j = 0; j < BENCH_READS; j++) { \
+				acc += hook->ext_type + (size_t)hook->orig_dev + hook->flags + hook->use_size; \
+				acc  = acc * 33 ^ j; \
+			} \
+			lock_dec(&hook->remv_lock.io_count); \
+		} \
+		ctx->result = acc; \
+		return NULL; \
+	}
+
+DEF_BENCH_PROC(bench_old, hook_old);
+DEF_BENCH_PROC(bench_split, hook_split);
+
+static double bench_time()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* returns millions of requests per second */
+static double bench_run(int layout, int threads)
+{
+	bench_ctx ctx[64];
+	u8       *mem;
+	double    time;
+	int       i;
+
+	/* place hook at worst case extension alignment */
+	if (posix_memalign(pv(&mem), CACHE_LINE, sizeof(hook_old) + sizeof(hook_split) + CACHE_LINE) != 0) {
+		return 0;
+	}
+	memset(mem, 0, sizeof(hook_old) + sizeof(hook_split) + CACHE_LINE);
+
+	time = bench_time();
+
+	for (i = 0; i < threads; i++) {
+		ctx[i].layout = layout;
+		ctx[i].hook   = mem + BENCH_EXT_ALIGN;
+		pthread_create(&ctx[i].thread, NULL, layout == 0 ? bench_old : bench_split, &ctx[i]);
+	}
+	for (i = 0; i < threads; i++) {
+		pthread_join(ctx[i].thread, NULL);
+	}
+	time = bench_time() - time;
+
+	free(mem);
+	return (double)threads * BENCH_ITERATIONS / time / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+	int    cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int    max_thr = argc > 1 ? atoi(argv[1]) : max(cpus, 2);
+	double r_old, r_split;
+	int    n;
+
+	if ( (max_thr < 1) || (max_thr > 64) ) {
+		printf("usage: hook_bench [threads], 1-64 threads\n");
+		return 1;
+	}
+	printf("dev_hook request path, %d CPUs, %d reads per request\n", cpus, BENCH_READS);
+	printf("%8s %12s %12s %8s\n", "threads", "old Mreq/s", "split Mreq/s", "speedup");
+
+	for (n = 1; n <= max_thr; n = n < max_thr && n * 2 > max_thr ? max_thr : n * 2)
+	{
+		r_old   = bench_run(0, n);
+		r_split = bench_run(1, n);
+
+		printf("%8d %12.2f %12.2f %8.2f\n", n, r_old, r_split, r_split / r_old);
+		fflush(stdout);
+	}
+	return 0;
+}
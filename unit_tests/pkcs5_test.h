@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 int test_pkcs5();
\ No newline at end of file
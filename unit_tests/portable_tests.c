@@ -0,0 +1,22 @@
+#include "defines.h"
+#include "xts_test.h"
+#include "cd_pipe_test.h"
+#include "dc_image_test.h"
+#include "dc_convert_test.h"
+
+/* tests of platform independent code, built by crypto/Makefile */
+
+int main(int argc, char *argv[])
+{
+	int xts_mode = test_xts_mode();
+	int cd_pipe  = test_cd_pipe();
+	int dc_image = test_dc_image();
+	int convert  = test_dc_convert();
+
+	printf("XTS mode: %d\n", xts_mode);
+	printf("CD pipeline: %d\n", cd_pipe);
+	printf("Volume image: %d\n", dc_image);
+	printf("Volume conversion: %d\n", convert);
+
+	return (xts_mode != 0) && (cd_pipe != 0) && (dc_image != 0) && (convert != 0) ? 0 : 1;
+}
@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 int test_sha512();
\ No newline at end of file
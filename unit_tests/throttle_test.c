@@ -0,0 +1,80 @@
+#include <windows.h>
+#include "defines.h"
+#include "throttle.h"
+
+#define DISK_SPEED  100 /* simulated disk speed, bytes per microsecond */
+#define BASE_LAT    200 /* foreground latency of idle disk */
+
+/* foreground request waits for current chunk completion */
+static u32 sim_chunk_time(u32 chunk) {
+	return chunk / DISK_SPEED;
+}
+
+static int test_busy_volume()
+{
+	io_throttle thr;
+	u32         lat, time;
+	int         i;
+
+	zeroauto(&thr, sizeof(thr));
+	throttle_set(&thr, 5000, 0);
+	throttle_reset(&thr, 64*1024, 1280*1024);
+
+	for (i = 0; i < 200; i++) {
+		time = sim_chunk_time(thr.chunk);
+		lat  = BASE_LAT + time;
+		throttle_update(&thr, 8, lat * 8, 4, time);
+	}
+	/* chunk must be reduced to meet target latency */
+	if ( (thr.chunk >= thr.max_chunk) || (BASE_LAT + sim_chunk_time(thr.chunk) > 5000 * 2) ) {
+		return 0;
+	}
+	/* foreground load gone, conversion must return to full speed */
+	for (i = 0; i < 200; i++) {
+		throttle_update(&thr, 0, 0, 0, sim_chunk_time(thr.chunk));
+	}
+	if ( (thr.chunk != thr.max_chunk) || (thr.delay != 0) ) {
+		return 0;
+	}
+	return 1;
+}
+
+static int test_bandwidth_limit()
+{
+	io_throttle thr;
+	u64         bytes, time;
+	u32         elapsed;
+	int         i;
+
+	zeroauto(&thr, sizeof(thr));
+	throttle_set(&thr, 0, 1024);
+	throttle_reset(&thr, 64*1024, 1280*1024);
+
+	for (i = 0, bytes = 0, time = 0; i < 100; i++) {
+		elapsed = sim_chunk_time(thr.chunk);
+		bytes  += thr.chunk;
+		throttle_update(&thr, 0, 0, 0, elapsed);
+		time   += elapsed + thr.delay;
+	}
+	/* average speed must not exceed 1024 KB/s */
+	if (bytes * 1000000 / time > 1024 * 1024) {
+		return 0;
+	}
+	return 1;
+}
+
+static int test_disabled()
+{
+	io_throttle thr;
+
+	zeroauto(&thr, sizeof(thr));
+	throttle_reset(&thr, 64*1024, 1280*1024);
+	throttle_update(&thr, 100, 100 * 1000000, 32, 1000);
+
+	return (thr.chunk == thr.max_chunk) && (thr.delay == 0);
+}
+
+int test_throttle()
+{
+	return test_busy_volume() && test_bandwidth_limit() && test_disabled();
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int test_throttle();
\ No newline at end of file
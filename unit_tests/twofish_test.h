@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 int test_twofish256();
\ No newline at end of file
@@ -1,3 +1,3 @@
-#pragma once
-
+#pragma once
+
 int test_xts_mode();
\ No newline at end of file